@@ -30,6 +30,7 @@ enum class CompileFormat
     CodegenIr,      // Prints annotated native code IR
     CodegenVerbose, // Prints annotated native code including IR, assembly and outlined code
     CodegenNull,
+    CodegenAot, // Writes native code for the host that can be installed with Luau::CodeGen::loadAot
     Null
 };
 
@@ -50,6 +51,8 @@ struct GlobalOptions
     const char* vectorLib = nullptr;
     const char* vectorCtor = nullptr;
     const char* vectorType = nullptr;
+
+    unsigned int codegenFlags = 0;
 } globalOptions;
 
 static Luau::CompileOptions copts()
@@ -86,6 +89,8 @@ static std::optional<CompileFormat> getCompileFormat(const char* name)
         return CompileFormat::CodegenVerbose;
     else if (strcmp(name, "codegennull") == 0)
         return CompileFormat::CodegenNull;
+    else if (strcmp(name, "aot") == 0)
+        return CompileFormat::CodegenAot;
     else if (strcmp(name, "null") == 0)
         return CompileFormat::Null;
     else
@@ -120,6 +125,35 @@ static std::string getCodegenAssembly(
     return "";
 }
 
+static std::string getCodegenAot(const char* name, const std::string& bytecode)
+{
+    if (!Luau::CodeGen::isSupported())
+    {
+        fprintf(stderr, "Error generating native code for %s: native code generation is not supported on this platform\n", name);
+        return "";
+    }
+
+    std::unique_ptr<lua_State, void (*)(lua_State*)> globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    if (luau_load(L, name, bytecode.data(), bytecode.size(), 0) != 0)
+    {
+        fprintf(stderr, "Error loading bytecode %s\n", name);
+        return "";
+    }
+
+    Luau::CodeGen::CompilationOptions options;
+    options.flags = globalOptions.codegenFlags;
+
+    std::string blob;
+    Luau::CodeGen::CompilationResult result = Luau::CodeGen::compileAot(L, -1, options, blob);
+
+    if (result.result != Luau::CodeGen::CodeGenCompilationResult::Success)
+        fprintf(stderr, "Error generating native code for %s: %s\n", name, Luau::CodeGen::toString(result.result).c_str());
+
+    return blob;
+}
+
 static void annotateInstruction(void* context, std::string& text, int fid, int instpos)
 {
     Luau::BytecodeBuilder& bcb = *(Luau::BytecodeBuilder*)context;
@@ -312,6 +346,7 @@ static bool compileFile(const char* name, CompileFormat format, Luau::CodeGen::A
         Luau::CodeGen::AssemblyOptions options;
         options.target = assemblyTarget;
         options.outputBinary = format == CompileFormat::CodegenNull;
+        options.compilationOptions.flags = globalOptions.codegenFlags;
 
         if (!options.outputBinary)
         {
@@ -381,6 +416,14 @@ static bool compileFile(const char* name, CompileFormat format, Luau::CodeGen::A
             stats.codegen += getCodegenAssembly(name, bcb.getBytecode(), options, &stats.lowerStats).size();
             stats.codegenTime += recordDeltaTime(currts);
             break;
+        case CompileFormat::CodegenAot:
+        {
+            std::string blob = getCodegenAot(name, bcb.getBytecode());
+            fwrite(blob.data(), 1, blob.size(), stdout);
+            stats.codegen += blob.size();
+            stats.codegenTime += recordDeltaTime(currts);
+            break;
+        }
         case CompileFormat::Null:
             break;
         }
@@ -405,7 +448,7 @@ static void displayHelp(const char* argv0)
     printf("Usage: %s [--mode] [options] [file list]\n", argv0);
     printf("\n");
     printf("Available modes:\n");
-    printf("   binary, text, remarks, codegen\n");
+    printf("   binary, text, remarks, codegen, aot\n");
     printf("\n");
     printf("Available options:\n");
     printf("  -h, --help: Display this usage message.\n");
@@ -419,6 +462,7 @@ static void displayHelp(const char* argv0)
     printf("  --vector-lib=<name>: name of the library providing vector type operations.\n");
     printf("  --vector-ctor=<name>: name of the function constructing a vector value.\n");
     printf("  --vector-type=<name>: name of the vector type.\n");
+    printf("  --codegen-weighted-spills: choose register spills by spill cost in X64 native code.\n");
 }
 
 static int assertionHandler(const char* expr, const char* file, int line, const char* function)
@@ -568,6 +612,10 @@ int main(int argc, char** argv)
         {
             globalOptions.vectorType = argv[i] + 14;
         }
+        else if (strcmp(argv[i], "--codegen-weighted-spills") == 0)
+        {
+            globalOptions.codegenFlags |= Luau::CodeGen::CodeGen_WeightedSpills;
+        }
         else if (argv[i][0] == '-' && argv[i][1] == '-' && getCompileFormat(argv[i] + 2))
         {
             compileFormat = *getCompileFormat(argv[i] + 2);
@@ -597,7 +645,7 @@ int main(int argc, char** argv)
     const std::vector<std::string> files = getSourceFiles(argc, argv);
 
 #ifdef _WIN32
-    if (compileFormat == CompileFormat::Binary)
+    if (compileFormat == CompileFormat::Binary || compileFormat == CompileFormat::CodegenAot)
         _setmode(_fileno(stdout), _O_BINARY);
 #endif
 
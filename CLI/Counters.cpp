@@ -0,0 +1,128 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "Counters.h"
+
+#include "lua.h"
+
+#include "Luau/BytecodeUtils.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+struct FunctionCounters
+{
+    std::string name;
+    uint64_t calls;
+    uint64_t loops;
+};
+
+struct Counters
+{
+    lua_State* L = nullptr;
+    std::vector<int> functions;
+} gCounters;
+
+void countersInit(lua_State* L)
+{
+    gCounters.L = lua_mainthread(L);
+
+    lua_resetopcounters(gCounters.L);
+}
+
+bool countersActive()
+{
+    return gCounters.L != nullptr;
+}
+
+void countersTrack(lua_State* L, int funcindex)
+{
+    int ref = lua_ref(L, funcindex);
+    gCounters.functions.push_back(ref);
+}
+
+struct CountersContext
+{
+    const char* source;
+    std::vector<FunctionCounters>* result;
+};
+
+static void countersCallback(void* context, const char* function, int linedefined, int depth, uint64_t calls, uint64_t loops)
+{
+    CountersContext* ctx = static_cast<CountersContext*>(context);
+
+    if (calls == 0 && loops == 0)
+        return;
+
+    std::string name = ctx->source;
+
+    if (depth == 0)
+        name += ":<main>";
+    else if (function)
+        name += ":" + std::string(function) + ":" + std::to_string(linedefined);
+    else
+        name += ":<anonymous>:" + std::to_string(linedefined);
+
+    ctx->result->push_back({name, calls, loops});
+}
+
+void countersDump(const char* path)
+{
+    lua_State* L = gCounters.L;
+
+    FILE* f = fopen(path, "w");
+    if (!f)
+    {
+        fprintf(stderr, "Error opening counters %s\n", path);
+        return;
+    }
+
+    std::vector<uint64_t> ops(LOP__COUNT);
+    lua_getopcounters(L, ops.data(), int(ops.size()));
+
+    std::vector<int> order;
+    for (int i = 0; i < int(ops.size()); ++i)
+        if (ops[i] != 0)
+            order.push_back(i);
+
+    std::sort(order.begin(), order.end(), [&](int l, int r) {
+        return ops[l] > ops[r];
+    });
+
+    uint64_t total = 0;
+    for (uint64_t count : ops)
+        total += count;
+
+    fprintf(f, "opcodes (%llu total):\n", (unsigned long long)total);
+
+    for (int op : order)
+        fprintf(f, "%20llu %6.2f%% %s\n", (unsigned long long)ops[op], double(ops[op]) * 100.0 / double(total), Luau::getOpName(LuauOpcode(op)));
+
+    std::vector<FunctionCounters> functions;
+
+    for (int fref : gCounters.functions)
+    {
+        lua_getref(L, fref);
+
+        lua_Debug ar = {};
+        lua_getinfo(L, -1, "s", &ar);
+
+        CountersContext context = {ar.short_src, &functions};
+        lua_getcounters(L, -1, &context, countersCallback);
+
+        lua_pop(L, 1);
+    }
+
+    // functions are ordered by the amount of interpreter work, approximated by the sum of calls and loop iterations
+    std::sort(functions.begin(), functions.end(), [](const FunctionCounters& l, const FunctionCounters& r) {
+        return l.calls + l.loops > r.calls + r.loops;
+    });
+
+    fprintf(f, "\nfunctions (calls, loop iterations):\n");
+
+    for (const FunctionCounters& fc : functions)
+        fprintf(f, "%20llu %20llu %s\n", (unsigned long long)fc.calls, (unsigned long long)fc.loops, fc.name.c_str());
+
+    fclose(f);
+
+    printf("Counters written to %s (%d opcodes, %d functions)\n", path, int(order.size()), int(functions.size()));
+}
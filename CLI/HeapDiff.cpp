@@ -0,0 +1,118 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "lua.h"
+
+#include "Luau/Common.h"
+#include "FileUtils.h"
+#include "HeapSnapshot.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void displayHelp(const char* argv0)
+{
+    printf("Usage: %s [options] before.snapshot after.snapshot\n", argv0);
+    printf("\n");
+    printf("Compares two heap snapshots written by lua_heapsnapshot and reports objects that retain the growth.\n");
+    printf("\n");
+    printf("Available options:\n");
+    printf("  -h, --help: Display this usage message.\n");
+    printf("  --top=<n>: number of retainers to report (default 20).\n");
+
+    exit(0);
+}
+
+static bool loadSnapshot(const char* name, HeapSnapshot& snapshot)
+{
+    std::optional<std::string> data = readFile(name);
+
+    if (!data)
+    {
+        fprintf(stderr, "Error opening %s\n", name);
+        return false;
+    }
+
+    std::string error;
+
+    if (!parseHeapSnapshot(data->data(), data->size(), snapshot, error))
+    {
+        fprintf(stderr, "Error reading %s: %s\n", name, error.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+static int assertionHandler(const char* expr, const char* file, int line, const char* function)
+{
+    printf("%s(%d): ASSERTION FAILED: %s\n", file, line, expr);
+    return 1;
+}
+
+int main(int argc, char** argv)
+{
+    Luau::assertHandler() = assertionHandler;
+
+    const char* files[2] = {};
+    int fileCount = 0;
+    int top = 20;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0)
+        {
+            displayHelp(argv[0]);
+        }
+        else if (strncmp(argv[i], "--top=", 6) == 0)
+        {
+            top = atoi(argv[i] + 6);
+        }
+        else if (argv[i][0] == '-' || fileCount == 2)
+        {
+            fprintf(stderr, "Error: Unrecognized option '%s'.\n\n", argv[i]);
+            displayHelp(argv[0]);
+        }
+        else
+        {
+            files[fileCount++] = argv[i];
+        }
+    }
+
+    if (fileCount != 2)
+        displayHelp(argv[0]);
+
+    HeapSnapshot before;
+    HeapSnapshot after;
+
+    if (!loadSnapshot(files[0], before) || !loadSnapshot(files[1], after))
+        return 1;
+
+    HeapDiff diff = diffHeapSnapshots(before, after);
+
+    printf("Heap: %llu -> %llu bytes (%+lld)\n", (unsigned long long)before.totalBytes, (unsigned long long)after.totalBytes,
+        (long long)(after.totalBytes - before.totalBytes));
+    printf("Added: %llu objects, %llu bytes\n", (unsigned long long)diff.addedCount, (unsigned long long)diff.addedBytes);
+    printf("Removed: %llu objects, %llu bytes\n", (unsigned long long)diff.removedCount, (unsigned long long)diff.removedBytes);
+
+    printf("\nGrowth by type:\n");
+
+    for (int i = 0; i <= LUA_TDEADKEY; ++i)
+        if (diff.typeCount[i] != 0 || diff.typeBytes[i] != 0)
+            printf(
+                "  %-12s %+10lld bytes %+8lld objects\n", getHeapObjectTypeName(uint8_t(i)), (long long)diff.typeBytes[i], (long long)diff.typeCount[i]
+            );
+
+    printf("\nTop retainers of new objects:\n");
+
+    for (size_t i = 0; i < diff.retainers.size() && int(i) < top; ++i)
+    {
+        const HeapDiff::Group& group = diff.retainers[i];
+
+        std::string name = group.object == ~0u ? "<unreachable from old objects; collect garbage before taking a snapshot>"
+                                               : describeHeapObject(after, group.object);
+
+        printf("  %10llu bytes %8llu objects  %s\n", (unsigned long long)group.bytes, (unsigned long long)group.count, name.c_str());
+    }
+
+    return 0;
+}
@@ -0,0 +1,363 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "HeapSnapshot.h"
+
+#include "lua.h"
+
+#include <algorithm>
+
+#include <stdio.h>
+#include <string.h>
+
+// record types, must match lgcdebug.cpp
+enum HeapSnapshotRecord
+{
+    HSR_END,
+    HSR_OBJECT,
+    HSR_NAME,
+    HSR_PATH,
+    HSR_ROOT,
+};
+
+const int kHeapSnapshotVersion = 1;
+
+struct SnapshotReader
+{
+    const uint8_t* pos;
+    const uint8_t* end;
+    bool error = false;
+
+    uint64_t readInt()
+    {
+        uint64_t result = 0;
+        int shift = 0;
+
+        while (pos < end && shift < 64)
+        {
+            uint8_t byte = *pos++;
+            result |= uint64_t(byte & 127) << shift;
+
+            if ((byte & 128) == 0)
+                return result;
+
+            shift += 7;
+        }
+
+        error = true;
+        return 0;
+    }
+
+    std::string readString()
+    {
+        uint64_t len = readInt();
+
+        if (error || len > uint64_t(end - pos))
+        {
+            error = true;
+            return {};
+        }
+
+        std::string result(reinterpret_cast<const char*>(pos), size_t(len));
+        pos += len;
+        return result;
+    }
+};
+
+const HeapSnapshot::Object* HeapSnapshot::find(uint64_t id) const
+{
+    const uint32_t* i = index.find(id);
+
+    return i ? &objects[*i] : nullptr;
+}
+
+bool parseHeapSnapshot(const char* data, size_t size, HeapSnapshot& result, std::string& error)
+{
+    if (size < 4 || memcmp(data, "LHS\0", 4) != 0)
+    {
+        error = "not a heap snapshot";
+        return false;
+    }
+
+    SnapshotReader reader = {reinterpret_cast<const uint8_t*>(data) + 4, reinterpret_cast<const uint8_t*>(data) + size};
+
+    if (reader.readInt() != kHeapSnapshotVersion)
+    {
+        error = "unsupported heap snapshot version";
+        return false;
+    }
+
+    // names refer to objects by id, which might not have been read yet for paths
+    std::vector<std::pair<uint64_t, std::string>> names;
+    std::vector<std::pair<uint64_t, std::string>> paths;
+
+    for (;;)
+    {
+        uint64_t record = reader.readInt();
+
+        if (reader.error)
+            break;
+
+        if (record == HSR_END)
+        {
+            result.totalBytes = reader.readInt();
+            break;
+        }
+
+        switch (record)
+        {
+        case HSR_OBJECT:
+        {
+            HeapSnapshot::Object object;
+            object.id = reader.readInt();
+            object.type = uint8_t(reader.readInt());
+            object.memcat = uint8_t(reader.readInt());
+            object.size = reader.readInt();
+            object.firstRef = uint32_t(result.refs.size());
+
+            while (uint64_t ref = reader.readInt())
+                result.refs.push_back(ref);
+
+            object.refCount = uint32_t(result.refs.size() - object.firstRef);
+
+            result.index[object.id] = uint32_t(result.objects.size());
+            result.objects.push_back(object);
+            break;
+        }
+        case HSR_NAME:
+        {
+            uint64_t id = reader.readInt();
+            names.push_back({id, reader.readString()});
+            break;
+        }
+        case HSR_PATH:
+        {
+            uint64_t id = reader.readInt();
+            paths.push_back({id, reader.readString()});
+            break;
+        }
+        case HSR_ROOT:
+        {
+            uint64_t id = reader.readInt();
+            result.roots.push_back({reader.readString(), id});
+            break;
+        }
+        default:
+            reader.error = true;
+        }
+
+        if (reader.error)
+            break;
+    }
+
+    if (reader.error)
+    {
+        error = "heap snapshot is truncated or corrupted";
+        return false;
+    }
+
+    for (auto& [id, name] : names)
+    {
+        if (uint32_t* i = result.index.find(id))
+        {
+            result.objects[*i].name = int32_t(result.names.size());
+            result.names.push_back(std::move(name));
+        }
+    }
+
+    for (auto& [id, path] : paths)
+    {
+        if (uint32_t* i = result.index.find(id); i && result.objects[*i].path < 0)
+        {
+            result.objects[*i].path = int32_t(result.names.size());
+            result.names.push_back(std::move(path));
+        }
+    }
+
+    return true;
+}
+
+static bool isSameObject(const HeapSnapshot::Object& lhs, const HeapSnapshot::Object* rhs)
+{
+    // addresses can be reused after an object is freed; objects of a different type are definitely different
+    return rhs && rhs->type == lhs.type;
+}
+
+HeapDiff diffHeapSnapshots(const HeapSnapshot& before, const HeapSnapshot& after)
+{
+    HeapDiff result;
+
+    for (const HeapSnapshot::Object& object : before.objects)
+    {
+        if (!isSameObject(object, after.find(object.id)))
+        {
+            result.removedBytes += object.size;
+            result.removedCount++;
+
+            result.typeBytes[object.type & 15] -= int64_t(object.size);
+            result.typeCount[object.type & 15]--;
+        }
+    }
+
+    const uint32_t kNone = ~0u;
+
+    std::vector<uint32_t> owner(after.objects.size(), kNone);
+    std::vector<bool> added(after.objects.size(), false);
+
+    for (size_t i = 0; i < after.objects.size(); ++i)
+    {
+        const HeapSnapshot::Object& object = after.objects[i];
+
+        if (!isSameObject(object, before.find(object.id)))
+        {
+            added[i] = true;
+
+            result.addedBytes += object.size;
+            result.addedCount++;
+
+            result.typeBytes[object.type & 15] += int64_t(object.size);
+            result.typeCount[object.type & 15]++;
+        }
+    }
+
+    // breadth-first search from all old objects at once assigns each new object to the closest old object that retains it
+    std::vector<uint32_t> queue;
+
+    for (size_t i = 0; i < after.objects.size(); ++i)
+    {
+        if (added[i])
+            continue;
+
+        const HeapSnapshot::Object& object = after.objects[i];
+
+        for (uint32_t r = 0; r < object.refCount; ++r)
+        {
+            const uint32_t* target = after.index.find(after.refs[object.firstRef + r]);
+
+            if (target && added[*target] && owner[*target] == kNone)
+            {
+                owner[*target] = uint32_t(i);
+                queue.push_back(*target);
+            }
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); ++head)
+    {
+        const HeapSnapshot::Object& object = after.objects[queue[head]];
+
+        for (uint32_t r = 0; r < object.refCount; ++r)
+        {
+            const uint32_t* target = after.index.find(after.refs[object.firstRef + r]);
+
+            if (target && added[*target] && owner[*target] == kNone)
+            {
+                owner[*target] = owner[queue[head]];
+                queue.push_back(*target);
+            }
+        }
+    }
+
+    Luau::DenseHashMap<uint32_t, size_t> groups{kNone - 1};
+
+    for (size_t i = 0; i < after.objects.size(); ++i)
+    {
+        if (!added[i])
+            continue;
+
+        auto [group, inserted] = groups.try_insert(owner[i], result.retainers.size());
+
+        if (inserted)
+        {
+            result.retainers.push_back({});
+            result.retainers.back().object = owner[i];
+        }
+
+        result.retainers[group].bytes += after.objects[i].size;
+        result.retainers[group].count++;
+    }
+
+    std::sort(
+        result.retainers.begin(),
+        result.retainers.end(),
+        [](const HeapDiff::Group& lhs, const HeapDiff::Group& rhs)
+        {
+            return lhs.bytes != rhs.bytes ? lhs.bytes > rhs.bytes : lhs.object < rhs.object;
+        }
+    );
+
+    return result;
+}
+
+static const char* const kTypeNames[] = {
+    "nil",
+    "boolean",
+    "lightuserdata",
+    "number",
+    "vector",
+    "string",
+    "table",
+    "function",
+    "userdata",
+    "thread",
+    "buffer",
+    "proto",
+    "upvalue",
+    "deadkey",
+};
+
+static_assert(sizeof(kTypeNames) / sizeof(kTypeNames[0]) == LUA_TDEADKEY + 1, "type name table must match type tags");
+
+const char* getHeapObjectTypeName(uint8_t type)
+{
+    return type <= LUA_TDEADKEY ? kTypeNames[type] : "unknown";
+}
+
+std::string describeHeapObject(const HeapSnapshot& snapshot, uint32_t index)
+{
+    const HeapSnapshot::Object& object = snapshot.objects[index];
+
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%s 0x%llx", getHeapObjectTypeName(object.type), (unsigned long long)object.id);
+
+    std::string result = buf;
+
+    if (object.path >= 0)
+    {
+        result += " ";
+        result += snapshot.names[object.path];
+    }
+
+    if (object.name >= 0)
+    {
+        result += " [";
+        result += snapshot.names[object.name];
+        result += "]";
+    }
+    else if (object.type == LUA_TFUNCTION)
+    {
+        // Luau functions are named after their prototype
+        for (uint32_t r = 0; r < object.refCount; ++r)
+        {
+            const HeapSnapshot::Object* target = snapshot.find(snapshot.refs[object.firstRef + r]);
+
+            if (target && target->type == LUA_TPROTO && target->name >= 0)
+            {
+                result += " [";
+                result += snapshot.names[target->name];
+                result += "]";
+                break;
+            }
+        }
+    }
+
+    for (const auto& [name, id] : snapshot.roots)
+    {
+        if (id == object.id)
+        {
+            result += " (";
+            result += name;
+            result += ")";
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,65 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#pragma once
+
+#include "Luau/DenseHash.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// In-memory representation of a heap snapshot produced by lua_heapsnapshot
+struct HeapSnapshot
+{
+    struct Object
+    {
+        uint64_t id = 0;
+        uint64_t size = 0;
+        uint32_t firstRef = 0;
+        uint32_t refCount = 0;
+        uint8_t type = 0;
+        uint8_t memcat = 0;
+        int32_t name = -1; // index in names
+        int32_t path = -1; // index in names
+    };
+
+    std::vector<Object> objects;
+    std::vector<uint64_t> refs;
+    std::vector<std::string> names;
+    std::vector<std::pair<std::string, uint64_t>> roots;
+
+    Luau::DenseHashMap<uint64_t, uint32_t> index{0};
+
+    uint64_t totalBytes = 0;
+
+    const Object* find(uint64_t id) const;
+};
+
+bool parseHeapSnapshot(const char* data, size_t size, HeapSnapshot& result, std::string& error);
+
+struct HeapDiff
+{
+    struct Group
+    {
+        uint32_t object = ~0u; // index of the retaining object in the newer snapshot, ~0u for objects that aren't retained by old objects
+        uint64_t bytes = 0;
+        uint64_t count = 0;
+    };
+
+    uint64_t addedBytes = 0;
+    uint64_t addedCount = 0;
+    uint64_t removedBytes = 0;
+    uint64_t removedCount = 0;
+
+    // growth of each object type, indexed by type tag
+    int64_t typeBytes[16] = {};
+    int64_t typeCount[16] = {};
+
+    // objects that existed in both snapshots and retain new objects, sorted by the size of retained objects
+    std::vector<Group> retainers;
+};
+
+// new objects are attributed to the closest object that was already present in the older snapshot and references them
+HeapDiff diffHeapSnapshots(const HeapSnapshot& before, const HeapSnapshot& after);
+
+const char* getHeapObjectTypeName(uint8_t type);
+std::string describeHeapObject(const HeapSnapshot& snapshot, uint32_t index);
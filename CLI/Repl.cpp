@@ -10,6 +10,7 @@
 #include "Luau/Parser.h"
 #include "Luau/TimeTrace.h"
 
+#include "Counters.h"
 #include "Coverage.h"
 #include "FileUtils.h"
 #include "Flags.h"
@@ -45,6 +46,8 @@ LUAU_FASTFLAG(DebugLuauTimeTracing)
 constexpr int MaxTraversalLimit = 50;
 
 static bool codegen = false;
+static unsigned int codegenTiering = 0;
+static unsigned int codegenFlags = 0;
 static int program_argc = 0;
 char** program_argv = nullptr;
 
@@ -143,9 +146,10 @@ static int lua_require(lua_State* L)
     std::string bytecode = Luau::compile(resolvedRequire.sourceCode, copts());
     if (luau_load(ML, resolvedRequire.chunkName.c_str(), bytecode.data(), bytecode.size(), 0) == 0)
     {
-        if (codegen)
+        if (codegen && !codegenTiering)
         {
             Luau::CodeGen::CompilationOptions nativeOptions;
+            nativeOptions.flags = codegenFlags;
             Luau::CodeGen::compile(ML, -1, nativeOptions);
         }
 
@@ -197,7 +201,19 @@ static int lua_collectgarbage(lua_State* L)
         return 1;
     }
 
-    luaL_error(L, "collectgarbage must be called with 'count' or 'collect'");
+    if (strcmp(option, "generational") == 0)
+    {
+        lua_gc(L, LUA_GCGEN, 0);
+        return 0;
+    }
+
+    if (strcmp(option, "incremental") == 0)
+    {
+        lua_gc(L, LUA_GCINC, 0);
+        return 0;
+    }
+
+    luaL_error(L, "collectgarbage must be called with 'count', 'collect', 'generational' or 'incremental'");
 }
 
 #ifdef CALLGRIND
@@ -235,6 +251,14 @@ void setupState(lua_State* L)
     if (codegen)
         Luau::CodeGen::create(L);
 
+    if (codegen && codegenTiering)
+    {
+        Luau::CodeGen::TieringOptions tieringOptions;
+        tieringOptions.threshold = codegenTiering;
+        tieringOptions.compilationOptions.flags = codegenFlags;
+        Luau::CodeGen::setTiering(L, tieringOptions);
+    }
+
     luaL_openlibs(L);
 
     static const luaL_Reg funcs[] = {
@@ -604,15 +628,19 @@ static bool runFile(const char* name, lua_State* GL, bool repl)
 
     if (luau_load(L, chunkname.c_str(), bytecode.data(), bytecode.size(), 0) == 0)
     {
-        if (codegen)
+        if (codegen && !codegenTiering)
         {
             Luau::CodeGen::CompilationOptions nativeOptions;
+            nativeOptions.flags = codegenFlags;
             Luau::CodeGen::compile(L, -1, nativeOptions);
         }
 
         if (coverageActive())
             coverageTrack(L, -1);
 
+        if (countersActive())
+            countersTrack(L, -1);
+
         setupArguments(L, program_argc, program_argv);
         status = lua_resume(L, NULL, program_argc);
     }
@@ -661,8 +689,11 @@ static void displayHelp(const char* argv0)
     printf("  -O<n>: compile with optimization level n (default 1, n should be between 0 and 2).\n");
     printf("  -g<n>: compile with debug level n (default 1, n should be between 0 and 2).\n");
     printf("  --profile[=N]: profile the code using N Hz sampling (default 10000) and output results to profile.out\n");
+    printf("  --profile-counters: collect function and opcode execution counters and output results to counters.out (requires a build with LUAI_EXECCOUNTERS)\n");
     printf("  --timetrace: record compiler time tracing information into trace.json\n");
     printf("  --codegen: execute code using native code generation\n");
+    printf("  --codegen-tiering[=N]: compile functions to native code after N calls and loop iterations (default 1000)\n");
+    printf("  --codegen-weighted-spills: choose register spills by spill cost in X64 native code\n");
     printf("  --program-args,-a: declare start of arguments to be passed to the Luau program\n");
 }
 
@@ -684,6 +715,7 @@ int replMain(int argc, char** argv)
 
     int profile = 0;
     bool coverage = false;
+    bool counters = false;
     bool interactive = false;
     bool codegenPerf = false;
     int program_args = argc;
@@ -727,10 +759,29 @@ int replMain(int argc, char** argv)
         {
             profile = atoi(argv[i] + 10);
         }
+        else if (strcmp(argv[i], "--profile-counters") == 0)
+        {
+            counters = true;
+        }
         else if (strcmp(argv[i], "--codegen") == 0)
         {
             codegen = true;
         }
+        else if (strcmp(argv[i], "--codegen-tiering") == 0)
+        {
+            codegen = true;
+            codegenTiering = Luau::CodeGen::TieringOptions().threshold;
+        }
+        else if (strncmp(argv[i], "--codegen-tiering=", 18) == 0)
+        {
+            codegen = true;
+            codegenTiering = unsigned(atoi(argv[i] + 18));
+        }
+        else if (strcmp(argv[i], "--codegen-weighted-spills") == 0)
+        {
+            codegen = true;
+            codegenFlags |= Luau::CodeGen::CodeGen_WeightedSpills;
+        }
         else if (strcmp(argv[i], "--codegen-perf") == 0)
         {
             codegen = true;
@@ -773,6 +824,14 @@ int replMain(int argc, char** argv)
     }
 #endif
 
+#if !LUAI_EXECCOUNTERS
+    if (counters)
+    {
+        fprintf(stderr, "To run with --profile-counters, Luau has to be built with LUAI_EXECCOUNTERS enabled (LUAU_EXECCOUNTERS=ON in CMake or counters=1 in make)\n");
+        return 1;
+    }
+#endif
+
     if (codegenPerf)
     {
 #if __linux__
@@ -814,6 +873,9 @@ int replMain(int argc, char** argv)
         if (coverage)
             coverageInit(L);
 
+        if (counters)
+            countersInit(L);
+
         int failed = 0;
 
         for (size_t i = 0; i < files.size(); ++i)
@@ -831,6 +893,9 @@ int replMain(int argc, char** argv)
         if (coverage)
             coverageDump("coverage.out");
 
+        if (counters)
+            countersDump("counters.out");
+
         return failed ? 1 : 0;
     }
 }
@@ -139,10 +139,27 @@ public:
     void fsqrt(RegisterA64 dst, RegisterA64 src);
     void fsub(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2);
 
+    // Floating-point vector math on two double lanes
+    void fabs_2d(RegisterA64 dst, RegisterA64 src);
+    void fadd_2d(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2);
+    void fdiv_2d(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2);
+    void fmul_2d(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2);
+    void fneg_2d(RegisterA64 dst, RegisterA64 src);
+    void fsqrt_2d(RegisterA64 dst, RegisterA64 src);
+    void fsub_2d(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2);
+
+    // Sets all bits of each double lane where src1 > src2
+    void fcmgt_2d(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2);
+
+    // Bitwise select: takes src1 bits where dst bits are set and src2 bits otherwise
+    void bsl_16b(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2);
+
     // Vector component manipulation
     void ins_4s(RegisterA64 dst, RegisterA64 src, uint8_t index);
     void ins_4s(RegisterA64 dst, uint8_t dstIndex, RegisterA64 src, uint8_t srcIndex);
     void dup_4s(RegisterA64 dst, RegisterA64 src, uint8_t index);
+    void ins_2d(RegisterA64 dst, uint8_t dstIndex, RegisterA64 src, uint8_t srcIndex);
+    void dup_2d(RegisterA64 dst, RegisterA64 src, uint8_t index);
 
     // Floating-point rounding and conversions
     void frinta(RegisterA64 dst, RegisterA64 src);
@@ -154,6 +171,12 @@ public:
     void scvtf(RegisterA64 dst, RegisterA64 src);
     void ucvtf(RegisterA64 dst, RegisterA64 src);
 
+    // Vector conversions between two lanes of 32-bit values in the lower half and two 64-bit lanes
+    void fcvtl_2d(RegisterA64 dst, RegisterA64 src);
+    void fcvtn_2s(RegisterA64 dst, RegisterA64 src);
+    void sxtl_2d(RegisterA64 dst, RegisterA64 src);
+    void scvtf_2d(RegisterA64 dst, RegisterA64 src);
+
     // Floating-point conversion to integer using JS rules (wrap around 2^32) and set Z flag
     // note: this is part of ARM8.3 (JSCVT feature); support of this instruction needs to be checked at runtime
     void fjcvtzs(RegisterA64 dst, RegisterA64 src);
@@ -231,6 +254,8 @@ private:
     void placeBFM(const char* name, RegisterA64 dst, RegisterA64 src1, int src2, uint8_t op, int immr, int imms);
     void placeER(const char* name, RegisterA64 dst, RegisterA64 src1, RegisterA64 src2, uint8_t op, int shift);
     void placeVR(const char* name, RegisterA64 dst, RegisterA64 src1, RegisterA64 src2, uint16_t op, uint8_t op2);
+    void placeV3(const char* name, const char* arrangement, RegisterA64 dst, RegisterA64 src1, RegisterA64 src2, uint32_t op);
+    void placeV1(const char* name, const char* dstArrangement, const char* srcArrangement, RegisterA64 dst, RegisterA64 src, uint32_t op);
 
     void place(uint32_t word);
 
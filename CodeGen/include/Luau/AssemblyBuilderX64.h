@@ -118,10 +118,13 @@ public:
     void vaddsd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
     void vaddss(OperandX64 dst, OperandX64 src1, OperandX64 src2);
 
+    void vsubpd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
     void vsubsd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
     void vsubps(OperandX64 dst, OperandX64 src1, OperandX64 src2);
+    void vmulpd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
     void vmulsd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
     void vmulps(OperandX64 dst, OperandX64 src1, OperandX64 src2);
+    void vdivpd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
     void vdivsd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
     void vdivps(OperandX64 dst, OperandX64 src1, OperandX64 src2);
 
@@ -139,6 +142,9 @@ public:
     void vcvtsi2sd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
     void vcvtsd2ss(OperandX64 dst, OperandX64 src1, OperandX64 src2);
     void vcvtss2sd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
+    void vcvtps2pd(OperandX64 dst, OperandX64 src);
+    void vcvtpd2ps(OperandX64 dst, OperandX64 src);
+    void vcvtdq2pd(OperandX64 dst, OperandX64 src);
 
     void vroundsd(OperandX64 dst, OperandX64 src1, OperandX64 src2, RoundingModeX64 roundingMode); // inexact
 
@@ -156,8 +162,16 @@ public:
     void vmovupd(OperandX64 dst, OperandX64 src);
     void vmovups(OperandX64 dst, OperandX64 src);
     void vmovq(OperandX64 lhs, OperandX64 rhs);
+    void vmovhpd(OperandX64 dst, OperandX64 src);
+    void vmovhpd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
+    void vmovddup(OperandX64 dst, OperandX64 src);
 
+    void vunpcklpd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
+    void vunpckhpd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
+
+    void vmaxpd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
     void vmaxsd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
+    void vminpd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
     void vminsd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
 
     void vcmpltsd(OperandX64 dst, OperandX64 src1, OperandX64 src2);
@@ -166,6 +180,8 @@ public:
 
     void vpshufps(RegisterX64 dst, RegisterX64 src1, OperandX64 src2, uint8_t shuffle);
     void vpinsrd(RegisterX64 dst, RegisterX64 src1, OperandX64 src2, uint8_t offset);
+    void vinsertps(RegisterX64 dst, RegisterX64 src1, OperandX64 src2, uint8_t offset);
+    void vextractps(OperandX64 dst, RegisterX64 src, uint8_t offset);
 
     // Run final checks
     bool finalize();
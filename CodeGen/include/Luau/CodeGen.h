@@ -29,6 +29,8 @@ enum CodeGenFlags
     CodeGen_OnlyNativeModules = 1 << 0,
     // Run native codegen for functions that the compiler considers not profitable
     CodeGen_ColdFunctions = 1 << 1,
+    // Pick X64 register spills by spill cost and reuse stack copies of values that were spilled before
+    CodeGen_WeightedSpills = 1 << 2,
 };
 
 // These enum values can be reported through telemetry.
@@ -46,8 +48,9 @@ enum class CodeGenCompilationResult
     CodeGenAssemblerFinalizationFailure = 7,  // Failure during assembler finalization
     CodeGenLoweringFailure = 8,               // Lowering failed
     AllocationFailed = 9,                     // Native codegen failed due to an allocation error
+    AotBlobMismatch = 10,                     // Native code blob was produced for different bytecode, options, CPU or Luau version
 
-    Count = 10,
+    Count = 11,
 };
 
 std::string toString(const CodeGenCompilationResult& result);
@@ -105,6 +108,18 @@ struct CompilationOptions
     HostIrHooks hooks;
 };
 
+struct TieringOptions
+{
+    // Number of calls and loop iterations a function runs in the interpreter before it's compiled; 0 disables tiering
+    unsigned int threshold = 1000;
+
+    // Functions loaded after tiering is enabled record operand types seen by the interpreter, which native code is specialized for
+    // Only has an effect when the VM is built with LUAI_TYPEFEEDBACK
+    bool typeFeedback = true;
+
+    CompilationOptions compilationOptions;
+};
+
 struct CompilationStats
 {
     size_t bytecodeSizeBytes = 0;
@@ -154,6 +169,10 @@ void create(lua_State* L, SharedCodeGenContext* codeGenContext);
 // Enable or disable native execution according to `enabled` argument
 void setNativeExecutionEnabled(lua_State* L, bool enabled);
 
+// Enable automatic compilation of functions that run often in the interpreter; only affects functions loaded after the call
+// Hot functions are compiled individually and switch to native code on their next call
+void setTiering(lua_State* L, const TieringOptions& options);
+
 using ModuleId = std::array<uint8_t, 16>;
 
 // Builds target function and all inner functions
@@ -163,6 +182,26 @@ CompilationResult compile(const ModuleId& moduleId, lua_State* L, int idx, unsig
 CompilationResult compile(lua_State* L, int idx, const CompilationOptions& options, CompilationStats* stats = nullptr);
 CompilationResult compile(const ModuleId& moduleId, lua_State* L, int idx, const CompilationOptions& options, CompilationStats* stats = nullptr);
 
+// Builds target function and all inner functions and serializes the native code into a blob instead of installing it
+// The blob is only valid for the same bytecode, flags, target CPU and Luau version; IR hooks have to match as well
+CompilationResult compileAot(lua_State* L, int idx, const CompilationOptions& options, std::string& blob);
+
+// Installs native code from a blob produced by compileAot for target function and all inner functions without compiling them
+// Returns AotBlobMismatch if the blob doesn't belong to the functions or can't be used on this CPU
+CompilationResult loadAot(lua_State* L, int idx, const CompilationOptions& options, const char* blob, size_t blobSize, CompilationStats* stats = nullptr);
+CompilationResult loadAot(const ModuleId& moduleId, lua_State* L, int idx, const CompilationOptions& options, const char* blob, size_t blobSize,
+    CompilationStats* stats = nullptr);
+
+// Builds target function and all inner functions on a background thread; returns Success once the compilation is queued
+// Native code is installed when the VM reaches a safepoint, using the interrupt callback which is restored when no compilations remain
+// A host that replaces the interrupt callback in the meantime has to call installCompiledCode itself
+// IR hooks in the options have to be safe to call from the background thread
+CodeGenCompilationResult compileAsync(lua_State* L, int idx, const CompilationOptions& options);
+
+// Installs native code of background compilations that have finished; if wait is set, waits for all pending compilations of the VM
+// Returns the number of functions that switched to native code
+unsigned int installCompiledCode(lua_State* L, bool wait = false);
+
 using AnnotatorFn = void (*)(void* context, std::string& result, int fid, int instpos);
 
 // Output "#" before IR blocks and instructions
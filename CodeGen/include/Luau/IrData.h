@@ -190,6 +190,35 @@ enum class IrCmd : uint8_t
     // A: TValue
     UNM_VEC,
 
+    // Compute Luau arithmetic on two double lanes at once
+    // A, B: double x2
+    ADD_NUM_X2,
+    SUB_NUM_X2,
+    MUL_NUM_X2,
+    DIV_NUM_X2,
+    MIN_NUM_X2,
+    MAX_NUM_X2,
+
+    // Compute unary operation on two double lanes at once
+    // A: double x2
+    UNM_NUM_X2,
+    ABS_NUM_X2,
+    SQRT_NUM_X2,
+
+    // Broadcast a double value to both lanes
+    // A: double
+    DUP_NUM_X2,
+
+    // Combine two double values into lanes
+    // A: double (lane 0)
+    // B: double (lane 1)
+    PACK_NUM_X2,
+
+    // Get double value of a lane
+    // A: double x2
+    // B: int (lane)
+    EXTRACT_NUM_X2,
+
     // Compute Luau 'not' operation on destructured TValue
     // A: tag
     // B: int (value)
@@ -460,6 +489,12 @@ enum class IrCmd : uint8_t
     // When undef is specified instead of a block, execution is aborted on check failure
     CHECK_BUFFER_LEN,
 
+    // Guard against two buffer pointers referencing the same buffer
+    // A, B: pointer (buffer)
+    // C: block/vmexit/undef
+    // When undef is specified, execution is aborted on check failure
+    CHECK_BUFFER_NO_ALIAS,
+
     // Special operations
 
     // Check interrupt handler
@@ -726,6 +761,21 @@ enum class IrCmd : uint8_t
     // B: int (offset)
     // C: double (value)
     BUFFER_WRITEF64,
+
+    // Read two values from buffer storage and convert them to double lanes
+    // A: pointer (buffer)
+    // B: int (lane 0 offset)
+    // C: int (lane 1 offset)
+    // D: unsigned int (IrCmd of the matching scalar read)
+    BUFFER_READ_X2,
+
+    // Write two double lanes to buffer storage
+    // A: pointer (buffer)
+    // B: int (lane 0 offset)
+    // C: int (lane 1 offset)
+    // D: double x2 (value)
+    // E: unsigned int (IrCmd of the matching scalar write, BUFFER_WRITEF32 or BUFFER_WRITEF64)
+    BUFFER_WRITE_X2,
 };
 
 enum class IrConstKind : uint8_t
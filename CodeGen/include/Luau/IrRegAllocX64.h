@@ -53,6 +53,13 @@ struct IrRegAllocX64
     bool shouldFreeGpr(RegisterX64 reg) const;
 
     unsigned findSpillStackSlot(IrValueKind valueKind);
+    void freeSpillStackSlot(const IrSpillX64& spill);
+
+    unsigned getSpillCost(const IrInst& inst) const;
+
+    bool takeCleanSpill(uint32_t instIdx, IrSpillX64& spill);
+    void releaseCleanSpill(uint32_t instIdx);
+    void releaseCleanSpills(unsigned startSpillId = 0);
 
     IrOp getRestoreOp(const IrInst& inst) const;
     bool hasRestoreOp(const IrInst& inst) const;
@@ -77,6 +84,10 @@ struct IrRegAllocX64
 
     uint32_t currInstIdx = ~0u;
 
+    // Spill candidates are chosen by distance to the next use relative to the spill cost, see CodeGen_WeightedSpills
+    // Values restored from a stack slot keep it until they die, so spilling them again doesn't need a store
+    bool weightedSpills = false;
+
     std::array<bool, 16> freeGprMap;
     std::array<uint32_t, 16> gprInstUsers;
     std::array<bool, 16> freeXmmMap;
@@ -87,6 +98,9 @@ struct IrRegAllocX64
     unsigned maxUsedSlot = 0;
     unsigned nextSpillId = 1;
     std::vector<IrSpillX64> spills;
+
+    // Values that are in registers and still have a valid copy in a spill stack slot
+    std::vector<IrSpillX64> cleanSpills;
 };
 
 struct ScopedRegX64
@@ -129,6 +129,7 @@ inline bool isNonTerminatingJump(IrCmd cmd)
     case IrCmd::CHECK_NODE_NO_NEXT:
     case IrCmd::CHECK_NODE_VALUE:
     case IrCmd::CHECK_BUFFER_LEN:
+    case IrCmd::CHECK_BUFFER_NO_ALIAS:
         return true;
     default:
         break;
@@ -173,6 +174,18 @@ inline bool hasResult(IrCmd cmd)
     case IrCmd::MUL_VEC:
     case IrCmd::DIV_VEC:
     case IrCmd::UNM_VEC:
+    case IrCmd::ADD_NUM_X2:
+    case IrCmd::SUB_NUM_X2:
+    case IrCmd::MUL_NUM_X2:
+    case IrCmd::DIV_NUM_X2:
+    case IrCmd::MIN_NUM_X2:
+    case IrCmd::MAX_NUM_X2:
+    case IrCmd::UNM_NUM_X2:
+    case IrCmd::ABS_NUM_X2:
+    case IrCmd::SQRT_NUM_X2:
+    case IrCmd::DUP_NUM_X2:
+    case IrCmd::PACK_NUM_X2:
+    case IrCmd::EXTRACT_NUM_X2:
     case IrCmd::NOT_ANY:
     case IrCmd::CMP_ANY:
     case IrCmd::TABLE_LEN:
@@ -213,6 +226,7 @@ inline bool hasResult(IrCmd cmd)
     case IrCmd::BUFFER_READI32:
     case IrCmd::BUFFER_READF32:
     case IrCmd::BUFFER_READF64:
+    case IrCmd::BUFFER_READ_X2:
         return true;
     default:
         break;
@@ -703,6 +703,51 @@ void AssemblyBuilderA64::fsub(RegisterA64 dst, RegisterA64 src1, RegisterA64 src
     }
 }
 
+void AssemblyBuilderA64::fabs_2d(RegisterA64 dst, RegisterA64 src)
+{
+    placeV1("fabs", "2d", "2d", dst, src, 0b0'1'0'01110'1'1'10000'01111'10 << 10);
+}
+
+void AssemblyBuilderA64::fadd_2d(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2)
+{
+    placeV3("fadd", "2d", dst, src1, src2, 0b0'1'0'01110'0'1'1'00000'11010'1 << 10);
+}
+
+void AssemblyBuilderA64::fdiv_2d(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2)
+{
+    placeV3("fdiv", "2d", dst, src1, src2, 0b0'1'1'01110'0'1'1'00000'11111'1 << 10);
+}
+
+void AssemblyBuilderA64::fmul_2d(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2)
+{
+    placeV3("fmul", "2d", dst, src1, src2, 0b0'1'1'01110'0'1'1'00000'11011'1 << 10);
+}
+
+void AssemblyBuilderA64::fneg_2d(RegisterA64 dst, RegisterA64 src)
+{
+    placeV1("fneg", "2d", "2d", dst, src, 0b0'1'1'01110'1'1'10000'01111'10 << 10);
+}
+
+void AssemblyBuilderA64::fsqrt_2d(RegisterA64 dst, RegisterA64 src)
+{
+    placeV1("fsqrt", "2d", "2d", dst, src, 0b0'1'1'01110'1'1'10000'11111'10 << 10);
+}
+
+void AssemblyBuilderA64::fsub_2d(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2)
+{
+    placeV3("fsub", "2d", dst, src1, src2, 0b0'1'0'01110'1'1'1'00000'11010'1 << 10);
+}
+
+void AssemblyBuilderA64::fcmgt_2d(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2)
+{
+    placeV3("fcmgt", "2d", dst, src1, src2, 0b0'1'1'01110'1'1'1'00000'11100'1 << 10);
+}
+
+void AssemblyBuilderA64::bsl_16b(RegisterA64 dst, RegisterA64 src1, RegisterA64 src2)
+{
+    placeV3("bsl", "16b", dst, src1, src2, 0b0'1'1'01110'0'1'1'00000'00011'1 << 10);
+}
+
 void AssemblyBuilderA64::ins_4s(RegisterA64 dst, RegisterA64 src, uint8_t index)
 {
     CODEGEN_ASSERT(dst.kind == KindA64::q && src.kind == KindA64::w);
@@ -762,6 +807,51 @@ void AssemblyBuilderA64::dup_4s(RegisterA64 dst, RegisterA64 src, uint8_t index)
     commit();
 }
 
+void AssemblyBuilderA64::ins_2d(RegisterA64 dst, uint8_t dstIndex, RegisterA64 src, uint8_t srcIndex)
+{
+    CODEGEN_ASSERT(dst.kind == KindA64::q && src.kind == KindA64::q);
+    CODEGEN_ASSERT(dstIndex < 2);
+    CODEGEN_ASSERT(srcIndex < 2);
+
+    if (logText)
+        logAppend(" %-12sv%d.d[%d],v%d.d[%d]\n", "ins", dst.index, dstIndex, src.index, srcIndex);
+
+    uint32_t op = 0b0'1'1'01110000'01000'0'0000'1;
+
+    place(dst.index | (src.index << 5) | (op << 10) | (dstIndex << 20) | (srcIndex << 14));
+    commit();
+}
+
+void AssemblyBuilderA64::dup_2d(RegisterA64 dst, RegisterA64 src, uint8_t index)
+{
+    if (dst.kind == KindA64::d)
+    {
+        CODEGEN_ASSERT(src.kind == KindA64::q);
+        CODEGEN_ASSERT(index < 2);
+
+        if (logText)
+            logAppend(" %-12sd%d,v%d.d[%d]\n", "dup", dst.index, src.index, index);
+
+        uint32_t op = 0b01'0'11110000'01000'0'0000'1;
+
+        place(dst.index | (src.index << 5) | (op << 10) | (index << 20));
+    }
+    else
+    {
+        CODEGEN_ASSERT(dst.kind == KindA64::q && src.kind == KindA64::q);
+        CODEGEN_ASSERT(index < 2);
+
+        if (logText)
+            logAppend(" %-12sv%d.2d,v%d.d[%d]\n", "dup", dst.index, src.index, index);
+
+        uint32_t op = 0b010'01110000'01000'0'0000'1;
+
+        place(dst.index | (src.index << 5) | (op << 10) | (index << 20));
+    }
+
+    commit();
+}
+
 void AssemblyBuilderA64::frinta(RegisterA64 dst, RegisterA64 src)
 {
     CODEGEN_ASSERT(dst.kind == KindA64::d && src.kind == KindA64::d);
@@ -825,6 +915,27 @@ void AssemblyBuilderA64::ucvtf(RegisterA64 dst, RegisterA64 src)
     placeR1("ucvtf", dst, src, 0b000'11110'01'1'00'011'000000);
 }
 
+void AssemblyBuilderA64::fcvtl_2d(RegisterA64 dst, RegisterA64 src)
+{
+    placeV1("fcvtl", "2d", "2s", dst, src, 0b0'0'0'01110'0'1'10000'10111'10 << 10);
+}
+
+void AssemblyBuilderA64::fcvtn_2s(RegisterA64 dst, RegisterA64 src)
+{
+    placeV1("fcvtn", "2s", "2d", dst, src, 0b0'0'0'01110'0'1'10000'10110'10 << 10);
+}
+
+void AssemblyBuilderA64::sxtl_2d(RegisterA64 dst, RegisterA64 src)
+{
+    // sshll with a zero shift
+    placeV1("sxtl", "2d", "2s", dst, src, 0b0'0'0'011110'0100'000'10100'1 << 10);
+}
+
+void AssemblyBuilderA64::scvtf_2d(RegisterA64 dst, RegisterA64 src)
+{
+    placeV1("scvtf", "2d", "2d", dst, src, 0b0'1'0'01110'0'1'10000'11101'10 << 10);
+}
+
 void AssemblyBuilderA64::fjcvtzs(RegisterA64 dst, RegisterA64 src)
 {
     CODEGEN_ASSERT(dst.kind == KindA64::w);
@@ -1274,6 +1385,29 @@ void AssemblyBuilderA64::placeVR(const char* name, RegisterA64 dst, RegisterA64
     commit();
 }
 
+void AssemblyBuilderA64::placeV3(const char* name, const char* arrangement, RegisterA64 dst, RegisterA64 src1, RegisterA64 src2, uint32_t op)
+{
+    if (logText)
+        logAppend(" %-12sv%d.%s,v%d.%s,v%d.%s\n", name, dst.index, arrangement, src1.index, arrangement, src2.index, arrangement);
+
+    CODEGEN_ASSERT(dst.kind == KindA64::q && dst.kind == src1.kind && dst.kind == src2.kind);
+
+    place(dst.index | (src1.index << 5) | (src2.index << 16) | op);
+    commit();
+}
+
+void AssemblyBuilderA64::placeV1(
+    const char* name, const char* dstArrangement, const char* srcArrangement, RegisterA64 dst, RegisterA64 src, uint32_t op)
+{
+    if (logText)
+        logAppend(" %-12sv%d.%s,v%d.%s\n", name, dst.index, dstArrangement, src.index, srcArrangement);
+
+    CODEGEN_ASSERT(dst.kind == KindA64::q && src.kind == KindA64::q);
+
+    place(dst.index | (src.index << 5) | op);
+    commit();
+}
+
 void AssemblyBuilderA64::place(uint32_t word)
 {
     CODEGEN_ASSERT(codePos < codeEnd);
@@ -734,6 +734,11 @@ void AssemblyBuilderX64::vaddss(OperandX64 dst, OperandX64 src1, OperandX64 src2
     placeAvx("vaddss", dst, src1, src2, 0x58, false, AVX_0F, AVX_F3);
 }
 
+void AssemblyBuilderX64::vsubpd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
+{
+    placeAvx("vsubpd", dst, src1, src2, 0x5c, false, AVX_0F, AVX_66);
+}
+
 void AssemblyBuilderX64::vsubsd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
 {
     placeAvx("vsubsd", dst, src1, src2, 0x5c, false, AVX_0F, AVX_F2);
@@ -744,6 +749,11 @@ void AssemblyBuilderX64::vsubps(OperandX64 dst, OperandX64 src1, OperandX64 src2
     placeAvx("vsubps", dst, src1, src2, 0x5c, false, AVX_0F, AVX_NP);
 }
 
+void AssemblyBuilderX64::vmulpd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
+{
+    placeAvx("vmulpd", dst, src1, src2, 0x59, false, AVX_0F, AVX_66);
+}
+
 void AssemblyBuilderX64::vmulsd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
 {
     placeAvx("vmulsd", dst, src1, src2, 0x59, false, AVX_0F, AVX_F2);
@@ -754,6 +764,11 @@ void AssemblyBuilderX64::vmulps(OperandX64 dst, OperandX64 src1, OperandX64 src2
     placeAvx("vmulps", dst, src1, src2, 0x59, false, AVX_0F, AVX_NP);
 }
 
+void AssemblyBuilderX64::vdivpd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
+{
+    placeAvx("vdivpd", dst, src1, src2, 0x5e, false, AVX_0F, AVX_66);
+}
+
 void AssemblyBuilderX64::vdivsd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
 {
     placeAvx("vdivsd", dst, src1, src2, 0x5e, false, AVX_0F, AVX_F2);
@@ -829,6 +844,21 @@ void AssemblyBuilderX64::vcvtss2sd(OperandX64 dst, OperandX64 src1, OperandX64 s
     placeAvx("vcvtss2sd", dst, src1, src2, 0x5a, false, AVX_0F, AVX_F3);
 }
 
+void AssemblyBuilderX64::vcvtps2pd(OperandX64 dst, OperandX64 src)
+{
+    placeAvx("vcvtps2pd", dst, src, 0x5a, false, AVX_0F, AVX_NP);
+}
+
+void AssemblyBuilderX64::vcvtpd2ps(OperandX64 dst, OperandX64 src)
+{
+    placeAvx("vcvtpd2ps", dst, src, 0x5a, false, AVX_0F, AVX_66);
+}
+
+void AssemblyBuilderX64::vcvtdq2pd(OperandX64 dst, OperandX64 src)
+{
+    placeAvx("vcvtdq2pd", dst, src, 0xe6, false, AVX_0F, AVX_F3);
+}
+
 void AssemblyBuilderX64::vroundsd(OperandX64 dst, OperandX64 src1, OperandX64 src2, RoundingModeX64 roundingMode)
 {
     placeAvx("vroundsd", dst, src1, src2, uint8_t(roundingMode) | kRoundingPrecisionInexact, 0x0b, false, AVX_0F3A, AVX_66);
@@ -914,11 +944,51 @@ void AssemblyBuilderX64::vmovq(OperandX64 dst, OperandX64 src)
     }
 }
 
+void AssemblyBuilderX64::vmovhpd(OperandX64 dst, OperandX64 src)
+{
+    // Only the store form has two operands
+    CODEGEN_ASSERT(dst.cat == CategoryX64::mem);
+
+    placeAvx("vmovhpd", dst, src, 0x16, 0x17, false, AVX_0F, AVX_66);
+}
+
+void AssemblyBuilderX64::vmovhpd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
+{
+    CODEGEN_ASSERT(src2.cat == CategoryX64::mem);
+
+    placeAvx("vmovhpd", dst, src1, src2, 0x16, false, AVX_0F, AVX_66);
+}
+
+void AssemblyBuilderX64::vmovddup(OperandX64 dst, OperandX64 src)
+{
+    placeAvx("vmovddup", dst, src, 0x12, false, AVX_0F, AVX_F2);
+}
+
+void AssemblyBuilderX64::vunpcklpd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
+{
+    placeAvx("vunpcklpd", dst, src1, src2, 0x14, false, AVX_0F, AVX_66);
+}
+
+void AssemblyBuilderX64::vunpckhpd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
+{
+    placeAvx("vunpckhpd", dst, src1, src2, 0x15, false, AVX_0F, AVX_66);
+}
+
+void AssemblyBuilderX64::vmaxpd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
+{
+    placeAvx("vmaxpd", dst, src1, src2, 0x5f, false, AVX_0F, AVX_66);
+}
+
 void AssemblyBuilderX64::vmaxsd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
 {
     placeAvx("vmaxsd", dst, src1, src2, 0x5f, false, AVX_0F, AVX_F2);
 }
 
+void AssemblyBuilderX64::vminpd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
+{
+    placeAvx("vminpd", dst, src1, src2, 0x5d, false, AVX_0F, AVX_66);
+}
+
 void AssemblyBuilderX64::vminsd(OperandX64 dst, OperandX64 src1, OperandX64 src2)
 {
     placeAvx("vminsd", dst, src1, src2, 0x5d, false, AVX_0F, AVX_F2);
@@ -945,6 +1015,27 @@ void AssemblyBuilderX64::vpinsrd(RegisterX64 dst, RegisterX64 src1, OperandX64 s
     placeAvx("vpinsrd", dst, src1, src2, offset, 0x22, false, AVX_0F3A, AVX_66);
 }
 
+void AssemblyBuilderX64::vinsertps(RegisterX64 dst, RegisterX64 src1, OperandX64 src2, uint8_t offset)
+{
+    placeAvx("vinsertps", dst, src1, src2, offset, 0x21, false, AVX_0F3A, AVX_66);
+}
+
+void AssemblyBuilderX64::vextractps(OperandX64 dst, RegisterX64 src, uint8_t offset)
+{
+    CODEGEN_ASSERT(dst.cat == CategoryX64::mem || (dst.cat == CategoryX64::reg && dst.base.size == SizeX64::dword));
+
+    if (logText)
+        log("vextractps", dst, src, offset);
+
+    // Source register is encoded in the reg field of ModRM
+    placeVex(src, noreg, dst, false, AVX_0F3A, AVX_66);
+    place(0x17);
+    placeRegAndModRegMem(src, dst, /*extraCodeBytes=*/1);
+    placeImm8(offset);
+
+    commit();
+}
+
 bool AssemblyBuilderX64::finalize()
 {
     code.resize(codePos - code.data());
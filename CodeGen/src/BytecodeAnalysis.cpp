@@ -255,11 +255,9 @@ static void refineUpvalueType(BytecodeTypeInfo& info, int up, uint8_t ty)
     }
 }
 
-static uint8_t getBytecodeConstantTag(Proto* proto, unsigned ki)
+static uint8_t getBytecodeTag(int tt)
 {
-    TValue protok = proto->k[ki];
-
-    switch (protok.tt)
+    switch (tt)
     {
     case LUA_TNIL:
         return LBC_TYPE_NIL;
@@ -288,6 +286,76 @@ static uint8_t getBytecodeConstantTag(Proto* proto, unsigned ki)
     return LBC_TYPE_ANY;
 }
 
+static uint8_t getBytecodeConstantTag(Proto* proto, unsigned ki)
+{
+    return getBytecodeTag(proto->k[ki].tt);
+}
+
+static uint8_t getTypeFeedbackTag(Proto* proto, int pcpos, int slot)
+{
+    uint8_t feedback = proto->typefeedback[2 * pcpos + slot];
+
+    // Light userdata shares the bytecode type with full userdata, but can't pass its tag check
+    if (feedback == 0 || feedback == TYPEFEEDBACK_MIXED || feedback - 1 == LUA_TLIGHTUSERDATA)
+        return LBC_TYPE_ANY;
+
+    return getBytecodeTag(feedback - 1);
+}
+
+// Operand tags observed by the interpreter refine registers we know nothing about; native code still checks the tags, exiting to VM on mismatch
+static void applyTypeFeedback(Proto* proto, int pcpos, LuauOpcode op, uint8_t* regTags)
+{
+    const Instruction* pc = &proto->code[pcpos];
+    int rb = -1;
+    int rc = -1;
+
+    switch (op)
+    {
+    case LOP_ADD:
+    case LOP_SUB:
+    case LOP_MUL:
+    case LOP_DIV:
+    case LOP_IDIV:
+    case LOP_MOD:
+    case LOP_POW:
+    case LOP_GETTABLE:
+    case LOP_SETTABLE:
+    case LOP_GETTABLE_GETTABLE:
+    case LOP_GETTABLE_ADD:
+        rb = LUAU_INSN_B(*pc);
+        rc = LUAU_INSN_C(*pc);
+        break;
+    case LOP_ADDK:
+    case LOP_SUBK:
+    case LOP_MULK:
+    case LOP_DIVK:
+    case LOP_IDIVK:
+    case LOP_MODK:
+    case LOP_POWK:
+    case LOP_MINUS:
+    case LOP_GETTABLEN:
+    case LOP_SETTABLEN:
+    case LOP_GETTABLEKS:
+    case LOP_SETTABLEKS:
+    case LOP_GETTABLEKS_GETTABLEKS:
+    case LOP_NAMECALL:
+        rb = LUAU_INSN_B(*pc);
+        break;
+    case LOP_SUBRK:
+    case LOP_DIVRK:
+        rc = LUAU_INSN_C(*pc);
+        break;
+    default:
+        return;
+    }
+
+    if (rb >= 0 && regTags[rb] == LBC_TYPE_ANY)
+        regTags[rb] = getTypeFeedbackTag(proto, pcpos, 0);
+
+    if (rc >= 0 && regTags[rc] == LBC_TYPE_ANY)
+        regTags[rc] = getTypeFeedbackTag(proto, pcpos, 1);
+}
+
 static void applyBuiltinCall(int bfid, BytecodeTypes& types)
 {
     switch (bfid)
@@ -690,6 +758,9 @@ void analyzeBytecodeTypes(IrFunction& function, const HostIrHooks& hostHooks)
                 }
             }
 
+            if (proto->typefeedback)
+                applyTypeFeedback(proto, i, op, regTags);
+
             BytecodeTypes& bcType = function.bcTypes[i];
 
             switch (op)
@@ -760,6 +831,8 @@ void analyzeBytecodeTypes(IrFunction& function, const HostIrHooks& hostHooks)
                 break;
             }
             case LOP_GETTABLE:
+            case LOP_GETTABLE_GETTABLE:
+            case LOP_GETTABLE_ADD:
             {
                 int rb = LUAU_INSN_B(*pc);
                 int rc = LUAU_INSN_C(*pc);
@@ -776,6 +849,7 @@ void analyzeBytecodeTypes(IrFunction& function, const HostIrHooks& hostHooks)
                 break;
             }
             case LOP_GETTABLEKS:
+            case LOP_GETTABLEKS_GETTABLEKS:
             {
                 int ra = LUAU_INSN_A(*pc);
                 int rb = LUAU_INSN_B(*pc);
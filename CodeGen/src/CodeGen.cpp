@@ -87,6 +87,8 @@ std::string toString(const CodeGenCompilationResult& result)
         return "CodeGenLoweringFailure";
     case CodeGenCompilationResult::AllocationFailed:
         return "AllocationFailed";
+    case CodeGenCompilationResult::AotBlobMismatch:
+        return "AotBlobMismatch";
     case CodeGenCompilationResult::Count:
         return "Count";
     }
@@ -221,6 +223,11 @@ void setNativeExecutionEnabled(lua_State* L, bool enabled)
     setNativeExecutionEnabled_NEW(L, enabled);
 }
 
+void setTiering(lua_State* L, const TieringOptions& options)
+{
+    setTiering_NEW(L, options);
+}
+
 CompilationResult compile(lua_State* L, int idx, unsigned int flags, CompilationStats* stats)
 {
     Luau::CodeGen::CompilationOptions options{flags};
@@ -244,6 +251,32 @@ CompilationResult compile(const ModuleId& moduleId, lua_State* L, int idx, const
     return compile_NEW(moduleId, L, idx, options, stats);
 }
 
+CompilationResult compileAot(lua_State* L, int idx, const CompilationOptions& options, std::string& blob)
+{
+    return compileAot_NEW(L, idx, options, blob);
+}
+
+CompilationResult loadAot(lua_State* L, int idx, const CompilationOptions& options, const char* blob, size_t blobSize, CompilationStats* stats)
+{
+    return loadAot_NEW(L, idx, options, blob, blobSize, stats);
+}
+
+CompilationResult loadAot(
+    const ModuleId& moduleId, lua_State* L, int idx, const CompilationOptions& options, const char* blob, size_t blobSize, CompilationStats* stats)
+{
+    return loadAot_NEW(moduleId, L, idx, options, blob, blobSize, stats);
+}
+
+CodeGenCompilationResult compileAsync(lua_State* L, int idx, const CompilationOptions& options)
+{
+    return compileAsync_NEW(L, idx, options);
+}
+
+unsigned int installCompiledCode(lua_State* L, bool wait)
+{
+    return installCompiledCode_NEW(L, wait);
+}
+
 void setPerfLog(void* context, PerfLogFn logFn)
 {
     gPerfLogContext = context;
@@ -5,6 +5,7 @@
 #include "CodeGenLower.h"
 #include "CodeGenX64.h"
 
+#include "Luau/BytecodeUtils.h"
 #include "Luau/CodeBlockUnwind.h"
 #include "Luau/UnwindBuilder.h"
 #include "Luau/UnwindBuilderDwarf2.h"
@@ -12,6 +13,9 @@
 
 #include "lapi.h"
 
+#include <algorithm>
+#include <iterator>
+
 LUAU_FASTFLAGVARIABLE(LuauCodegenCheckNullContext, false)
 
 LUAU_FASTINT(LuauCodeGenBlockSize)
@@ -339,6 +343,9 @@ static int onEnterDisabled(lua_State* L, Proto* proto)
 // Defined in CodeGen.cpp
 void onDisable(lua_State* L, Proto* proto);
 
+// Defined below, with the background compilation
+static void onClosingState(lua_State* L) noexcept;
+
 static size_t getMemorySize(lua_State* L, Proto* proto)
 {
     const NativeProtoExecDataHeader& execDataHeader = getNativeProtoExecDataHeader(static_cast<const uint32_t*>(proto->execdata));
@@ -359,6 +366,7 @@ static void initializeExecutionCallbacks(lua_State* L, BaseCodeGenContext* codeG
 
     ecb->context = codeGenContext;
     ecb->close = onCloseState;
+    ecb->closing = onClosingState;
     ecb->destroy = onDestroyFunction;
     ecb->enter = onEnter;
     ecb->disable = onDisable;
@@ -418,9 +426,9 @@ void create_NEW(lua_State* L, SharedCodeGenContext* codeGenContext)
 
 template<typename AssemblyBuilder>
 [[nodiscard]] static NativeProtoExecDataPtr createNativeFunction(AssemblyBuilder& build, ModuleHelpers& helpers, Proto* proto,
-    uint32_t& totalIrInstCount, const HostIrHooks& hooks, CodeGenCompilationResult& result)
+    uint32_t& totalIrInstCount, const CompilationOptions& options, CodeGenCompilationResult& result)
 {
-    IrBuilder ir(hooks);
+    IrBuilder ir(options.hooks);
     ir.buildFunctionIr(proto);
 
     unsigned instCount = unsigned(ir.function.instructions.size());
@@ -433,7 +441,10 @@ template<typename AssemblyBuilder>
 
     totalIrInstCount += instCount;
 
-    if (!lowerFunction(ir, build, helpers, proto, {}, /* stats */ nullptr, result))
+    AssemblyOptions assemblyOptions;
+    assemblyOptions.compilationOptions = options;
+
+    if (!lowerFunction(ir, build, helpers, proto, assemblyOptions, /* stats */ nullptr, result))
     {
         return {};
     }
@@ -441,48 +452,9 @@ template<typename AssemblyBuilder>
     return createNativeProtoExecData(proto, ir);
 }
 
-[[nodiscard]] static CompilationResult compileInternal(
-    const std::optional<ModuleId>& moduleId, lua_State* L, int idx, const CompilationOptions& options, CompilationStats* stats)
+// Only reads the function objects, so it can run on a thread other than the one running the VM
+[[nodiscard]] static AssembledModule assembleProtos(const std::vector<Proto*>& protos, const CompilationOptions& options, CompilationStats* stats)
 {
-    CODEGEN_ASSERT(lua_isLfunction(L, idx));
-    const TValue* func = luaA_toobject(L, idx);
-
-    Proto* root = clvalue(func)->l.p;
-
-    if ((options.flags & CodeGen_OnlyNativeModules) != 0 && (root->flags & LPF_NATIVE_MODULE) == 0)
-        return CompilationResult{CodeGenCompilationResult::NotNativeModule};
-
-    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
-    if (codeGenContext == nullptr)
-        return CompilationResult{CodeGenCompilationResult::CodeGenNotInitialized};
-
-    std::vector<Proto*> protos;
-    gatherFunctions(protos, root, options.flags);
-
-    // Skip protos that have been compiled during previous invocations of CodeGen::compile
-    protos.erase(std::remove_if(protos.begin(), protos.end(),
-                     [](Proto* p) {
-                         return p == nullptr || p->execdata != nullptr;
-                     }),
-        protos.end());
-
-    if (protos.empty())
-        return CompilationResult{CodeGenCompilationResult::NothingToCompile};
-
-    if (stats != nullptr)
-        stats->functionsTotal = uint32_t(protos.size());
-
-    if (moduleId.has_value())
-    {
-        if (std::optional<ModuleBindResult> existingModuleBindResult = codeGenContext->tryBindExistingModule(*moduleId, protos))
-        {
-            if (stats != nullptr)
-                stats->functionsBound = existingModuleBindResult->functionsBound;
-
-            return CompilationResult{existingModuleBindResult->compilationResult};
-        }
-    }
-
 #if defined(CODEGEN_TARGET_A64)
     static unsigned int cpuFeatures = getCpuFeaturesA64();
     A64::AssemblyBuilderA64 build(/* logText= */ false, cpuFeatures);
@@ -497,10 +469,8 @@ template<typename AssemblyBuilder>
     X64::assembleHelpers(build, helpers);
 #endif
 
-    CompilationResult compilationResult;
-
-    std::vector<NativeProtoExecDataPtr> nativeProtos;
-    nativeProtos.reserve(protos.size());
+    AssembledModule module;
+    module.nativeProtos.reserve(protos.size());
 
     uint32_t totalIrInstCount = 0;
 
@@ -508,14 +478,14 @@ template<typename AssemblyBuilder>
     {
         CodeGenCompilationResult protoResult = CodeGenCompilationResult::Success;
 
-        NativeProtoExecDataPtr nativeExecData = createNativeFunction(build, helpers, protos[i], totalIrInstCount, options.hooks, protoResult);
+        NativeProtoExecDataPtr nativeExecData = createNativeFunction(build, helpers, protos[i], totalIrInstCount, options, protoResult);
         if (nativeExecData != nullptr)
         {
-            nativeProtos.push_back(std::move(nativeExecData));
+            module.nativeProtos.push_back(std::move(nativeExecData));
         }
         else
         {
-            compilationResult.protoFailures.push_back(
+            module.compilationResult.protoFailures.push_back(
                 {protoResult, protos[i]->debugname ? getstr(protos[i]->debugname) : "", protos[i]->linedefined});
         }
     }
@@ -524,17 +494,18 @@ template<typename AssemblyBuilder>
     // case we currently abandon the entire module
     if (!build.finalize())
     {
-        compilationResult.result = CodeGenCompilationResult::CodeGenAssemblerFinalizationFailure;
-        return compilationResult;
+        module.compilationResult.result = CodeGenCompilationResult::CodeGenAssemblerFinalizationFailure;
+        module.nativeProtos.clear();
+        return module;
     }
 
     // If no functions were assembled, we don't need to allocate/copy executable pages for helpers
-    if (nativeProtos.empty())
-        return compilationResult;
+    if (module.nativeProtos.empty())
+        return module;
 
     if (stats != nullptr)
     {
-        for (const NativeProtoExecDataPtr& nativeExecData : nativeProtos)
+        for (const NativeProtoExecDataPtr& nativeExecData : module.nativeProtos)
         {
             NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeExecData.get());
 
@@ -544,27 +515,43 @@ template<typename AssemblyBuilder>
             stats->nativeMetadataSizeBytes += header.bytecodeInstructionCount * sizeof(uint32_t);
         }
 
-        stats->functionsCompiled += uint32_t(nativeProtos.size());
+        stats->functionsCompiled += uint32_t(module.nativeProtos.size());
         stats->nativeCodeSizeBytes += build.code.size() * sizeof(build.code[0]);
         stats->nativeDataSizeBytes += build.data.size();
     }
 
-    for (size_t i = 0; i < nativeProtos.size(); ++i)
+    for (size_t i = 0; i < module.nativeProtos.size(); ++i)
     {
-        NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeProtos[i].get());
+        NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(module.nativeProtos[i].get());
 
         uint32_t begin = uint32_t(reinterpret_cast<uintptr_t>(header.entryOffsetOrAddress));
-        uint32_t end = i + 1 < nativeProtos.size() ? uint32_t(uintptr_t(getNativeProtoExecDataHeader(nativeProtos[i + 1].get()).entryOffsetOrAddress))
-                                                   : uint32_t(build.code.size() * sizeof(build.code[0]));
+        uint32_t end = i + 1 < module.nativeProtos.size()
+                           ? uint32_t(uintptr_t(getNativeProtoExecDataHeader(module.nativeProtos[i + 1].get()).entryOffsetOrAddress))
+                           : uint32_t(build.code.size() * sizeof(build.code[0]));
 
         CODEGEN_ASSERT(begin < end);
 
         header.nativeCodeSize = end - begin;
     }
 
-    const ModuleBindResult bindResult =
-        codeGenContext->bindModule(moduleId, protos, std::move(nativeProtos), reinterpret_cast<const uint8_t*>(build.data.data()), build.data.size(),
-            reinterpret_cast<const uint8_t*>(build.code.data()), build.code.size() * sizeof(build.code[0]));
+    const uint8_t* code = reinterpret_cast<const uint8_t*>(build.code.data());
+
+    module.data = std::move(build.data);
+    module.code.assign(code, code + build.code.size() * sizeof(build.code[0]));
+
+    return module;
+}
+
+[[nodiscard]] static CompilationResult bindAssembledModule(const std::optional<ModuleId>& moduleId, BaseCodeGenContext* codeGenContext,
+    const std::vector<Proto*>& protos, AssembledModule module, CompilationStats* stats)
+{
+    CompilationResult compilationResult = std::move(module.compilationResult);
+
+    if (module.nativeProtos.empty())
+        return compilationResult;
+
+    const ModuleBindResult bindResult = codeGenContext->bindModule(
+        moduleId, protos, std::move(module.nativeProtos), module.data.data(), module.data.size(), module.code.data(), module.code.size());
 
     if (stats != nullptr)
         stats->functionsBound = bindResult.functionsBound;
@@ -575,6 +562,473 @@ template<typename AssemblyBuilder>
     return compilationResult;
 }
 
+// Keeps native code only for functions that can still switch to it; they could have been compiled or have breakpoints set in the meantime
+// Returns false if the code doesn't belong to the functions
+[[nodiscard]] static bool selectUnboundProtos(
+    const std::vector<Proto*>& protos, std::vector<NativeProtoExecDataPtr>& nativeProtos, std::vector<Proto*>& unboundProtos)
+{
+    std::vector<NativeProtoExecDataPtr> unboundNativeProtos;
+
+    auto protoIt = protos.begin();
+
+    for (NativeProtoExecDataPtr& nativeProto : nativeProtos)
+    {
+        const NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeProto.get());
+
+        while (protoIt != protos.end() && uint32_t((**protoIt).bytecodeid) != header.bytecodeId)
+            ++protoIt;
+
+        if (protoIt == protos.end() || uint32_t((**protoIt).sizecode) != header.bytecodeInstructionCount)
+            return false;
+
+        if ((**protoIt).execdata == nullptr && (**protoIt).debuginsn == nullptr)
+        {
+            unboundProtos.push_back(*protoIt);
+            unboundNativeProtos.push_back(std::move(nativeProto));
+        }
+    }
+
+    nativeProtos = std::move(unboundNativeProtos);
+    return true;
+}
+
+[[nodiscard]] static CompilationResult compileProtos(const std::optional<ModuleId>& moduleId, BaseCodeGenContext* codeGenContext,
+    const std::vector<Proto*>& protos, const CompilationOptions& options, CompilationStats* stats)
+{
+    CODEGEN_ASSERT(!protos.empty());
+
+    if (stats != nullptr)
+        stats->functionsTotal = uint32_t(protos.size());
+
+    if (moduleId.has_value())
+    {
+        if (std::optional<ModuleBindResult> existingModuleBindResult = codeGenContext->tryBindExistingModule(*moduleId, protos))
+        {
+            if (stats != nullptr)
+                stats->functionsBound = existingModuleBindResult->functionsBound;
+
+            return CompilationResult{existingModuleBindResult->compilationResult};
+        }
+    }
+
+    return bindAssembledModule(moduleId, codeGenContext, protos, assembleProtos(protos, options, stats), stats);
+}
+
+[[nodiscard]] static CodeGenCompilationResult gatherProtosToCompile(
+    lua_State* L, int idx, const CompilationOptions& options, std::vector<Proto*>& protos)
+{
+    CODEGEN_ASSERT(lua_isLfunction(L, idx));
+    const TValue* func = luaA_toobject(L, idx);
+
+    Proto* root = clvalue(func)->l.p;
+
+    if ((options.flags & CodeGen_OnlyNativeModules) != 0 && (root->flags & LPF_NATIVE_MODULE) == 0)
+        return CodeGenCompilationResult::NotNativeModule;
+
+    if (getCodeGenContext(L) == nullptr)
+        return CodeGenCompilationResult::CodeGenNotInitialized;
+
+    gatherFunctions(protos, root, options.flags);
+
+    // Skip protos that have been compiled during previous invocations of CodeGen::compile
+    protos.erase(std::remove_if(protos.begin(), protos.end(),
+                     [](Proto* p) {
+                         return p == nullptr || p->execdata != nullptr;
+                     }),
+        protos.end());
+
+    if (protos.empty())
+        return CodeGenCompilationResult::NothingToCompile;
+
+    return CodeGenCompilationResult::Success;
+}
+
+[[nodiscard]] static CompilationResult compileInternal(
+    const std::optional<ModuleId>& moduleId, lua_State* L, int idx, const CompilationOptions& options, CompilationStats* stats)
+{
+    std::vector<Proto*> protos;
+
+    if (CodeGenCompilationResult result = gatherProtosToCompile(L, idx, options, protos); result != CodeGenCompilationResult::Success)
+        return CompilationResult{result};
+
+    return compileProtos(moduleId, getCodeGenContext(L), protos, options, stats);
+}
+
+// Native code blobs start with a header that identifies the code generator and the functions the code was compiled from
+static const char kAotMagic[4] = {'L', 'N', 'C', 'B'};
+
+// Has to be incremented whenever the layout of the blob or the generated code changes in a way that makes old blobs incompatible
+static const uint32_t kAotVersion = 1;
+
+enum class AotTarget : uint32_t
+{
+    X64_SystemV,
+    X64_Windows,
+    A64,
+};
+
+[[nodiscard]] static AotTarget getAotTarget()
+{
+#if defined(CODEGEN_TARGET_A64)
+    return AotTarget::A64;
+#elif defined(_WIN32)
+    return AotTarget::X64_Windows;
+#else
+    return AotTarget::X64_SystemV;
+#endif
+}
+
+[[nodiscard]] static uint32_t getAotCpuFeatures()
+{
+#if defined(CODEGEN_TARGET_A64)
+    return getCpuFeaturesA64();
+#else
+    return 0;
+#endif
+}
+
+static void hashBytes(uint64_t& hash, const void* data, size_t size)
+{
+    // FNV-1a
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+template<typename T>
+static void hashValue(uint64_t& hash, const T& value)
+{
+    hashBytes(hash, &value, sizeof(value));
+}
+
+// Instructions are patched at runtime: slot hints are stored in C, coverage hit counts in E and breakpoints replace the opcode
+[[nodiscard]] static Instruction getLoadedInsn(Proto* proto, int pc, LuauOpcode op)
+{
+    Instruction insn = (proto->code[pc] & ~0xffu) | op;
+
+    switch (op)
+    {
+    case LOP_GETGLOBAL:
+    case LOP_SETGLOBAL:
+    case LOP_GETTABLEKS:
+    case LOP_GETTABLEKS_GETTABLEKS:
+    case LOP_SETTABLEKS:
+    case LOP_NAMECALL:
+        return insn & 0x00ffffffu;
+    case LOP_COVERAGE:
+        return insn & 0xffu;
+    default:
+        return insn;
+    }
+}
+
+// Covers everything that native code of the functions is specialized on, so that a blob is never bound to different bytecode
+[[nodiscard]] static uint64_t hashProtos(const std::vector<Proto*>& protos)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    for (Proto* proto : protos)
+    {
+        hashValue(hash, proto->bytecodeid);
+        hashValue(hash, proto->numparams);
+        hashValue(hash, proto->is_vararg);
+        hashValue(hash, proto->maxstacksize);
+        hashValue(hash, proto->flags);
+
+        // Imported values are resolved when bytecode is loaded and depend on the environment; native code checks them at runtime
+        std::vector<bool> imports(proto->sizek);
+
+        hashValue(hash, proto->sizecode);
+
+        for (int i = 0; i < proto->sizecode;)
+        {
+            // Breakpoints replace the opcode, the original one is kept in debuginsn
+            LuauOpcode op = LuauOpcode(proto->debuginsn ? proto->debuginsn[i] : LUAU_INSN_OP(proto->code[i]));
+
+            if (op == LOP_GETIMPORT)
+                imports[LUAU_INSN_D(proto->code[i])] = true;
+
+            hashValue(hash, getLoadedInsn(proto, i, op));
+
+            // Auxiliary words are never patched
+            int length = getOpLength(op);
+
+            if (length > 1)
+                hashBytes(hash, &proto->code[i + 1], (length - 1) * sizeof(Instruction));
+
+            i += length;
+        }
+
+        // Type information size is only valid when it's present
+        if (proto->typeinfo)
+            hashBytes(hash, proto->typeinfo, proto->sizetypeinfo);
+
+        hashValue(hash, proto->sizek);
+
+        for (int i = 0; i < proto->sizek; ++i)
+        {
+            const TValue* k = &proto->k[i];
+
+            if (imports[i])
+                continue;
+
+            hashValue(hash, k->tt);
+
+            if (ttisnumber(k))
+                hashValue(hash, nvalue(k));
+            else if (ttisboolean(k))
+                hashValue(hash, bvalue(k));
+            else if (ttisvector(k))
+                hashBytes(hash, vvalue(k), LUA_VECTOR_SIZE * sizeof(float));
+            else if (ttisstring(k))
+                hashBytes(hash, getstr(tsvalue(k)), tsvalue(k)->len);
+        }
+    }
+
+    return hash;
+}
+
+static void writeAotU32(std::string& blob, uint32_t value)
+{
+    blob.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void writeAotU64(std::string& blob, uint64_t value)
+{
+    blob.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+struct AotReader
+{
+    const char* data = nullptr;
+    size_t size = 0;
+    size_t offset = 0;
+    bool failed = false;
+
+    bool read(void* result, size_t count)
+    {
+        if (failed || size - offset < count)
+        {
+            failed = true;
+            return false;
+        }
+
+        memcpy(result, data + offset, count);
+        offset += count;
+        return true;
+    }
+
+    uint32_t readU32()
+    {
+        uint32_t value = 0;
+        read(&value, sizeof(value));
+        return value;
+    }
+
+    uint64_t readU64()
+    {
+        uint64_t value = 0;
+        read(&value, sizeof(value));
+        return value;
+    }
+
+    bool readBytes(std::vector<uint8_t>& result)
+    {
+        uint32_t count = readU32();
+
+        if (failed || size - offset < count)
+        {
+            failed = true;
+            return false;
+        }
+
+        result.assign(data + offset, data + offset + count);
+        offset += count;
+        return true;
+    }
+};
+
+[[nodiscard]] static std::vector<Proto*> gatherAotProtos(lua_State* L, int idx, const CompilationOptions& options)
+{
+    CODEGEN_ASSERT(lua_isLfunction(L, idx));
+    const TValue* func = luaA_toobject(L, idx);
+
+    std::vector<Proto*> protos;
+    gatherFunctions(protos, clvalue(func)->l.p, options.flags);
+
+    protos.erase(std::remove(protos.begin(), protos.end(), nullptr), protos.end());
+
+    return protos;
+}
+
+[[nodiscard]] static CompilationResult compileAotInternal(lua_State* L, int idx, const CompilationOptions& options, std::string& blob)
+{
+    CODEGEN_ASSERT(lua_isLfunction(L, idx));
+    const TValue* func = luaA_toobject(L, idx);
+
+    if ((options.flags & CodeGen_OnlyNativeModules) != 0 && (clvalue(func)->l.p->flags & LPF_NATIVE_MODULE) == 0)
+        return CompilationResult{CodeGenCompilationResult::NotNativeModule};
+
+    std::vector<Proto*> protos = gatherAotProtos(L, idx, options);
+
+    if (protos.empty())
+        return CompilationResult{CodeGenCompilationResult::NothingToCompile};
+
+    AssembledModule module = assembleProtos(protos, options, nullptr);
+
+    if (module.nativeProtos.empty())
+        return module.compilationResult;
+
+    blob.clear();
+    blob.append(kAotMagic, sizeof(kAotMagic));
+    writeAotU32(blob, kAotVersion);
+    writeAotU32(blob, uint32_t(getAotTarget()));
+    writeAotU32(blob, getAotCpuFeatures());
+    writeAotU32(blob, options.flags);
+    writeAotU32(blob, uint32_t(sizeof(NativeContext)));
+    writeAotU64(blob, hashProtos(protos));
+
+    writeAotU32(blob, uint32_t(module.nativeProtos.size()));
+
+    for (const NativeProtoExecDataPtr& nativeProto : module.nativeProtos)
+    {
+        const NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeProto.get());
+
+        writeAotU32(blob, header.bytecodeId);
+        writeAotU32(blob, header.bytecodeInstructionCount);
+        writeAotU32(blob, uint32_t(reinterpret_cast<uintptr_t>(header.entryOffsetOrAddress)));
+        writeAotU32(blob, uint32_t(header.nativeCodeSize));
+
+        blob.append(reinterpret_cast<const char*>(nativeProto.get()), header.bytecodeInstructionCount * sizeof(uint32_t));
+    }
+
+    writeAotU32(blob, uint32_t(module.data.size()));
+    blob.append(reinterpret_cast<const char*>(module.data.data()), module.data.size());
+
+    writeAotU32(blob, uint32_t(module.code.size()));
+    blob.append(reinterpret_cast<const char*>(module.code.data()), module.code.size());
+
+    return module.compilationResult;
+}
+
+// Fails if the blob was produced by a different code generator or for different functions
+[[nodiscard]] static std::optional<AssembledModule> readAotModule(
+    const std::vector<Proto*>& protos, const CompilationOptions& options, const char* blob, size_t blobSize)
+{
+    AotReader reader{blob, blobSize};
+
+    char magic[sizeof(kAotMagic)] = {};
+    if (!reader.read(magic, sizeof(magic)) || memcmp(magic, kAotMagic, sizeof(kAotMagic)) != 0)
+        return std::nullopt;
+
+    if (reader.readU32() != kAotVersion || reader.readU32() != uint32_t(getAotTarget()) || reader.readU32() != getAotCpuFeatures() ||
+        reader.readU32() != options.flags || reader.readU32() != uint32_t(sizeof(NativeContext)) || reader.readU64() != hashProtos(protos))
+        return std::nullopt;
+
+    AssembledModule module;
+
+    uint32_t nativeProtoCount = reader.readU32();
+
+    if (nativeProtoCount > protos.size())
+        return std::nullopt;
+
+    for (uint32_t i = 0; i < nativeProtoCount && !reader.failed; ++i)
+    {
+        uint32_t bytecodeId = reader.readU32();
+        uint32_t instructionCount = reader.readU32();
+        uint32_t entryOffset = reader.readU32();
+        uint32_t nativeCodeSize = reader.readU32();
+
+        // The hash guarantees that the functions match, this only protects from a truncated or corrupted blob
+        if (instructionCount == 0 || instructionCount > blobSize / sizeof(uint32_t))
+            return std::nullopt;
+
+        NativeProtoExecDataPtr nativeProto = createNativeProtoExecData(instructionCount);
+
+        NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeProto.get());
+        header.entryOffsetOrAddress = reinterpret_cast<const uint8_t*>(uintptr_t(entryOffset));
+        header.bytecodeId = bytecodeId;
+        header.bytecodeInstructionCount = instructionCount;
+        header.nativeCodeSize = nativeCodeSize;
+
+        reader.read(nativeProto.get(), instructionCount * sizeof(uint32_t));
+
+        module.nativeProtos.push_back(std::move(nativeProto));
+    }
+
+    if (!reader.readBytes(module.data) || !reader.readBytes(module.code))
+        return std::nullopt;
+
+    for (const NativeProtoExecDataPtr& nativeProto : module.nativeProtos)
+    {
+        const NativeProtoExecDataHeader& header = getNativeProtoExecDataHeader(nativeProto.get());
+
+        if (uintptr_t(header.entryOffsetOrAddress) + header.nativeCodeSize > module.code.size())
+            return std::nullopt;
+    }
+
+    return module;
+}
+
+[[nodiscard]] static CompilationResult loadAotInternal(const std::optional<ModuleId>& moduleId, lua_State* L, int idx,
+    const CompilationOptions& options, const char* blob, size_t blobSize, CompilationStats* stats)
+{
+    CODEGEN_ASSERT(lua_isLfunction(L, idx));
+    const TValue* func = luaA_toobject(L, idx);
+
+    if ((options.flags & CodeGen_OnlyNativeModules) != 0 && (clvalue(func)->l.p->flags & LPF_NATIVE_MODULE) == 0)
+        return CompilationResult{CodeGenCompilationResult::NotNativeModule};
+
+    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
+    if (codeGenContext == nullptr)
+        return CompilationResult{CodeGenCompilationResult::CodeGenNotInitialized};
+
+    std::vector<Proto*> protos = gatherAotProtos(L, idx, options);
+
+    std::optional<AssembledModule> module = readAotModule(protos, options, blob, blobSize);
+    if (!module)
+        return CompilationResult{CodeGenCompilationResult::AotBlobMismatch};
+
+    std::vector<Proto*> unboundProtos;
+    if (!selectUnboundProtos(protos, module->nativeProtos, unboundProtos))
+        return CompilationResult{CodeGenCompilationResult::AotBlobMismatch};
+
+    if (unboundProtos.empty())
+        return CompilationResult{CodeGenCompilationResult::NothingToCompile};
+
+    if (stats != nullptr)
+        stats->functionsTotal = uint32_t(unboundProtos.size());
+
+    if (moduleId.has_value())
+    {
+        if (std::optional<ModuleBindResult> existingModuleBindResult = codeGenContext->tryBindExistingModule(*moduleId, unboundProtos))
+        {
+            if (stats != nullptr)
+                stats->functionsBound = existingModuleBindResult->functionsBound;
+
+            return CompilationResult{existingModuleBindResult->compilationResult};
+        }
+    }
+
+    return bindAssembledModule(moduleId, codeGenContext, unboundProtos, std::move(*module), stats);
+}
+
+static void onTierUp(lua_State* L, Proto* proto)
+{
+    // Function could have been compiled explicitly or have breakpoints set while it was running in the interpreter
+    if (proto->execdata != nullptr || proto->debuginsn != nullptr)
+        return;
+
+    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
+
+    // Tier-up is only requested once, so a function that fails to compile keeps running in the interpreter
+    (void)compileProtos({}, codeGenContext, {proto}, codeGenContext->tieringOptions, nullptr);
+}
+
 CompilationResult compile_NEW(const ModuleId& moduleId, lua_State* L, int idx, const CompilationOptions& options, CompilationStats* stats)
 {
     return compileInternal(moduleId, L, idx, options, stats);
@@ -585,6 +1039,22 @@ CompilationResult compile_NEW(lua_State* L, int idx, const CompilationOptions& o
     return compileInternal({}, L, idx, options, stats);
 }
 
+CompilationResult compileAot_NEW(lua_State* L, int idx, const CompilationOptions& options, std::string& blob)
+{
+    return compileAotInternal(L, idx, options, blob);
+}
+
+CompilationResult loadAot_NEW(lua_State* L, int idx, const CompilationOptions& options, const char* blob, size_t blobSize, CompilationStats* stats)
+{
+    return loadAotInternal({}, L, idx, options, blob, blobSize, stats);
+}
+
+CompilationResult loadAot_NEW(const ModuleId& moduleId, lua_State* L, int idx, const CompilationOptions& options, const char* blob, size_t blobSize,
+    CompilationStats* stats)
+{
+    return loadAotInternal(moduleId, L, idx, options, blob, blobSize, stats);
+}
+
 [[nodiscard]] bool isNativeExecutionEnabled_NEW(lua_State* L)
 {
     return getCodeGenContext(L) != nullptr && L->global->ecb.enter == onEnter;
@@ -596,5 +1066,332 @@ void setNativeExecutionEnabled_NEW(lua_State* L, bool enabled)
         L->global->ecb.enter = enabled ? onEnter : onEnterDisabled;
 }
 
+void setTiering_NEW(lua_State* L, const TieringOptions& options)
+{
+    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
+    if (codeGenContext == nullptr)
+        return;
+
+    codeGenContext->tieringOptions = options.compilationOptions;
+
+    L->global->tierupthreshold = int(std::min(options.threshold, unsigned(INT_MAX)));
+    L->global->ecb.tierup = options.threshold != 0 ? onTierUp : nullptr;
+    L->global->typefeedback = options.threshold != 0 && options.typeFeedback;
+}
+
+struct AsyncCompilation
+{
+    global_State* global = nullptr;
+
+    // Registry reference that keeps the functions alive until they are installed
+    int ref = LUA_NOREF;
+
+    std::vector<Proto*> protos;
+
+    // Copies of the functions that the worker thread assembles; the bytecode is copied as well since breakpoints patch it in place
+    // Type feedback is copied since the interpreter keeps updating it
+    std::vector<Proto> snapshots;
+    std::vector<std::vector<Instruction>> snapshotCode;
+    std::vector<std::vector<uint8_t>> snapshotTypeFeedback;
+
+    CompilationOptions options;
+
+    AssembledModule module;
+};
+
+AsyncCompiler::AsyncCompiler()
+    : worker([this] {
+        run();
+    })
+{
+}
+
+AsyncCompiler::~AsyncCompiler()
+{
+    {
+        std::unique_lock lock(mutex);
+        shutdown = true;
+    }
+
+    workAvailable.notify_one();
+    worker.join();
+}
+
+void AsyncCompiler::enqueue(std::unique_ptr<AsyncCompilation> compilation)
+{
+    {
+        std::unique_lock lock(mutex);
+        queue.push_back(std::move(compilation));
+    }
+
+    workAvailable.notify_one();
+}
+
+std::vector<std::unique_ptr<AsyncCompilation>> AsyncCompiler::takeFinished(global_State* global, bool wait)
+{
+    std::unique_lock lock(mutex);
+
+    if (wait)
+    {
+        workFinished.wait(lock, [&] {
+            return (active == nullptr || active->global != global) && std::none_of(queue.begin(), queue.end(), [&](auto& c) {
+                return c->global == global;
+            });
+        });
+    }
+
+    std::vector<std::unique_ptr<AsyncCompilation>> result;
+
+    auto it = std::stable_partition(finished.begin(), finished.end(), [&](auto& c) {
+        return c->global != global;
+    });
+
+    std::move(it, finished.end(), std::back_inserter(result));
+    finished.erase(it, finished.end());
+
+    return result;
+}
+
+void AsyncCompiler::cancel(global_State* global)
+{
+    std::unique_lock lock(mutex);
+
+    queue.erase(std::remove_if(queue.begin(), queue.end(),
+                    [&](auto& c) {
+                        return c->global == global;
+                    }),
+        queue.end());
+
+    workFinished.wait(lock, [&] {
+        return active == nullptr || active->global != global;
+    });
+
+    finished.erase(std::remove_if(finished.begin(), finished.end(),
+                       [&](auto& c) {
+                           return c->global == global;
+                       }),
+        finished.end());
+
+    hostInterrupts.erase(std::remove_if(hostInterrupts.begin(), hostInterrupts.end(),
+                             [&](auto& entry) {
+                                 return entry.first == global;
+                             }),
+        hostInterrupts.end());
+}
+
+bool AsyncCompiler::hasPending(global_State* global)
+{
+    std::unique_lock lock(mutex);
+
+    if (active != nullptr && active->global == global)
+        return true;
+
+    auto isOwned = [&](auto& c) {
+        return c->global == global;
+    };
+
+    return std::any_of(queue.begin(), queue.end(), isOwned) || std::any_of(finished.begin(), finished.end(), isOwned);
+}
+
+void AsyncCompiler::setHostInterrupt(global_State* global, InterruptFn interrupt)
+{
+    std::unique_lock lock(mutex);
+
+    for (auto& entry : hostInterrupts)
+    {
+        if (entry.first == global)
+        {
+            entry.second = interrupt;
+            return;
+        }
+    }
+
+    hostInterrupts.push_back({global, interrupt});
+}
+
+AsyncCompiler::InterruptFn AsyncCompiler::getHostInterrupt(global_State* global)
+{
+    std::unique_lock lock(mutex);
+
+    for (auto& entry : hostInterrupts)
+    {
+        if (entry.first == global)
+            return entry.second;
+    }
+
+    return nullptr;
+}
+
+void AsyncCompiler::removeHostInterrupt(global_State* global)
+{
+    std::unique_lock lock(mutex);
+
+    hostInterrupts.erase(std::remove_if(hostInterrupts.begin(), hostInterrupts.end(),
+                             [&](auto& entry) {
+                                 return entry.first == global;
+                             }),
+        hostInterrupts.end());
+}
+
+void AsyncCompiler::run()
+{
+    std::unique_lock lock(mutex);
+
+    for (;;)
+    {
+        workAvailable.wait(lock, [&] {
+            return shutdown || !queue.empty();
+        });
+
+        if (shutdown)
+            break;
+
+        std::unique_ptr<AsyncCompilation> compilation = std::move(queue.front());
+        queue.pop_front();
+
+        active = compilation.get();
+
+        lock.unlock();
+
+        std::vector<Proto*> snapshots;
+        snapshots.reserve(compilation->snapshots.size());
+
+        for (Proto& snapshot : compilation->snapshots)
+            snapshots.push_back(&snapshot);
+
+        compilation->module = assembleProtos(snapshots, compilation->options, nullptr);
+
+        lock.lock();
+
+        finished.push_back(std::move(compilation));
+        active = nullptr;
+
+        workFinished.notify_all();
+    }
+}
+
+// The context can be shared between VMs that request compilations concurrently
+[[nodiscard]] static AsyncCompiler* getAsyncCompiler(BaseCodeGenContext* codeGenContext, bool create)
+{
+    std::unique_lock lock(codeGenContext->asyncCompilerMutex);
+
+    if (create && codeGenContext->asyncCompiler == nullptr)
+        codeGenContext->asyncCompiler = std::make_unique<AsyncCompiler>();
+
+    return codeGenContext->asyncCompiler.get();
+}
+
+[[nodiscard]] static unsigned int installCompilation(lua_State* L, BaseCodeGenContext* codeGenContext, AsyncCompilation& compilation)
+{
+    std::vector<Proto*> protos;
+
+    bool matches = selectUnboundProtos(compilation.protos, compilation.module.nativeProtos, protos);
+    CODEGEN_ASSERT(matches);
+
+    CompilationStats stats;
+    (void)bindAssembledModule({}, codeGenContext, protos, std::move(compilation.module), &stats);
+
+    lua_unref(L, compilation.ref);
+
+    return stats.functionsBound;
+}
+
+static void onAsyncInterrupt(lua_State* L, int gc)
+{
+    AsyncCompiler* asyncCompiler = getAsyncCompiler(getCodeGenContext(L), /* create= */ false);
+    AsyncCompiler::InterruptFn hostInterrupt = asyncCompiler->getHostInterrupt(L->global);
+
+    // Interrupts during garbage collection steps are not safepoints for modifying the registry
+    if (gc < 0)
+    {
+        (void)installCompiledCode_NEW(L, /* wait= */ false);
+
+        if (!asyncCompiler->hasPending(L->global))
+        {
+            asyncCompiler->removeHostInterrupt(L->global);
+
+            if (L->global->cb.interrupt == onAsyncInterrupt)
+                L->global->cb.interrupt = hostInterrupt;
+        }
+    }
+
+    if (hostInterrupt)
+        hostInterrupt(L, gc);
+}
+
+static void onClosingState(lua_State* L) noexcept
+{
+    // The worker thread may still be reading the functions that are about to be freed
+    if (AsyncCompiler* asyncCompiler = getAsyncCompiler(getCodeGenContext(L), /* create= */ false))
+        asyncCompiler->cancel(L->global);
+}
+
+CodeGenCompilationResult compileAsync_NEW(lua_State* L, int idx, const CompilationOptions& options)
+{
+    std::vector<Proto*> protos;
+
+    if (CodeGenCompilationResult result = gatherProtosToCompile(L, idx, options, protos); result != CodeGenCompilationResult::Success)
+        return result;
+
+    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
+
+    std::unique_ptr<AsyncCompilation> compilation = std::make_unique<AsyncCompilation>();
+    compilation->global = L->global;
+    compilation->options = options;
+
+    compilation->snapshots.reserve(protos.size());
+    compilation->snapshotCode.reserve(protos.size());
+    compilation->snapshotTypeFeedback.reserve(protos.size());
+
+    for (Proto* proto : protos)
+    {
+        std::vector<Instruction>& code = compilation->snapshotCode.emplace_back(proto->code, proto->code + proto->sizecode);
+
+        Proto& snapshot = compilation->snapshots.emplace_back(*proto);
+        snapshot.code = code.data();
+
+        if (proto->typefeedback)
+        {
+            std::vector<uint8_t>& typefeedback =
+                compilation->snapshotTypeFeedback.emplace_back(proto->typefeedback, proto->typefeedback + proto->sizecode * 2);
+            snapshot.typefeedback = typefeedback.data();
+        }
+    }
+
+    compilation->protos = std::move(protos);
+
+    compilation->ref = lua_ref(L, idx);
+
+    AsyncCompiler* asyncCompiler = getAsyncCompiler(codeGenContext, /* create= */ true);
+
+    if (L->global->cb.interrupt != onAsyncInterrupt)
+    {
+        asyncCompiler->setHostInterrupt(L->global, L->global->cb.interrupt);
+        L->global->cb.interrupt = onAsyncInterrupt;
+    }
+
+    asyncCompiler->enqueue(std::move(compilation));
+
+    return CodeGenCompilationResult::Success;
+}
+
+unsigned int installCompiledCode_NEW(lua_State* L, bool wait)
+{
+    BaseCodeGenContext* codeGenContext = getCodeGenContext(L);
+    if (codeGenContext == nullptr)
+        return 0;
+
+    AsyncCompiler* asyncCompiler = getAsyncCompiler(codeGenContext, /* create= */ false);
+    if (asyncCompiler == nullptr)
+        return 0;
+
+    unsigned int functionsBound = 0;
+
+    for (std::unique_ptr<AsyncCompilation>& compilation : asyncCompiler->takeFinished(L->global, wait))
+        functionsBound += installCompilation(L, codeGenContext, *compilation);
+
+    return functionsBound;
+}
+
 } // namespace CodeGen
 } // namespace Luau
@@ -5,8 +5,12 @@
 
 #include "NativeState.h"
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
 #include <stdint.h>
 
 namespace Luau
@@ -28,6 +32,63 @@ struct ModuleBindResult
     uint32_t functionsBound = 0;
 };
 
+// Native code for a set of functions that hasn't been placed in executable memory yet
+struct AssembledModule
+{
+    CompilationResult compilationResult;
+
+    std::vector<NativeProtoExecDataPtr> nativeProtos;
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> code;
+};
+
+struct AsyncCompilation;
+
+// Assembles functions requested through compileAsync on a worker thread.  The
+// worker only reads snapshots of the functions; results are bound to the
+// functions on the thread that runs the VM which requested them.
+class AsyncCompiler
+{
+public:
+    using InterruptFn = void (*)(lua_State* L, int gc);
+
+    AsyncCompiler();
+    ~AsyncCompiler();
+
+    void enqueue(std::unique_ptr<AsyncCompilation> compilation);
+
+    // Removes compilations of the VM that have finished; if wait is set, waits for all of them to finish first
+    [[nodiscard]] std::vector<std::unique_ptr<AsyncCompilation>> takeFinished(global_State* global, bool wait);
+
+    // Removes all compilations of the VM, waiting for the one in progress to finish
+    void cancel(global_State* global);
+
+    [[nodiscard]] bool hasPending(global_State* global);
+
+    // Interrupt callback the VM had before compileAsync replaced it
+    void setHostInterrupt(global_State* global, InterruptFn interrupt);
+    [[nodiscard]] InterruptFn getHostInterrupt(global_State* global);
+    void removeHostInterrupt(global_State* global);
+
+private:
+    void run();
+
+    [[nodiscard]] bool isPendingLocked(global_State* global) const;
+
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workFinished;
+
+    std::deque<std::unique_ptr<AsyncCompilation>> queue;
+    std::vector<std::unique_ptr<AsyncCompilation>> finished;
+    AsyncCompilation* active = nullptr;
+    bool shutdown = false;
+
+    std::vector<std::pair<global_State*, InterruptFn>> hostInterrupts;
+
+    std::thread worker;
+};
+
 class BaseCodeGenContext
 {
 public:
@@ -51,6 +112,13 @@ public:
     size_t gateDataSize = 0;
 
     NativeContext context;
+
+    // Options used to compile functions that reach the tier-up threshold in the interpreter
+    CompilationOptions tieringOptions;
+
+    // Created on the first call to compileAsync
+    std::unique_ptr<AsyncCompiler> asyncCompiler;
+    std::mutex asyncCompilerMutex;
 };
 
 class StandaloneCodeGenContext final : public BaseCodeGenContext
@@ -110,11 +178,23 @@ void create_NEW(lua_State* L, SharedCodeGenContext* codeGenContext);
 CompilationResult compile_NEW(lua_State* L, int idx, const CompilationOptions& options, CompilationStats* stats);
 CompilationResult compile_NEW(const ModuleId& moduleId, lua_State* L, int idx, const CompilationOptions& options, CompilationStats* stats);
 
+CompilationResult compileAot_NEW(lua_State* L, int idx, const CompilationOptions& options, std::string& blob);
+CompilationResult loadAot_NEW(lua_State* L, int idx, const CompilationOptions& options, const char* blob, size_t blobSize, CompilationStats* stats);
+CompilationResult loadAot_NEW(const ModuleId& moduleId, lua_State* L, int idx, const CompilationOptions& options, const char* blob, size_t blobSize,
+    CompilationStats* stats);
+
 // Returns true if native execution is currently enabled for this VM
 [[nodiscard]] bool isNativeExecutionEnabled_NEW(lua_State* L);
 
 // Enables or disables native excution for this VM
 void setNativeExecutionEnabled_NEW(lua_State* L, bool enabled);
 
+// Enables or disables compilation of functions that become hot in the interpreter of this VM
+void setTiering_NEW(lua_State* L, const TieringOptions& options);
+
+// Queues compilation on a background thread; native code is installed at the next safepoint or by installCompiledCode_NEW
+CodeGenCompilationResult compileAsync_NEW(lua_State* L, int idx, const CompilationOptions& options);
+unsigned int installCompiledCode_NEW(lua_State* L, bool wait);
+
 } // namespace CodeGen
 } // namespace Luau
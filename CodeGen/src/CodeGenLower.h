@@ -10,6 +10,7 @@
 #include "Luau/OptimizeConstProp.h"
 #include "Luau/OptimizeDeadStore.h"
 #include "Luau/OptimizeFinalX64.h"
+#include "Luau/OptimizeLoops.h"
 
 #include "EmitCommon.h"
 #include "IrLoweringA64.h"
@@ -28,6 +29,7 @@ LUAU_FASTINT(CodegenHeuristicsInstructionLimit)
 LUAU_FASTINT(CodegenHeuristicsBlockLimit)
 LUAU_FASTINT(CodegenHeuristicsBlockInstructionLimit)
 LUAU_FASTFLAG(LuauCodegenRemoveDeadStores5)
+LUAU_FASTFLAG(LuauCodegenLoopVectorization)
 
 namespace Luau
 {
@@ -235,6 +237,7 @@ inline bool lowerIr(X64::AssemblyBuilderX64& build, IrBuilder& ir, const std::ve
     optimizeMemoryOperandsX64(ir.function);
 
     X64::IrLoweringX64 lowering(build, helpers, ir.function, stats);
+    lowering.regs.weightedSpills = (options.compilationOptions.flags & CodeGen_WeightedSpills) != 0;
 
     return lowerImpl(build, lowering, ir.function, sortedBlocks, proto->bytecodeid, options);
 }
@@ -314,6 +317,9 @@ inline bool lowerFunction(IrBuilder& ir, AssemblyBuilder& build, ModuleHelpers&
 
         if (FFlag::LuauCodegenRemoveDeadStores5)
             markDeadStoresInBlockChains(ir);
+
+        if (FFlag::LuauCodegenLoopVectorization && !FFlag::DebugCodegenOptSize)
+            vectorizeNumericLoops(ir);
     }
 
     std::vector<uint32_t> sortedBlocks = getSortedBlockOrder(ir.function);
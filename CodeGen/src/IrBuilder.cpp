@@ -398,12 +398,15 @@ void IrBuilder::translateInst(LuauOpcode op, const Instruction* pc, int i)
         inst(IrCmd::RETURN, vmReg(LUAU_INSN_A(*pc)), constInt(LUAU_INSN_B(*pc) - 1));
         break;
     case LOP_GETTABLE:
+    case LOP_GETTABLE_GETTABLE:
+    case LOP_GETTABLE_ADD:
         translateInstGetTable(*this, pc, i);
         break;
     case LOP_SETTABLE:
         translateInstSetTable(*this, pc, i);
         break;
     case LOP_GETTABLEKS:
+    case LOP_GETTABLEKS_GETTABLEKS:
         translateInstGetTableKS(*this, pc, i);
         break;
     case LOP_SETTABLEKS:
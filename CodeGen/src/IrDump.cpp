@@ -161,6 +161,30 @@ const char* getCmdName(IrCmd cmd)
         return "DIV_VEC";
     case IrCmd::UNM_VEC:
         return "UNM_VEC";
+    case IrCmd::ADD_NUM_X2:
+        return "ADD_NUM_X2";
+    case IrCmd::SUB_NUM_X2:
+        return "SUB_NUM_X2";
+    case IrCmd::MUL_NUM_X2:
+        return "MUL_NUM_X2";
+    case IrCmd::DIV_NUM_X2:
+        return "DIV_NUM_X2";
+    case IrCmd::MIN_NUM_X2:
+        return "MIN_NUM_X2";
+    case IrCmd::MAX_NUM_X2:
+        return "MAX_NUM_X2";
+    case IrCmd::UNM_NUM_X2:
+        return "UNM_NUM_X2";
+    case IrCmd::ABS_NUM_X2:
+        return "ABS_NUM_X2";
+    case IrCmd::SQRT_NUM_X2:
+        return "SQRT_NUM_X2";
+    case IrCmd::DUP_NUM_X2:
+        return "DUP_NUM_X2";
+    case IrCmd::PACK_NUM_X2:
+        return "PACK_NUM_X2";
+    case IrCmd::EXTRACT_NUM_X2:
+        return "EXTRACT_NUM_X2";
     case IrCmd::NOT_ANY:
         return "NOT_ANY";
     case IrCmd::CMP_ANY:
@@ -255,6 +279,8 @@ const char* getCmdName(IrCmd cmd)
         return "CHECK_NODE_VALUE";
     case IrCmd::CHECK_BUFFER_LEN:
         return "CHECK_BUFFER_LEN";
+    case IrCmd::CHECK_BUFFER_NO_ALIAS:
+        return "CHECK_BUFFER_NO_ALIAS";
     case IrCmd::INTERRUPT:
         return "INTERRUPT";
     case IrCmd::CHECK_GC:
@@ -363,6 +389,10 @@ const char* getCmdName(IrCmd cmd)
         return "BUFFER_READF64";
     case IrCmd::BUFFER_WRITEF64:
         return "BUFFER_WRITEF64";
+    case IrCmd::BUFFER_READ_X2:
+        return "BUFFER_READ_X2";
+    case IrCmd::BUFFER_WRITE_X2:
+        return "BUFFER_WRITE_X2";
     }
 
     LUAU_UNREACHABLE();
@@ -758,6 +758,98 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.fneg(inst.regA64, regOp(inst.a));
         break;
     }
+    case IrCmd::ADD_NUM_X2:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::q, index, {inst.a, inst.b});
+
+        build.fadd_2d(inst.regA64, regOp(inst.a), regOp(inst.b));
+        break;
+    }
+    case IrCmd::SUB_NUM_X2:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::q, index, {inst.a, inst.b});
+
+        build.fsub_2d(inst.regA64, regOp(inst.a), regOp(inst.b));
+        break;
+    }
+    case IrCmd::MUL_NUM_X2:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::q, index, {inst.a, inst.b});
+
+        build.fmul_2d(inst.regA64, regOp(inst.a), regOp(inst.b));
+        break;
+    }
+    case IrCmd::DIV_NUM_X2:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::q, index, {inst.a, inst.b});
+
+        build.fdiv_2d(inst.regA64, regOp(inst.a), regOp(inst.b));
+        break;
+    }
+    case IrCmd::MIN_NUM_X2:
+    {
+        // Selection mask is built in the result register, so it can't alias the sources
+        inst.regA64 = regs.allocReg(KindA64::q, index);
+
+        // Same as scalar MIN_NUM lowering, second operand is selected on NaN and equal values
+        build.fcmgt_2d(inst.regA64, regOp(inst.b), regOp(inst.a));
+        build.bsl_16b(inst.regA64, regOp(inst.a), regOp(inst.b));
+        break;
+    }
+    case IrCmd::MAX_NUM_X2:
+    {
+        inst.regA64 = regs.allocReg(KindA64::q, index);
+
+        build.fcmgt_2d(inst.regA64, regOp(inst.a), regOp(inst.b));
+        build.bsl_16b(inst.regA64, regOp(inst.a), regOp(inst.b));
+        break;
+    }
+    case IrCmd::UNM_NUM_X2:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::q, index, {inst.a});
+
+        build.fneg_2d(inst.regA64, regOp(inst.a));
+        break;
+    }
+    case IrCmd::ABS_NUM_X2:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::q, index, {inst.a});
+
+        build.fabs_2d(inst.regA64, regOp(inst.a));
+        break;
+    }
+    case IrCmd::SQRT_NUM_X2:
+    {
+        inst.regA64 = regs.allocReuse(KindA64::q, index, {inst.a});
+
+        build.fsqrt_2d(inst.regA64, regOp(inst.a));
+        break;
+    }
+    case IrCmd::DUP_NUM_X2:
+    {
+        inst.regA64 = regs.allocReg(KindA64::q, index);
+        RegisterA64 temp = tempDouble(inst.a);
+
+        build.dup_2d(inst.regA64, castReg(KindA64::q, temp), 0);
+        break;
+    }
+    case IrCmd::PACK_NUM_X2:
+    {
+        inst.regA64 = regs.allocReg(KindA64::q, index);
+        RegisterA64 temp1 = tempDouble(inst.a);
+        RegisterA64 temp2 = tempDouble(inst.b);
+
+        build.ins_2d(inst.regA64, 0, castReg(KindA64::q, temp1), 0);
+        build.ins_2d(inst.regA64, 1, castReg(KindA64::q, temp2), 0);
+        break;
+    }
+    case IrCmd::EXTRACT_NUM_X2:
+    {
+        inst.regA64 = regs.allocReg(KindA64::d, index);
+
+        build.dup_2d(inst.regA64, regOp(inst.a), uint8_t(intOp(inst.b)));
+        break;
+    }
     case IrCmd::NOT_ANY:
     {
         inst.regA64 = regs.allocReuse(KindA64::w, index, {inst.a, inst.b});
@@ -1638,6 +1730,14 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         finalizeTargetLabel(inst.d, fresh);
         break;
     }
+    case IrCmd::CHECK_BUFFER_NO_ALIAS:
+    {
+        Label fresh; // used when guard aborts execution or jumps to a VM exit
+        build.cmp(regOp(inst.a), regOp(inst.b));
+        build.b(ConditionA64::Equal, getTargetLabel(inst.c, fresh));
+        finalizeTargetLabel(inst.c, fresh);
+        break;
+    }
     case IrCmd::INTERRUPT:
     {
         regs.spill(build, index);
@@ -2378,6 +2478,109 @@ void IrLoweringA64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         break;
     }
 
+    case IrCmd::BUFFER_READ_X2:
+    {
+        inst.regA64 = regs.allocReg(KindA64::q, index);
+        AddressA64 addr1 = tempAddrBuffer(inst.a, inst.b);
+        AddressA64 addr2 = tempAddrBuffer(inst.a, inst.c);
+
+        switch (IrCmd(uintOp(inst.d)))
+        {
+        case IrCmd::BUFFER_READF64:
+        {
+            RegisterA64 temp = regs.allocTemp(KindA64::d);
+
+            build.ldr(castReg(KindA64::d, inst.regA64), addr1);
+            build.ldr(temp, addr2);
+            build.ins_2d(inst.regA64, 1, castReg(KindA64::q, temp), 0);
+            break;
+        }
+        case IrCmd::BUFFER_READF32:
+        {
+            RegisterA64 temp = regs.allocTemp(KindA64::s);
+
+            build.ldr(castReg(KindA64::s, inst.regA64), addr1);
+            build.ldr(temp, addr2);
+            build.ins_4s(inst.regA64, 1, castReg(KindA64::q, temp), 0);
+            build.fcvtl_2d(inst.regA64, inst.regA64);
+            break;
+        }
+        case IrCmd::BUFFER_READI8:
+        case IrCmd::BUFFER_READU8:
+        case IrCmd::BUFFER_READI16:
+        case IrCmd::BUFFER_READU16:
+        case IrCmd::BUFFER_READI32:
+        {
+            RegisterA64 temp = regs.allocTemp(KindA64::w);
+
+            // Values are extended to 32 bits one at a time, both lanes are then widened and converted together
+            for (int lane = 0; lane < 2; lane++)
+            {
+                AddressA64 addr = lane == 0 ? addr1 : addr2;
+
+                switch (IrCmd(uintOp(inst.d)))
+                {
+                case IrCmd::BUFFER_READI8:
+                    build.ldrsb(temp, addr);
+                    break;
+                case IrCmd::BUFFER_READU8:
+                    build.ldrb(temp, addr);
+                    break;
+                case IrCmd::BUFFER_READI16:
+                    build.ldrsh(temp, addr);
+                    break;
+                case IrCmd::BUFFER_READU16:
+                    build.ldrh(temp, addr);
+                    break;
+                default:
+                    build.ldr(temp, addr);
+                    break;
+                }
+
+                build.ins_4s(inst.regA64, temp, uint8_t(lane));
+            }
+
+            build.sxtl_2d(inst.regA64, inst.regA64);
+            build.scvtf_2d(inst.regA64, inst.regA64);
+            break;
+        }
+        default:
+            CODEGEN_ASSERT(!"Unsupported instruction form");
+            break;
+        }
+        break;
+    }
+
+    case IrCmd::BUFFER_WRITE_X2:
+    {
+        AddressA64 addr1 = tempAddrBuffer(inst.a, inst.b);
+        AddressA64 addr2 = tempAddrBuffer(inst.a, inst.c);
+
+        if (IrCmd(uintOp(inst.e)) == IrCmd::BUFFER_WRITEF64)
+        {
+            RegisterA64 temp = regs.allocTemp(KindA64::d);
+
+            build.str(castReg(KindA64::d, regOp(inst.d)), addr1);
+            build.dup_2d(temp, regOp(inst.d), 1);
+            build.str(temp, addr2);
+        }
+        else if (IrCmd(uintOp(inst.e)) == IrCmd::BUFFER_WRITEF32)
+        {
+            RegisterA64 temp1 = regs.allocTemp(KindA64::q);
+            RegisterA64 temp2 = regs.allocTemp(KindA64::s);
+
+            build.fcvtn_2s(temp1, regOp(inst.d));
+            build.str(castReg(KindA64::s, temp1), addr1);
+            build.dup_4s(temp2, temp1, 1);
+            build.str(temp2, addr2);
+        }
+        else
+        {
+            CODEGEN_ASSERT(!"Unsupported instruction form");
+        }
+        break;
+    }
+
         // To handle unsupported instructions, add "case IrCmd::OP" and make sure to set error = true!
     }
 
@@ -645,6 +645,100 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         build.vxorpd(inst.regX64, regOp(inst.a), build.f32x4(-0.0, -0.0, -0.0, -0.0));
         break;
     }
+    case IrCmd::ADD_NUM_X2:
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a, inst.b});
+
+        build.vaddpd(inst.regX64, regOp(inst.a), regOp(inst.b));
+        break;
+    case IrCmd::SUB_NUM_X2:
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a, inst.b});
+
+        build.vsubpd(inst.regX64, regOp(inst.a), regOp(inst.b));
+        break;
+    case IrCmd::MUL_NUM_X2:
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a, inst.b});
+
+        build.vmulpd(inst.regX64, regOp(inst.a), regOp(inst.b));
+        break;
+    case IrCmd::DIV_NUM_X2:
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a, inst.b});
+
+        build.vdivpd(inst.regX64, regOp(inst.a), regOp(inst.b));
+        break;
+    case IrCmd::MIN_NUM_X2:
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a, inst.b});
+
+        // Packed instruction picks the second operand on NaN and equal values, same as scalar MIN_NUM lowering
+        build.vminpd(inst.regX64, regOp(inst.a), regOp(inst.b));
+        break;
+    case IrCmd::MAX_NUM_X2:
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a, inst.b});
+
+        build.vmaxpd(inst.regX64, regOp(inst.a), regOp(inst.b));
+        break;
+    case IrCmd::UNM_NUM_X2:
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a});
+
+        build.vxorpd(inst.regX64, regOp(inst.a), build.f64x2(-0.0, -0.0));
+        break;
+    case IrCmd::ABS_NUM_X2:
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a});
+
+        build.vandpd(inst.regX64, regOp(inst.a), build.u32x4(~0u, ~0u >> 1, ~0u, ~0u >> 1));
+        break;
+    case IrCmd::SQRT_NUM_X2:
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a});
+
+        build.vsqrtpd(inst.regX64, regOp(inst.a));
+        break;
+    case IrCmd::DUP_NUM_X2:
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a});
+
+        build.vmovddup(inst.regX64, memRegDoubleOp(inst.a));
+        break;
+    case IrCmd::PACK_NUM_X2:
+    {
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a, inst.b});
+
+        ScopedRegX64 tmp{regs};
+        RegisterX64 lhs = noreg;
+
+        if (inst.a.kind == IrOpKind::Inst)
+        {
+            lhs = regOp(inst.a);
+        }
+        else
+        {
+            tmp.alloc(SizeX64::xmmword);
+            build.vmovsd(tmp.reg, memRegDoubleOp(inst.a));
+            lhs = tmp.reg;
+        }
+
+        if (inst.b.kind == IrOpKind::Inst)
+        {
+            build.vunpcklpd(inst.regX64, lhs, regOp(inst.b));
+        }
+        else
+        {
+            // Second lane is loaded from memory, first lane is kept
+            build.vmovhpd(inst.regX64, lhs, memRegDoubleOp(inst.b));
+        }
+        break;
+    }
+    case IrCmd::EXTRACT_NUM_X2:
+        inst.regX64 = regs.allocRegOrReuse(SizeX64::xmmword, index, {inst.a});
+
+        if (intOp(inst.b) == 0)
+        {
+            if (inst.regX64 != regOp(inst.a))
+                build.vmovsd(inst.regX64, regOp(inst.a), regOp(inst.a));
+        }
+        else
+        {
+            CODEGEN_ASSERT(intOp(inst.b) == 1);
+            build.vunpckhpd(inst.regX64, regOp(inst.a), regOp(inst.a));
+        }
+        break;
     case IrCmd::NOT_ANY:
     {
         // TODO: if we have a single user which is a STORE_INT, we are missing the opportunity to write directly to target
@@ -1350,6 +1444,11 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         }
         break;
     }
+    case IrCmd::CHECK_BUFFER_NO_ALIAS:
+        build.cmp(regOp(inst.a), regOp(inst.b));
+
+        jumpOrAbortOnUndef(ConditionX64::Equal, inst.c, next);
+        break;
     case IrCmd::INTERRUPT:
     {
         unsigned pcpos = uintOp(inst.a);
@@ -1979,6 +2078,87 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
         }
         break;
 
+    case IrCmd::BUFFER_READ_X2:
+    {
+        inst.regX64 = regs.allocReg(SizeX64::xmmword, index);
+
+        switch (IrCmd(uintOp(inst.d)))
+        {
+        case IrCmd::BUFFER_READF64:
+            build.vmovsd(inst.regX64, qword[bufferAddrOp(inst.a, inst.b)]);
+            build.vmovhpd(inst.regX64, inst.regX64, qword[bufferAddrOp(inst.a, inst.c)]);
+            break;
+        case IrCmd::BUFFER_READF32:
+            build.vmovss(inst.regX64, dword[bufferAddrOp(inst.a, inst.b)]);
+            build.vinsertps(inst.regX64, inst.regX64, dword[bufferAddrOp(inst.a, inst.c)], 0x10);
+            build.vcvtps2pd(inst.regX64, inst.regX64);
+            break;
+        case IrCmd::BUFFER_READI32:
+            build.vpinsrd(inst.regX64, inst.regX64, dword[bufferAddrOp(inst.a, inst.b)], 0);
+            build.vpinsrd(inst.regX64, inst.regX64, dword[bufferAddrOp(inst.a, inst.c)], 1);
+            build.vcvtdq2pd(inst.regX64, inst.regX64);
+            break;
+        case IrCmd::BUFFER_READI8:
+        case IrCmd::BUFFER_READU8:
+        case IrCmd::BUFFER_READI16:
+        case IrCmd::BUFFER_READU16:
+        {
+            ScopedRegX64 tmp{regs, SizeX64::dword};
+
+            // Values are extended to 32 bits one at a time, both lanes are then converted together
+            for (int lane = 0; lane < 2; lane++)
+            {
+                IrOp offset = lane == 0 ? inst.b : inst.c;
+
+                switch (IrCmd(uintOp(inst.d)))
+                {
+                case IrCmd::BUFFER_READI8:
+                    build.movsx(tmp.reg, byte[bufferAddrOp(inst.a, offset)]);
+                    break;
+                case IrCmd::BUFFER_READU8:
+                    build.movzx(tmp.reg, byte[bufferAddrOp(inst.a, offset)]);
+                    break;
+                case IrCmd::BUFFER_READI16:
+                    build.movsx(tmp.reg, word[bufferAddrOp(inst.a, offset)]);
+                    break;
+                default:
+                    build.movzx(tmp.reg, word[bufferAddrOp(inst.a, offset)]);
+                    break;
+                }
+
+                build.vpinsrd(inst.regX64, inst.regX64, tmp.reg, uint8_t(lane));
+            }
+
+            build.vcvtdq2pd(inst.regX64, inst.regX64);
+            break;
+        }
+        default:
+            CODEGEN_ASSERT(!"Unsupported instruction form");
+            break;
+        }
+        break;
+    }
+
+    case IrCmd::BUFFER_WRITE_X2:
+        if (IrCmd(uintOp(inst.e)) == IrCmd::BUFFER_WRITEF64)
+        {
+            build.vmovsd(qword[bufferAddrOp(inst.a, inst.b)], regOp(inst.d));
+            build.vmovhpd(qword[bufferAddrOp(inst.a, inst.c)], regOp(inst.d));
+        }
+        else if (IrCmd(uintOp(inst.e)) == IrCmd::BUFFER_WRITEF32)
+        {
+            ScopedRegX64 tmp{regs, SizeX64::xmmword};
+
+            build.vcvtpd2ps(tmp.reg, regOp(inst.d));
+            build.vmovss(dword[bufferAddrOp(inst.a, inst.b)], tmp.reg);
+            build.vextractps(dword[bufferAddrOp(inst.a, inst.c)], tmp.reg, 1);
+        }
+        else
+        {
+            CODEGEN_ASSERT(!"Unsupported instruction form");
+        }
+        break;
+
     // Pseudo instructions
     case IrCmd::NOP:
     case IrCmd::SUBSTITUTE:
@@ -1993,6 +2173,9 @@ void IrLoweringX64::lowerInst(IrInst& inst, uint32_t index, const IrBlock& next)
 
 void IrLoweringX64::finishBlock(const IrBlock& curr, const IrBlock& next)
 {
+    // Stack copies of values are only tracked within a block, the next one might be reached from a path where they weren't written
+    regs.releaseCleanSpills();
+
     if (!regs.spills.empty())
     {
         // If we have spills remaining, we have to immediately lower the successor block
@@ -87,6 +87,9 @@ RegisterX64 IrRegAllocX64::allocRegOrReuse(SizeX64 size, uint32_t instIdx, std::
 
             source.reusedReg = true;
 
+            if (weightedSpills)
+                releaseCleanSpill(op.index);
+
             if (size == SizeX64::xmmword)
                 xmmInstUsers[source.regX64.index] = instIdx;
             else
@@ -159,6 +162,9 @@ void IrRegAllocX64::freeLastUseReg(IrInst& target, uint32_t instIdx)
     {
         CODEGEN_ASSERT(!target.spilled && !target.needsReload);
 
+        if (weightedSpills)
+            releaseCleanSpill(function.getInstIndex(target));
+
         // Register might have already been freed if it had multiple uses inside a single instruction
         if (target.regX64 == noreg)
             return;
@@ -199,37 +205,48 @@ void IrRegAllocX64::preserve(IrInst& inst)
     // Loads from VmReg/VmConst don't have to be spilled, they can be restored from a register later
     if (!hasRestoreOp(inst))
     {
-        unsigned i = findSpillStackSlot(spill.valueKind);
-
-        if (spill.valueKind == IrValueKind::Tvalue)
-            build.vmovups(xmmword[sSpillArea + i * 8], inst.regX64);
-        else if (spill.valueKind == IrValueKind::Double)
-            build.vmovsd(qword[sSpillArea + i * 8], inst.regX64);
-        else if (spill.valueKind == IrValueKind::Pointer)
-            build.mov(qword[sSpillArea + i * 8], inst.regX64);
-        else if (spill.valueKind == IrValueKind::Tag || spill.valueKind == IrValueKind::Int)
-            build.mov(dword[sSpillArea + i * 8], inst.regX64);
+        IrSpillX64 clean;
+
+        // Stack slot still holds the value from an earlier spill
+        if (weightedSpills && takeCleanSpill(spill.instIdx, clean))
+        {
+            spill.stackSlot = clean.stackSlot;
+        }
         else
-            CODEGEN_ASSERT(!"Unsupported value kind");
+        {
+            unsigned i = findSpillStackSlot(spill.valueKind);
 
-        usedSpillSlots.set(i);
+            if (spill.valueKind == IrValueKind::Tvalue)
+                build.vmovups(xmmword[sSpillArea + i * 8], inst.regX64);
+            else if (spill.valueKind == IrValueKind::Double)
+                build.vmovsd(qword[sSpillArea + i * 8], inst.regX64);
+            else if (spill.valueKind == IrValueKind::Pointer)
+                build.mov(qword[sSpillArea + i * 8], inst.regX64);
+            else if (spill.valueKind == IrValueKind::Tag || spill.valueKind == IrValueKind::Int)
+                build.mov(dword[sSpillArea + i * 8], inst.regX64);
+            else
+                CODEGEN_ASSERT(!"Unsupported value kind");
 
-        if (i + 1 > maxUsedSlot)
-            maxUsedSlot = i + 1;
+            usedSpillSlots.set(i);
 
-        if (spill.valueKind == IrValueKind::Tvalue)
-        {
-            usedSpillSlots.set(i + 1);
+            if (i + 1 > maxUsedSlot)
+                maxUsedSlot = i + 1;
+
+            if (spill.valueKind == IrValueKind::Tvalue)
+            {
+                usedSpillSlots.set(i + 1);
 
-            if (i + 2 > maxUsedSlot)
-                maxUsedSlot = i + 2;
+                if (i + 2 > maxUsedSlot)
+                    maxUsedSlot = i + 2;
+            }
+
+            spill.stackSlot = uint8_t(i);
+
+            if (stats)
+                stats->spillsToSlot++;
         }
 
-        spill.stackSlot = uint8_t(i);
         inst.spilled = true;
-
-        if (stats)
-            stats->spillsToSlot++;
     }
     else
     {
@@ -264,10 +281,10 @@ void IrRegAllocX64::restore(IrInst& inst, bool intoOriginalLocation)
                 restoreLocation = addr[sSpillArea + spill.stackSlot * 8];
                 restoreLocation.memSize = reg.size;
 
-                usedSpillSlots.set(spill.stackSlot, false);
-
-                if (spill.valueKind == IrValueKind::Tvalue)
-                    usedSpillSlots.set(spill.stackSlot + 1, false);
+                if (weightedSpills)
+                    cleanSpills.push_back(spill);
+                else
+                    freeSpillStackSlot(spill);
             }
             else
             {
@@ -337,6 +354,13 @@ unsigned IrRegAllocX64::findSpillStackSlot(IrValueKind valueKind)
             continue;
         }
 
+        // Stack copies of values in registers are only an optimization, so they are dropped before running out of slots
+        if (i + (valueKind == IrValueKind::Tvalue ? 2 : 1) > kSpillSlots && !cleanSpills.empty())
+        {
+            releaseCleanSpills();
+            return findSpillStackSlot(valueKind);
+        }
+
         return i;
     }
 
@@ -344,6 +368,74 @@ unsigned IrRegAllocX64::findSpillStackSlot(IrValueKind valueKind)
     return ~0u;
 }
 
+void IrRegAllocX64::freeSpillStackSlot(const IrSpillX64& spill)
+{
+    usedSpillSlots.set(spill.stackSlot, false);
+
+    if (spill.valueKind == IrValueKind::Tvalue)
+        usedSpillSlots.set(spill.stackSlot + 1, false);
+}
+
+unsigned IrRegAllocX64::getSpillCost(const IrInst& inst) const
+{
+    // Values that are restored from VM registers or from a stack copy only need a reload, others need a store as well
+    if (hasRestoreOp(inst))
+        return 1;
+
+    uint32_t instIdx = function.getInstIndex(inst);
+
+    for (const IrSpillX64& clean : cleanSpills)
+    {
+        if (clean.instIdx == instIdx)
+            return 1;
+    }
+
+    return 2;
+}
+
+bool IrRegAllocX64::takeCleanSpill(uint32_t instIdx, IrSpillX64& spill)
+{
+    for (size_t i = 0; i < cleanSpills.size(); i++)
+    {
+        if (cleanSpills[i].instIdx == instIdx)
+        {
+            spill = cleanSpills[i];
+
+            cleanSpills[i] = cleanSpills.back();
+            cleanSpills.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void IrRegAllocX64::releaseCleanSpill(uint32_t instIdx)
+{
+    IrSpillX64 clean;
+
+    if (takeCleanSpill(instIdx, clean))
+        freeSpillStackSlot(clean);
+}
+
+void IrRegAllocX64::releaseCleanSpills(unsigned startSpillId)
+{
+    for (size_t i = 0; i < cleanSpills.size();)
+    {
+        if (cleanSpills[i].spillId >= startSpillId)
+        {
+            freeSpillStackSlot(cleanSpills[i]);
+
+            cleanSpills[i] = cleanSpills.back();
+            cleanSpills.pop_back();
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
 IrOp IrRegAllocX64::getRestoreOp(const IrInst& inst) const
 {
     // When restoring the value, we allow cross-block restore because we have commited to the target location at spill time
@@ -393,6 +485,7 @@ uint32_t IrRegAllocX64::findInstructionWithFurthestNextUse(const std::array<uint
 {
     uint32_t furthestUseTarget = kInvalidInstIdx;
     uint32_t furthestUseLocation = 0;
+    unsigned furthestUseCost = 1;
 
     for (uint32_t regInstUser : regInstUsers)
     {
@@ -406,7 +499,20 @@ uint32_t IrRegAllocX64::findInstructionWithFurthestNextUse(const std::array<uint
         if (nextUse == currInstIdx)
             continue;
 
-        if (furthestUseTarget == kInvalidInstIdx || nextUse > furthestUseLocation)
+        if (weightedSpills)
+        {
+            // Value with the largest distance to the next use per unit of spill cost is the cheapest one to spill
+            unsigned cost = getSpillCost(function.instructions[regInstUser]);
+
+            if (furthestUseTarget == kInvalidInstIdx ||
+                uint64_t(nextUse - currInstIdx) * furthestUseCost > uint64_t(furthestUseLocation - currInstIdx) * cost)
+            {
+                furthestUseLocation = nextUse;
+                furthestUseTarget = regInstUser;
+                furthestUseCost = cost;
+            }
+        }
+        else if (furthestUseTarget == kInvalidInstIdx || nextUse > furthestUseLocation)
         {
             furthestUseLocation = nextUse;
             furthestUseTarget = regInstUser;
@@ -520,6 +626,9 @@ ScopedSpills::~ScopedSpills()
             i++;
         }
     }
+
+    // Stack copies made inside this scope might have been written on a conditional path only
+    owner.releaseCleanSpills(startSpillId);
 }
 
 } // namespace X64
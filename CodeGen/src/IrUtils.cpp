@@ -73,7 +73,20 @@ IrValueKind getCmdValueKind(IrCmd cmd)
     case IrCmd::MUL_VEC:
     case IrCmd::DIV_VEC:
     case IrCmd::UNM_VEC:
+    case IrCmd::ADD_NUM_X2:
+    case IrCmd::SUB_NUM_X2:
+    case IrCmd::MUL_NUM_X2:
+    case IrCmd::DIV_NUM_X2:
+    case IrCmd::MIN_NUM_X2:
+    case IrCmd::MAX_NUM_X2:
+    case IrCmd::UNM_NUM_X2:
+    case IrCmd::ABS_NUM_X2:
+    case IrCmd::SQRT_NUM_X2:
+    case IrCmd::DUP_NUM_X2:
+    case IrCmd::PACK_NUM_X2:
         return IrValueKind::Tvalue;
+    case IrCmd::EXTRACT_NUM_X2:
+        return IrValueKind::Double;
     case IrCmd::NOT_ANY:
     case IrCmd::CMP_ANY:
         return IrValueKind::Int;
@@ -135,6 +148,7 @@ IrValueKind getCmdValueKind(IrCmd cmd)
     case IrCmd::CHECK_NODE_NO_NEXT:
     case IrCmd::CHECK_NODE_VALUE:
     case IrCmd::CHECK_BUFFER_LEN:
+    case IrCmd::CHECK_BUFFER_NO_ALIAS:
     case IrCmd::INTERRUPT:
     case IrCmd::CHECK_GC:
     case IrCmd::BARRIER_OBJ:
@@ -196,10 +210,13 @@ IrValueKind getCmdValueKind(IrCmd cmd)
     case IrCmd::BUFFER_WRITEI32:
     case IrCmd::BUFFER_WRITEF32:
     case IrCmd::BUFFER_WRITEF64:
+    case IrCmd::BUFFER_WRITE_X2:
         return IrValueKind::None;
     case IrCmd::BUFFER_READF32:
     case IrCmd::BUFFER_READF64:
         return IrValueKind::Double;
+    case IrCmd::BUFFER_READ_X2:
+        return IrValueKind::Tvalue;
     }
 
     LUAU_UNREACHABLE();
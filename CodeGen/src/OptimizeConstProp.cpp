@@ -1043,6 +1043,8 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
     case IrCmd::BUFFER_WRITEF32:
     case IrCmd::BUFFER_READF64:
     case IrCmd::BUFFER_WRITEF64:
+    case IrCmd::BUFFER_READ_X2:
+    case IrCmd::BUFFER_WRITE_X2:
         break;
     case IrCmd::CHECK_GC:
         // It is enough to perform a GC check once in a block
@@ -1310,6 +1312,19 @@ static void constPropInInst(ConstPropState& state, IrBuilder& build, IrFunction&
 
     case IrCmd::CHECK_NODE_NO_NEXT:
     case IrCmd::CHECK_NODE_VALUE:
+    case IrCmd::CHECK_BUFFER_NO_ALIAS:
+    case IrCmd::ADD_NUM_X2:
+    case IrCmd::SUB_NUM_X2:
+    case IrCmd::MUL_NUM_X2:
+    case IrCmd::DIV_NUM_X2:
+    case IrCmd::MIN_NUM_X2:
+    case IrCmd::MAX_NUM_X2:
+    case IrCmd::UNM_NUM_X2:
+    case IrCmd::ABS_NUM_X2:
+    case IrCmd::SQRT_NUM_X2:
+    case IrCmd::DUP_NUM_X2:
+    case IrCmd::PACK_NUM_X2:
+    case IrCmd::EXTRACT_NUM_X2:
     case IrCmd::BARRIER_TABLE_BACK:
     case IrCmd::RETURN:
     case IrCmd::COVERAGE:
@@ -595,6 +595,9 @@ static void markDeadStoresInInst(RemoveDeadStoreState& state, IrBuilder& build,
     case IrCmd::CHECK_BUFFER_LEN:
         state.checkLiveIns(inst.d);
         break;
+    case IrCmd::CHECK_BUFFER_NO_ALIAS:
+        state.checkLiveIns(inst.c);
+        break;
 
     case IrCmd::JUMP:
         // Ideally, we would be able to remove stores to registers that are not live out from a block
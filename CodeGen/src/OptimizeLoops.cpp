@@ -0,0 +1,1714 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "Luau/OptimizeLoops.h"
+
+#include "Luau/IrAnalysis.h"
+#include "Luau/IrBuilder.h"
+#include "Luau/IrUtils.h"
+
+#include <bitset>
+#include <limits.h>
+
+#include "lobject.h"
+
+LUAU_FASTINTVARIABLE(LuauCodeGenLoopVectorizationInstLimit, 256)
+LUAU_FASTFLAGVARIABLE(LuauCodegenLoopVectorization, false)
+
+// Only the buffer loop vectorizer is implemented here. Hoisting loop-invariant guards into a preheader was tried as loop versioning,
+// since IR values can't flow across back edges: a preheader ran the guards once and entered a copy of the body without them.
+// It gave no measurable win. The loops it accepted are dominated by VM register loads and stores, the removed guards are well
+// predicted, and loops that call out (sieve) or are written with while (qsort) were not accepted at all. Interrupts also had to
+// be guarded in the copy, because handlers can modify tables and the environment.
+namespace Luau
+{
+namespace CodeGen
+{
+
+struct NumericLoop
+{
+    uint32_t header = ~0u;
+    uint32_t latch = ~0u;
+
+    // Induction variable is only tracked for loops with a positive constant integer step
+    int indexReg = -1;
+    uint32_t indexStore = ~0u;
+    IrOp limit;
+
+    std::vector<uint8_t> inLoop;
+
+    // Non-fallback blocks of the loop in their lowering order
+    std::vector<uint32_t> blocks;
+};
+
+template<typename F>
+static void visitBlockTargets(IrInst& inst, F&& f)
+{
+    for (IrOp* op : {&inst.a, &inst.b, &inst.c, &inst.d, &inst.e, &inst.f})
+    {
+        if (op->kind == IrOpKind::Block)
+            f(*op);
+    }
+}
+
+static std::vector<std::vector<uint32_t>> computePredecessors(IrFunction& function)
+{
+    std::vector<std::vector<uint32_t>> predecessors(function.blocks.size());
+
+    for (size_t blockIdx = 0; blockIdx < function.blocks.size(); blockIdx++)
+    {
+        const IrBlock& block = function.blocks[blockIdx];
+
+        if (block.kind == IrBlockKind::Dead)
+            continue;
+
+        for (uint32_t index = block.start; index <= block.finish; index++)
+        {
+            visitBlockTargets(function.instructions[index], [&](IrOp& op) {
+                std::vector<uint32_t>& list = predecessors[op.index];
+
+                if (list.empty() || list.back() != blockIdx)
+                    list.push_back(uint32_t(blockIdx));
+            });
+        }
+    }
+
+    return predecessors;
+}
+
+static std::optional<int> getPositiveIntegerStep(IrFunction& function, IrOp op)
+{
+    if (op.kind != IrOpKind::Constant)
+        return std::nullopt;
+
+    double step = function.doubleOp(op);
+
+    if (step >= 1.0 && step <= double(INT_MAX) && double(int(step)) == step)
+        return int(step);
+
+    return std::nullopt;
+}
+
+// Loop latch is the block which ends with the numeric loop condition jumping back to the loop header
+static bool matchNumericLoopLatch(IrFunction& function, uint32_t blockIdx, NumericLoop& loop)
+{
+    IrBlock& block = function.blocks[blockIdx];
+    IrInst& term = function.instructions[block.finish];
+
+    if (term.cmd != IrCmd::JUMP_CMP_NUM && term.cmd != IrCmd::JUMP_FORN_LOOP_COND)
+        return false;
+
+    if (term.d.kind != IrOpKind::Block || term.e.kind != IrOpKind::Block || term.d.index == term.e.index)
+        return false;
+
+    // Header has to be placed before the latch, otherwise the jump is not a back edge
+    IrBlock& header = function.blockOp(term.d);
+
+    if (header.kind == IrBlockKind::Fallback || header.sortkey > block.sortkey || term.d.index == 0)
+        return false;
+
+    loop.header = term.d.index;
+    loop.latch = blockIdx;
+
+    // For 'idx <= limit' with a constant positive step we can compute the range of index values in the loop
+    if (term.cmd != IrCmd::JUMP_CMP_NUM || conditionOp(term.c) != IrCondition::LessEqual || term.a.kind != IrOpKind::Inst)
+        return true;
+
+    IrInst& increment = function.instOp(term.a);
+
+    if (increment.cmd != IrCmd::ADD_NUM || increment.a.kind != IrOpKind::Inst || !getPositiveIntegerStep(function, increment.b))
+        return true;
+
+    IrInst& index = function.instOp(increment.a);
+
+    if (index.cmd != IrCmd::LOAD_DOUBLE || index.a.kind != IrOpKind::VmReg)
+        return true;
+
+    if (term.b.kind != IrOpKind::Constant)
+    {
+        IrInst* limit = function.asInstOp(term.b);
+
+        if (!limit || limit->cmd != IrCmd::LOAD_DOUBLE || limit->a.kind != IrOpKind::VmReg)
+            return true;
+    }
+
+    for (uint32_t i = block.start; i < block.finish; i++)
+    {
+        IrInst& inst = function.instructions[i];
+
+        if (inst.cmd == IrCmd::STORE_DOUBLE && inst.a == index.a && inst.b == term.a)
+        {
+            loop.indexReg = vmRegOp(index.a);
+            loop.indexStore = i;
+            loop.limit = term.b.kind == IrOpKind::Constant ? term.b : function.instOp(term.b).a;
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool collectLoopBlocks(IrFunction& function, const std::vector<std::vector<uint32_t>>& predecessors, NumericLoop& loop)
+{
+    loop.inLoop.assign(function.blocks.size(), false);
+    loop.inLoop[loop.header] = true;
+
+    std::vector<uint32_t> worklist;
+
+    if (!loop.inLoop[loop.latch])
+    {
+        loop.inLoop[loop.latch] = true;
+        worklist.push_back(loop.latch);
+    }
+
+    while (!worklist.empty())
+    {
+        uint32_t blockIdx = worklist.back();
+        worklist.pop_back();
+
+        for (uint32_t pred : predecessors[blockIdx])
+        {
+            if (!loop.inLoop[pred])
+            {
+                loop.inLoop[pred] = true;
+                worklist.push_back(pred);
+            }
+        }
+    }
+
+    // Function entry can only be in the loop if the header doesn't dominate the latch
+    if (loop.inLoop[0])
+        return false;
+
+    // Loop has to be entered only through the header
+    for (size_t blockIdx = 0; blockIdx < function.blocks.size(); blockIdx++)
+    {
+        if (!loop.inLoop[blockIdx] || blockIdx == loop.header)
+            continue;
+
+        for (uint32_t pred : predecessors[blockIdx])
+        {
+            if (!loop.inLoop[pred])
+                return false;
+        }
+    }
+
+    for (uint32_t blockIdx : getSortedBlockOrder(function))
+    {
+        if (loop.inLoop[blockIdx] && function.blocks[blockIdx].kind != IrBlockKind::Fallback)
+            loop.blocks.push_back(blockIdx);
+    }
+
+    return true;
+}
+
+static bool isFirstInstruction(IrFunction& function, IrBlock& block, uint32_t index)
+{
+    for (uint32_t i = block.start; i < index; i++)
+    {
+        if (!isPseudo(function.instructions[i].cmd))
+            return false;
+    }
+
+    return true;
+}
+
+static IrOp emitInst(IrBuilder& build, IrCmd cmd, IrOp a, IrOp b = {}, IrOp c = {}, IrOp d = {}, IrOp e = {})
+{
+    addUse(build.function, a);
+    addUse(build.function, b);
+    addUse(build.function, c);
+    addUse(build.function, d);
+    addUse(build.function, e);
+
+    return build.inst(cmd, a, b, c, d, e);
+}
+
+// Loops over buffers with a unit step can be vectorized to perform two iterations at once:
+//
+//   entry: unit step, integer index and iteration count checks, failing to the original loop header
+//   body: guards of both iterations, then buffer accesses in their original order with arithmetic on pairs of doubles
+//   tail: remaining iteration is left to the original loop
+//
+// Every guard of the vectorized body is checked before the loop state is modified, so a failure can continue in the original loop header.
+// Each lane computes exactly the same operations as the scalar iteration, values carried between iterations are computed lane by lane.
+enum class LaneShape : uint8_t
+{
+    Uniform, // Same value in both iterations
+    PerLane, // Computed separately for each iteration
+    Packed,  // Computed for both iterations at once
+};
+
+struct LaneOperand
+{
+    enum Kind : uint8_t
+    {
+        Direct,  // Constant operand used as is
+        Node,    // Result of a loop instruction
+        Reg,     // Register which is not modified in the loop
+        Index,   // Loop index
+        Carried, // Register value from the previous iteration
+    };
+
+    Kind kind = Direct;
+    uint8_t reg = 0;
+    IrOp op;
+};
+
+enum class LaneRegKind : uint8_t
+{
+    Original, // State of the 'source' register at the start of the iteration
+    Value,    // Number value computed in the loop
+    Const,    // Known tag in 'source'
+    Upvalue,  // Upvalue with 'source' index
+    Unknown,
+};
+
+struct LaneRegState
+{
+    LaneRegKind valueKind = LaneRegKind::Original;
+    uint8_t valueSource = 0;
+    LaneOperand value;
+
+    LaneRegKind tagKind = LaneRegKind::Original;
+    uint8_t tagSource = 0;
+};
+
+struct LaneInfo
+{
+    LaneShape shape = LaneShape::Uniform;
+
+    // Value depends on the previous iteration
+    bool serial = false;
+
+    // Value depends on buffer contents
+    bool memory = false;
+
+    // Value is 'slope * index + base'
+    bool affine = false;
+    int64_t slope = 0;
+    int64_t base = 0;
+};
+
+enum class LaneNodeKind : uint8_t
+{
+    None,
+    Skip,
+    Alias,
+    TagRef,
+    TvalueRef,
+    Pointer,
+    Op,
+    Read,
+    Write,
+};
+
+struct LaneNode
+{
+    LaneNodeKind kind = LaneNodeKind::None;
+    LaneInfo info;
+
+    LaneOperand args[2];
+    LaneRegState ref;
+
+    uint8_t source = 0;
+    IrCmd accessCmd = IrCmd::NOP;
+
+    IrOp lanes[2];
+    IrOp packed;
+};
+
+struct LaneBufferSource
+{
+    bool upvalue = false;
+    uint8_t index = 0;
+    bool written = false;
+
+    IrOp pointer;
+};
+
+struct LaneTagGuard
+{
+    bool upvalue = false;
+    uint8_t index = 0;
+    uint8_t tag = 0;
+};
+
+struct LaneLenGuard
+{
+    uint8_t source = 0;
+    LaneOperand offset;
+    IrOp size;
+};
+
+struct LaneAccess
+{
+    uint32_t node = 0;
+    uint8_t source = 0;
+    int size = 0;
+};
+
+static bool isPackedLaneOp(IrCmd cmd)
+{
+    switch (cmd)
+    {
+    case IrCmd::ADD_NUM:
+    case IrCmd::SUB_NUM:
+    case IrCmd::MUL_NUM:
+    case IrCmd::DIV_NUM:
+    case IrCmd::MIN_NUM:
+    case IrCmd::MAX_NUM:
+    case IrCmd::UNM_NUM:
+    case IrCmd::ABS_NUM:
+    case IrCmd::SQRT_NUM:
+        return true;
+    default:
+        break;
+    }
+
+    return false;
+}
+
+static IrCmd getPackedLaneCmd(IrCmd cmd)
+{
+    switch (cmd)
+    {
+    case IrCmd::ADD_NUM:
+        return IrCmd::ADD_NUM_X2;
+    case IrCmd::SUB_NUM:
+        return IrCmd::SUB_NUM_X2;
+    case IrCmd::MUL_NUM:
+        return IrCmd::MUL_NUM_X2;
+    case IrCmd::DIV_NUM:
+        return IrCmd::DIV_NUM_X2;
+    case IrCmd::MIN_NUM:
+        return IrCmd::MIN_NUM_X2;
+    case IrCmd::MAX_NUM:
+        return IrCmd::MAX_NUM_X2;
+    case IrCmd::UNM_NUM:
+        return IrCmd::UNM_NUM_X2;
+    case IrCmd::ABS_NUM:
+        return IrCmd::ABS_NUM_X2;
+    case IrCmd::SQRT_NUM:
+        return IrCmd::SQRT_NUM_X2;
+    default:
+        CODEGEN_ASSERT(!"Unsupported lane instruction");
+    }
+
+    return IrCmd::NOP;
+}
+
+// Instructions which can be computed separately for each lane
+static bool isLaneOp(IrCmd cmd)
+{
+    switch (cmd)
+    {
+    case IrCmd::IDIV_NUM:
+    case IrCmd::MOD_NUM:
+    case IrCmd::FLOOR_NUM:
+    case IrCmd::CEIL_NUM:
+    case IrCmd::ROUND_NUM:
+    case IrCmd::ADD_INT:
+    case IrCmd::SUB_INT:
+    case IrCmd::INT_TO_NUM:
+    case IrCmd::UINT_TO_NUM:
+    case IrCmd::NUM_TO_INT:
+    case IrCmd::NUM_TO_UINT:
+    case IrCmd::BITAND_UINT:
+    case IrCmd::BITXOR_UINT:
+    case IrCmd::BITOR_UINT:
+    case IrCmd::BITNOT_UINT:
+    case IrCmd::BITLSHIFT_UINT:
+    case IrCmd::BITRSHIFT_UINT:
+    case IrCmd::BITARSHIFT_UINT:
+    case IrCmd::BITLROTATE_UINT:
+    case IrCmd::BITRROTATE_UINT:
+        return true;
+    default:
+        break;
+    }
+
+    return isPackedLaneOp(cmd);
+}
+
+static bool hasDoubleOperands(IrCmd cmd)
+{
+    switch (cmd)
+    {
+    case IrCmd::IDIV_NUM:
+    case IrCmd::MOD_NUM:
+    case IrCmd::FLOOR_NUM:
+    case IrCmd::CEIL_NUM:
+    case IrCmd::ROUND_NUM:
+    case IrCmd::NUM_TO_INT:
+    case IrCmd::NUM_TO_UINT:
+        return true;
+    default:
+        break;
+    }
+
+    return isPackedLaneOp(cmd);
+}
+
+static int getBufferAccessSize(IrCmd cmd)
+{
+    switch (cmd)
+    {
+    case IrCmd::BUFFER_READI8:
+    case IrCmd::BUFFER_READU8:
+    case IrCmd::BUFFER_WRITEI8:
+        return 1;
+    case IrCmd::BUFFER_READI16:
+    case IrCmd::BUFFER_READU16:
+    case IrCmd::BUFFER_WRITEI16:
+        return 2;
+    case IrCmd::BUFFER_READI32:
+    case IrCmd::BUFFER_WRITEI32:
+    case IrCmd::BUFFER_READF32:
+    case IrCmd::BUFFER_WRITEF32:
+        return 4;
+    case IrCmd::BUFFER_READF64:
+    case IrCmd::BUFFER_WRITEF64:
+        return 8;
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+static bool isBufferWrite(IrCmd cmd)
+{
+    return cmd == IrCmd::BUFFER_WRITEI8 || cmd == IrCmd::BUFFER_WRITEI16 || cmd == IrCmd::BUFFER_WRITEI32 || cmd == IrCmd::BUFFER_WRITEF32 ||
+           cmd == IrCmd::BUFFER_WRITEF64;
+}
+
+// Affine values are limited so that offset differences are computed exactly even when integer operations wrap around
+static bool setAffine(LaneInfo& info, int64_t slope, int64_t base)
+{
+    if (slope < -(1 << 16) || slope > (1 << 16) || base < -(1 << 24) || base > (1 << 24))
+        return false;
+
+    info.affine = true;
+    info.slope = slope;
+    info.base = base;
+    return true;
+}
+
+struct LoopVectorizer
+{
+    LoopVectorizer(IrBuilder& build)
+        : build(build)
+        , function(build.function)
+    {
+    }
+
+    IrBuilder& build;
+    IrFunction& function;
+
+    NumericLoop loop;
+    uint32_t exit = ~0u;
+    uint32_t increment = ~0u;
+    int stepReg = -1;
+
+    // Blocks of a single iteration in their execution order
+    std::vector<uint32_t> chain;
+
+    std::vector<LaneNode> nodes;
+    LaneRegState regs[256];
+
+    std::bitset<256> tagWritten;
+    std::bitset<256> valueWritten;
+    std::bitset<256> readOriginal;
+    std::bitset<256> carried;
+
+    IrOp interrupt;
+    bool safeEnv = false;
+
+    std::vector<LaneBufferSource> sources;
+    std::vector<LaneTagGuard> tagGuards;
+    std::vector<std::pair<uint8_t, uint8_t>> tagChecks;
+    std::vector<LaneLenGuard> lenGuards;
+    std::vector<LaneAccess> accesses;
+    std::vector<std::pair<uint8_t, uint8_t>> distinctSources;
+    std::vector<uint8_t> liveOut;
+
+    // Upvalue buffers are loaded into the register used by the first upvalue load in the loop
+    int upvalueTemp[256];
+
+    IrOp fallback;
+    IrOp regLoads[256];
+    IrOp indexNext;
+    std::vector<std::pair<IrOp, IrOp>> packedOperands;
+
+    bool matchLoop(uint32_t latch);
+    bool analyze();
+    bool analyzeInst(uint32_t blockIdx, uint32_t index);
+    bool checkLoop();
+    void emit(const std::vector<uint32_t>& headerPredecessors);
+
+    IrOp skipSubstitutes(IrOp op);
+    bool readValue(const LaneRegState& state, LaneOperand& result);
+    bool resolveOperand(IrOp op, bool allowReg, LaneOperand& result);
+    LaneInfo getInfo(const LaneOperand& op);
+    bool isAddress(const LaneOperand& op);
+    bool addTagGuard(IrOp op, uint8_t tag);
+    void addTagGuard(const LaneTagGuard& guard);
+    int addPointerSource(IrOp op);
+    int getPointerSource(IrOp op);
+    bool writeReg(IrOp op);
+    bool analyzeOp(IrInst& inst, LaneNode& node);
+
+    IrOp emitInst(IrCmd cmd, IrOp a, IrOp b = {}, IrOp c = {}, IrOp d = {}, IrOp e = {})
+    {
+        return ::Luau::CodeGen::emitInst(build, cmd, a, b, c, d, e);
+    }
+
+    IrOp loadLimit();
+    IrOp loadReg(uint8_t reg);
+    IrOp getSourcePointer(uint8_t source);
+    IrOp getLane(const LaneOperand& op, int lane);
+    IrOp getNodeLane(uint32_t index, int lane);
+    IrOp getPacked(const LaneOperand& op);
+    IrOp getNodePacked(uint32_t index);
+};
+
+bool LoopVectorizer::matchLoop(uint32_t latch)
+{
+    if (!matchNumericLoopLatch(function, latch, loop))
+        return false;
+
+    IrInst& term = function.instructions[function.blocks[latch].finish];
+
+    exit = term.e.index;
+
+    if (loop.header >= function.cfg.in.size() || exit >= function.cfg.in.size() || term.a.kind != IrOpKind::Inst)
+        return false;
+
+    IrInst& incr = function.instOp(term.a);
+
+    if (incr.cmd != IrCmd::ADD_NUM || incr.useCount != 2 || incr.a.kind != IrOpKind::Inst)
+        return false;
+
+    IrInst& index = function.instOp(incr.a);
+
+    if (index.cmd != IrCmd::LOAD_DOUBLE || index.a.kind != IrOpKind::VmReg)
+        return false;
+
+    if (term.cmd == IrCmd::JUMP_CMP_NUM)
+    {
+        // Constant step loops are matched by the latch analysis
+        if (loop.indexReg < 0 || incr.b.kind != IrOpKind::Constant || function.doubleOp(incr.b) != 1.0)
+            return false;
+    }
+    else
+    {
+        if (incr.b != term.c)
+            return false;
+
+        // Step value is checked at runtime when it's not a constant
+        if (term.c.kind == IrOpKind::Constant)
+        {
+            if (function.doubleOp(term.c) != 1.0)
+                return false;
+        }
+        else
+        {
+            IrInst* step = function.asInstOp(term.c);
+
+            if (!step || step->cmd != IrCmd::LOAD_DOUBLE || step->a.kind != IrOpKind::VmReg)
+                return false;
+
+            stepReg = vmRegOp(step->a);
+        }
+
+        if (term.b.kind == IrOpKind::Constant)
+        {
+            loop.limit = term.b;
+        }
+        else
+        {
+            IrInst* limit = function.asInstOp(term.b);
+
+            if (!limit || limit->cmd != IrCmd::LOAD_DOUBLE || limit->a.kind != IrOpKind::VmReg)
+                return false;
+
+            loop.limit = limit->a;
+        }
+
+        IrBlock& block = function.blocks[latch];
+
+        for (uint32_t i = block.start; i < block.finish; i++)
+        {
+            IrInst& inst = function.instructions[i];
+
+            if (inst.cmd == IrCmd::STORE_DOUBLE && inst.a == index.a && inst.b == term.a)
+            {
+                loop.indexReg = vmRegOp(index.a);
+                loop.indexStore = i;
+                break;
+            }
+        }
+
+        if (loop.indexReg < 0)
+            return false;
+    }
+
+    increment = term.a.index;
+
+    // Iteration has to be a single chain of blocks
+    uint32_t blockIdx = loop.header;
+
+    while (blockIdx != latch)
+    {
+        chain.push_back(blockIdx);
+
+        IrInst& last = function.instructions[function.blocks[blockIdx].finish];
+
+        if (last.cmd != IrCmd::JUMP || last.a.kind != IrOpKind::Block || chain.size() > 16)
+            return false;
+
+        blockIdx = last.a.index;
+
+        if (blockIdx == loop.header)
+            return false;
+    }
+
+    chain.push_back(latch);
+    return true;
+}
+
+IrOp LoopVectorizer::skipSubstitutes(IrOp op)
+{
+    while (op.kind == IrOpKind::Inst && function.instOp(op).cmd == IrCmd::SUBSTITUTE)
+        op = function.instOp(op).a;
+
+    return op;
+}
+
+bool LoopVectorizer::readValue(const LaneRegState& state, LaneOperand& result)
+{
+    switch (state.valueKind)
+    {
+    case LaneRegKind::Value:
+        result = state.value;
+        return true;
+    case LaneRegKind::Original:
+        readOriginal.set(state.valueSource);
+
+        if (state.valueSource == loop.indexReg)
+        {
+            result = LaneOperand{LaneOperand::Index, state.valueSource};
+        }
+        else if (valueWritten.test(state.valueSource))
+        {
+            result = LaneOperand{LaneOperand::Carried, state.valueSource};
+            carried.set(state.valueSource);
+        }
+        else
+        {
+            result = LaneOperand{LaneOperand::Reg, state.valueSource};
+        }
+        return true;
+    default:
+        break;
+    }
+
+    return false;
+}
+
+bool LoopVectorizer::resolveOperand(IrOp op, bool allowReg, LaneOperand& result)
+{
+    op = skipSubstitutes(op);
+
+    switch (op.kind)
+    {
+    case IrOpKind::None:
+    case IrOpKind::Constant:
+        result = LaneOperand{LaneOperand::Direct, 0, op};
+        return true;
+    case IrOpKind::Inst:
+        switch (nodes[op.index].kind)
+        {
+        case LaneNodeKind::Alias:
+            result = nodes[op.index].args[0];
+            return true;
+        case LaneNodeKind::Op:
+        case LaneNodeKind::Read:
+            result = LaneOperand{LaneOperand::Node, 0, op};
+            return true;
+        default:
+            break;
+        }
+        break;
+    case IrOpKind::VmReg:
+        return allowReg && readValue(regs[vmRegOp(op)], result);
+    default:
+        break;
+    }
+
+    return false;
+}
+
+LaneInfo LoopVectorizer::getInfo(const LaneOperand& op)
+{
+    LaneInfo info;
+
+    switch (op.kind)
+    {
+    case LaneOperand::Direct:
+        if (op.op.kind == IrOpKind::Constant)
+        {
+            IrConst& value = function.constOp(op.op);
+
+            if (value.kind == IrConstKind::Int)
+                setAffine(info, 0, value.valueInt);
+            else if (value.kind == IrConstKind::Double && double(int64_t(value.valueDouble)) == value.valueDouble)
+                setAffine(info, 0, int64_t(value.valueDouble));
+        }
+        break;
+    case LaneOperand::Node:
+        info = nodes[op.op.index].info;
+        break;
+    case LaneOperand::Reg:
+        break;
+    case LaneOperand::Index:
+        info.shape = LaneShape::PerLane;
+        setAffine(info, 1, 0);
+        break;
+    case LaneOperand::Carried:
+        info.shape = LaneShape::PerLane;
+        info.serial = true;
+        break;
+    }
+
+    return info;
+}
+
+bool LoopVectorizer::isAddress(const LaneOperand& op)
+{
+    LaneInfo info = getInfo(op);
+
+    return !info.memory && !info.serial;
+}
+
+bool LoopVectorizer::addTagGuard(IrOp op, uint8_t tag)
+{
+    op = skipSubstitutes(op);
+
+    LaneRegState state;
+
+    if (op.kind == IrOpKind::VmReg)
+        state = regs[vmRegOp(op)];
+    else if (op.kind == IrOpKind::Inst && nodes[op.index].kind == LaneNodeKind::TagRef)
+        state = nodes[op.index].ref;
+    else
+        return false;
+
+    switch (state.tagKind)
+    {
+    case LaneRegKind::Const:
+        // Loop will not be vectorized if the check is known to fail
+        return state.tagSource == tag;
+    case LaneRegKind::Original:
+        readOriginal.set(state.tagSource);
+
+        // Tag checked at the start of the first iteration has to remain the same for the second one
+        if (tagWritten.test(state.tagSource))
+            tagChecks.push_back({state.tagSource, tag});
+
+        addTagGuard({false, state.tagSource, tag});
+        return true;
+    case LaneRegKind::Upvalue:
+        addTagGuard({true, state.tagSource, tag});
+        return true;
+    default:
+        break;
+    }
+
+    return false;
+}
+
+void LoopVectorizer::addTagGuard(const LaneTagGuard& guard)
+{
+    for (const LaneTagGuard& other : tagGuards)
+    {
+        if (other.upvalue == guard.upvalue && other.index == guard.index && other.tag == guard.tag)
+            return;
+    }
+
+    tagGuards.push_back(guard);
+}
+
+int LoopVectorizer::addPointerSource(IrOp op)
+{
+    if (op.kind != IrOpKind::VmReg)
+        return -1;
+
+    const LaneRegState& state = regs[vmRegOp(op)];
+    LaneBufferSource source;
+
+    if (state.valueKind == LaneRegKind::Original && !valueWritten.test(state.valueSource))
+    {
+        readOriginal.set(state.valueSource);
+        source.index = state.valueSource;
+    }
+    else if (state.valueKind == LaneRegKind::Upvalue)
+    {
+        source.upvalue = true;
+        source.index = state.valueSource;
+    }
+    else
+    {
+        return -1;
+    }
+
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        if (sources[i].upvalue == source.upvalue && sources[i].index == source.index)
+            return int(i);
+    }
+
+    sources.push_back(source);
+    return int(sources.size() - 1);
+}
+
+int LoopVectorizer::getPointerSource(IrOp op)
+{
+    op = skipSubstitutes(op);
+
+    if (op.kind != IrOpKind::Inst || nodes[op.index].kind != LaneNodeKind::Pointer)
+        return -1;
+
+    return nodes[op.index].source;
+}
+
+// Registers are only written at the end of the vectorized body, so they cannot be observed by anything else in the loop
+bool LoopVectorizer::writeReg(IrOp op)
+{
+    if (op.kind != IrOpKind::VmReg)
+        return false;
+
+    int reg = vmRegOp(op);
+
+    if (function.cfg.captured.regs.test(reg) || reg == loop.indexReg || reg == stepReg)
+        return false;
+
+    return loop.limit.kind != IrOpKind::VmReg || reg != vmRegOp(loop.limit);
+}
+
+bool LoopVectorizer::analyzeOp(IrInst& inst, LaneNode& node)
+{
+    if (inst.c.kind != IrOpKind::None || inst.d.kind != IrOpKind::None)
+        return false;
+
+    bool allowReg = hasDoubleOperands(inst.cmd);
+
+    if (!resolveOperand(inst.a, allowReg, node.args[0]) || !resolveOperand(inst.b, allowReg, node.args[1]))
+        return false;
+
+    LaneInfo a = getInfo(node.args[0]);
+    LaneInfo b = getInfo(node.args[1]);
+
+    node.kind = LaneNodeKind::Op;
+    node.info.serial = a.serial || b.serial;
+    node.info.memory = a.memory || b.memory;
+
+    if (isPackedLaneOp(inst.cmd) && (a.shape == LaneShape::Packed || b.shape == LaneShape::Packed) && !node.info.serial)
+        node.info.shape = LaneShape::Packed;
+    else if (a.shape != LaneShape::Uniform || b.shape != LaneShape::Uniform)
+        node.info.shape = LaneShape::PerLane;
+
+    if (node.info.memory || !a.affine)
+        return true;
+
+    switch (inst.cmd)
+    {
+    case IrCmd::ADD_NUM:
+    case IrCmd::ADD_INT:
+        if (b.affine)
+            setAffine(node.info, a.slope + b.slope, a.base + b.base);
+        break;
+    case IrCmd::SUB_NUM:
+    case IrCmd::SUB_INT:
+        if (b.affine)
+            setAffine(node.info, a.slope - b.slope, a.base - b.base);
+        break;
+    case IrCmd::MUL_NUM:
+        if (b.affine && a.slope == 0)
+            setAffine(node.info, a.base * b.slope, a.base * b.base);
+        else if (b.affine && b.slope == 0)
+            setAffine(node.info, a.slope * b.base, a.base * b.base);
+        break;
+    case IrCmd::INT_TO_NUM:
+    case IrCmd::NUM_TO_INT:
+        setAffine(node.info, a.slope, a.base);
+        break;
+    default:
+        break;
+    }
+
+    return true;
+}
+
+bool LoopVectorizer::analyzeInst(uint32_t blockIdx, uint32_t index)
+{
+    IrInst& inst = function.instructions[index];
+    LaneNode& node = nodes[index];
+
+    if (index == increment || index == loop.indexStore)
+    {
+        node.kind = LaneNodeKind::Skip;
+
+        // Index value is no longer the same as the value at the start of the iteration
+        if (index == loop.indexStore)
+            regs[loop.indexReg].valueKind = LaneRegKind::Unknown;
+
+        return true;
+    }
+
+    switch (inst.cmd)
+    {
+    case IrCmd::INTERRUPT:
+        if (blockIdx != loop.header || !isFirstInstruction(function, function.blocks[blockIdx], index))
+            return false;
+
+        interrupt = inst.a;
+        return true;
+    case IrCmd::CHECK_SAFE_ENV:
+        safeEnv = true;
+        return true;
+    case IrCmd::CHECK_TAG:
+        return addTagGuard(inst.a, function.tagOp(inst.b));
+    case IrCmd::CHECK_BUFFER_LEN:
+    {
+        int source = getPointerSource(inst.a);
+        LaneOperand offset;
+
+        if (source < 0 || !resolveOperand(inst.b, false, offset) || !isAddress(offset) || inst.c.kind != IrOpKind::Constant)
+            return false;
+
+        lenGuards.push_back({uint8_t(source), offset, inst.c});
+        return true;
+    }
+    case IrCmd::LOAD_TAG:
+        if (inst.a.kind != IrOpKind::VmReg)
+            return false;
+
+        node.kind = LaneNodeKind::TagRef;
+        node.ref = regs[vmRegOp(inst.a)];
+        return true;
+    case IrCmd::LOAD_TVALUE:
+        if (inst.a.kind != IrOpKind::VmReg || inst.b.kind != IrOpKind::None)
+            return false;
+
+        node.kind = LaneNodeKind::TvalueRef;
+        node.ref = regs[vmRegOp(inst.a)];
+
+        // Value will be used by a register copy, it has to be available in both iterations
+        if (node.ref.valueKind == LaneRegKind::Original)
+            readOriginal.set(node.ref.valueSource);
+        if (node.ref.tagKind == LaneRegKind::Original)
+            readOriginal.set(node.ref.tagSource);
+        return true;
+    case IrCmd::LOAD_DOUBLE:
+        if (inst.a.kind != IrOpKind::VmReg || !readValue(regs[vmRegOp(inst.a)], node.args[0]))
+            return false;
+
+        node.kind = LaneNodeKind::Alias;
+        return true;
+    case IrCmd::LOAD_POINTER:
+    {
+        int source = addPointerSource(inst.a);
+
+        if (source < 0)
+            return false;
+
+        node.kind = LaneNodeKind::Pointer;
+        node.source = uint8_t(source);
+        return true;
+    }
+    case IrCmd::GET_UPVALUE:
+    {
+        if (!writeReg(inst.a) || inst.b.kind != IrOpKind::VmUpvalue)
+            return false;
+
+        int reg = vmRegOp(inst.a);
+        int upvalue = vmUpvalueOp(inst.b);
+
+        regs[reg] = LaneRegState{LaneRegKind::Upvalue, uint8_t(upvalue), {}, LaneRegKind::Upvalue, uint8_t(upvalue)};
+
+        if (upvalueTemp[upvalue] < 0)
+            upvalueTemp[upvalue] = reg;
+        return true;
+    }
+    case IrCmd::STORE_TAG:
+        if (!writeReg(inst.a) || inst.b.kind != IrOpKind::Constant)
+            return false;
+
+        regs[vmRegOp(inst.a)].tagKind = LaneRegKind::Const;
+        regs[vmRegOp(inst.a)].tagSource = function.tagOp(inst.b);
+        return true;
+    case IrCmd::STORE_DOUBLE:
+    {
+        LaneOperand value;
+
+        if (!writeReg(inst.a) || !resolveOperand(inst.b, true, value))
+            return false;
+
+        regs[vmRegOp(inst.a)].valueKind = LaneRegKind::Value;
+        regs[vmRegOp(inst.a)].value = value;
+        return true;
+    }
+    case IrCmd::STORE_SPLIT_TVALUE:
+    {
+        if (!writeReg(inst.a) || inst.b.kind != IrOpKind::Constant || inst.d.kind != IrOpKind::None)
+            return false;
+
+        LaneRegState& state = regs[vmRegOp(inst.a)];
+
+        state.tagKind = LaneRegKind::Const;
+        state.tagSource = function.tagOp(inst.b);
+        state.valueKind = LaneRegKind::Unknown;
+
+        if (state.tagSource == LUA_TNUMBER)
+        {
+            if (!resolveOperand(inst.c, true, state.value))
+                return false;
+
+            state.valueKind = LaneRegKind::Value;
+        }
+        else if (IrOp value = skipSubstitutes(inst.c); value.kind == IrOpKind::Inst && nodes[value.index].kind == LaneNodeKind::Pointer)
+        {
+            // Buffer copy holds the same object as its source
+            const LaneBufferSource& source = sources[nodes[value.index].source];
+
+            state.valueKind = source.upvalue ? LaneRegKind::Upvalue : LaneRegKind::Original;
+            state.valueSource = source.index;
+        }
+        return true;
+    }
+    case IrCmd::STORE_TVALUE:
+    {
+        IrOp value = skipSubstitutes(inst.b);
+
+        if (!writeReg(inst.a) || inst.c.kind != IrOpKind::None || value.kind != IrOpKind::Inst || nodes[value.index].kind != LaneNodeKind::TvalueRef)
+            return false;
+
+        regs[vmRegOp(inst.a)] = nodes[value.index].ref;
+        return true;
+    }
+    case IrCmd::STORE_INT:
+    case IrCmd::STORE_POINTER:
+    case IrCmd::STORE_EXTRA:
+    case IrCmd::STORE_VECTOR:
+        if (!writeReg(inst.a))
+            return false;
+
+        regs[vmRegOp(inst.a)].valueKind = LaneRegKind::Unknown;
+        return true;
+    case IrCmd::BUFFER_READI8:
+    case IrCmd::BUFFER_READU8:
+    case IrCmd::BUFFER_READI16:
+    case IrCmd::BUFFER_READU16:
+    case IrCmd::BUFFER_READI32:
+    case IrCmd::BUFFER_READF32:
+    case IrCmd::BUFFER_READF64:
+    {
+        int source = getPointerSource(inst.a);
+
+        if (source < 0 || !resolveOperand(inst.b, false, node.args[0]) || !isAddress(node.args[0]) || inst.c.kind != IrOpKind::None)
+            return false;
+
+        node.kind = LaneNodeKind::Read;
+        node.source = uint8_t(source);
+        node.accessCmd = inst.cmd;
+        node.info.memory = true;
+        node.info.shape = inst.cmd == IrCmd::BUFFER_READF32 || inst.cmd == IrCmd::BUFFER_READF64 ? LaneShape::Packed : LaneShape::PerLane;
+
+        accesses.push_back({index, uint8_t(source), getBufferAccessSize(inst.cmd)});
+        return true;
+    }
+    case IrCmd::BUFFER_WRITEI8:
+    case IrCmd::BUFFER_WRITEI16:
+    case IrCmd::BUFFER_WRITEI32:
+    case IrCmd::BUFFER_WRITEF32:
+    case IrCmd::BUFFER_WRITEF64:
+    {
+        int source = getPointerSource(inst.a);
+        bool isDouble = inst.cmd == IrCmd::BUFFER_WRITEF32 || inst.cmd == IrCmd::BUFFER_WRITEF64;
+
+        if (source < 0 || !resolveOperand(inst.b, false, node.args[0]) || !isAddress(node.args[0]) ||
+            !resolveOperand(inst.c, isDouble, node.args[1]) || inst.d.kind != IrOpKind::None)
+            return false;
+
+        node.kind = LaneNodeKind::Write;
+        node.source = uint8_t(source);
+        node.accessCmd = inst.cmd;
+        sources[source].written = true;
+
+        accesses.push_back({index, uint8_t(source), getBufferAccessSize(inst.cmd)});
+        return true;
+    }
+    case IrCmd::INT_TO_NUM:
+    {
+        // Integer read followed by the conversion is performed for both lanes at once
+        IrOp read = skipSubstitutes(inst.a);
+
+        if (read.kind == IrOpKind::Inst && nodes[read.index].kind == LaneNodeKind::Read && function.instOp(read).useCount == 1 &&
+            !accesses.empty() && accesses.back().node == read.index)
+        {
+            node = nodes[read.index];
+            node.info.shape = LaneShape::Packed;
+            nodes[read.index].kind = LaneNodeKind::Skip;
+            accesses.back().node = index;
+            return true;
+        }
+
+        return analyzeOp(inst, node);
+    }
+    default:
+        break;
+    }
+
+    if (isLaneOp(inst.cmd))
+        return analyzeOp(inst, node);
+
+    return false;
+}
+
+bool LoopVectorizer::analyze()
+{
+    uint32_t instCount = 0;
+
+    for (uint32_t blockIdx : chain)
+    {
+        IrBlock& block = function.blocks[blockIdx];
+
+        for (uint32_t index = block.start; index < block.finish; index++)
+        {
+            IrInst& inst = function.instructions[index];
+
+            switch (inst.cmd)
+            {
+            case IrCmd::STORE_TAG:
+                if (inst.a.kind == IrOpKind::VmReg)
+                    tagWritten.set(vmRegOp(inst.a));
+                break;
+            case IrCmd::STORE_EXTRA:
+            case IrCmd::STORE_POINTER:
+            case IrCmd::STORE_DOUBLE:
+            case IrCmd::STORE_INT:
+                if (inst.a.kind == IrOpKind::VmReg)
+                    valueWritten.set(vmRegOp(inst.a));
+                break;
+            case IrCmd::STORE_VECTOR:
+            case IrCmd::STORE_TVALUE:
+            case IrCmd::STORE_SPLIT_TVALUE:
+            case IrCmd::GET_UPVALUE:
+                if (inst.a.kind == IrOpKind::VmReg)
+                {
+                    tagWritten.set(vmRegOp(inst.a));
+                    valueWritten.set(vmRegOp(inst.a));
+                }
+                break;
+            default:
+                break;
+            }
+
+            instCount += !isPseudo(inst.cmd);
+        }
+    }
+
+    if (instCount > unsigned(FInt::LuauCodeGenLoopVectorizationInstLimit))
+        return false;
+
+    nodes.resize(function.instructions.size());
+
+    for (int i = 0; i < 256; i++)
+    {
+        regs[i].valueSource = uint8_t(i);
+        regs[i].tagSource = uint8_t(i);
+        upvalueTemp[i] = -1;
+    }
+
+    for (uint32_t blockIdx : chain)
+    {
+        IrBlock& block = function.blocks[blockIdx];
+
+        // Block terminators are jumps to the next block of the chain or the loop condition
+        for (uint32_t index = block.start; index < block.finish; index++)
+        {
+            if (!isPseudo(function.instructions[index].cmd) && !analyzeInst(blockIdx, index))
+                return false;
+        }
+    }
+
+    return checkLoop();
+}
+
+bool LoopVectorizer::checkLoop()
+{
+    bool hasPacked = false;
+
+    for (const LaneNode& node : nodes)
+    {
+        if ((node.kind == LaneNodeKind::Op || node.kind == LaneNodeKind::Read) && node.info.shape == LaneShape::Packed)
+            hasPacked = true;
+    }
+
+    if (!hasPacked)
+        return false;
+
+    // Values carried between iterations are taken from the first lane
+    for (int reg = 0; reg < 256; reg++)
+    {
+        if (carried.test(reg) && regs[reg].valueKind != LaneRegKind::Value)
+            return false;
+    }
+
+    for (auto [reg, tag] : tagChecks)
+    {
+        if (regs[reg].tagKind != LaneRegKind::Const || regs[reg].tagSource != tag)
+            return false;
+    }
+
+    // Registers that are used after the iteration are written by the second lane
+    const RegisterSet& headerIn = function.cfg.in[loop.header];
+    const RegisterSet& exitIn = function.cfg.in[exit];
+
+    auto isLive = [](const RegisterSet& set, int reg) {
+        return set.regs.test(reg) || (set.varargSeq && reg >= set.varargStart);
+    };
+
+    for (int reg = 0; reg < 256; reg++)
+    {
+        if ((!tagWritten.test(reg) && !valueWritten.test(reg)) || reg == loop.indexReg)
+            continue;
+
+        if (!isLive(headerIn, reg) && !isLive(exitIn, reg))
+            continue;
+
+        if (regs[reg].valueKind != LaneRegKind::Value)
+            return false;
+
+        if (tagWritten.test(reg) && (regs[reg].tagKind != LaneRegKind::Const || regs[reg].tagSource != LUA_TNUMBER))
+            return false;
+
+        liveOut.push_back(uint8_t(reg));
+    }
+
+    for (const LaneBufferSource& source : sources)
+    {
+        if (!source.upvalue)
+            continue;
+
+        int temp = upvalueTemp[source.index];
+
+        if (temp < 0 || isLive(headerIn, temp) || readOriginal.test(temp))
+            return false;
+    }
+
+    for (const LaneTagGuard& guard : tagGuards)
+    {
+        if (guard.upvalue && (upvalueTemp[guard.index] < 0 || isLive(headerIn, upvalueTemp[guard.index]) || readOriginal.test(upvalueTemp[guard.index])))
+            return false;
+    }
+
+    // Different buffer objects cannot overlap, but two sources might hold the same buffer
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        for (size_t j = i + 1; j < sources.size(); j++)
+        {
+            if (sources[i].written || sources[j].written)
+                distinctSources.push_back({uint8_t(i), uint8_t(j)});
+        }
+    }
+
+    // Second lane access of the first instruction is performed before the first lane access of the second instruction
+    for (size_t i = 0; i < accesses.size(); i++)
+    {
+        for (size_t j = i + 1; j < accesses.size(); j++)
+        {
+            const LaneAccess& a = accesses[i];
+            const LaneAccess& b = accesses[j];
+
+            const LaneNode& nodeA = nodes[a.node];
+            const LaneNode& nodeB = nodes[b.node];
+
+            if (a.source != b.source || (nodeA.kind != LaneNodeKind::Write && nodeB.kind != LaneNodeKind::Write))
+                continue;
+
+            LaneInfo offsetA = getInfo(nodeA.args[0]);
+            LaneInfo offsetB = getInfo(nodeB.args[0]);
+
+            if (!offsetA.affine || !offsetB.affine || offsetA.slope != offsetB.slope)
+                return false;
+
+            int64_t startA = offsetA.base + offsetA.slope;
+            int64_t startB = offsetB.base;
+
+            if (startA + a.size > startB && startB + b.size > startA)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+IrOp LoopVectorizer::loadLimit()
+{
+    if (loop.limit.kind == IrOpKind::Constant)
+        return loop.limit;
+
+    return emitInst(IrCmd::LOAD_DOUBLE, loop.limit);
+}
+
+IrOp LoopVectorizer::loadReg(uint8_t reg)
+{
+    if (regLoads[reg].kind == IrOpKind::None)
+        regLoads[reg] = emitInst(IrCmd::LOAD_DOUBLE, build.vmReg(reg));
+
+    return regLoads[reg];
+}
+
+IrOp LoopVectorizer::getSourcePointer(uint8_t index)
+{
+    LaneBufferSource& source = sources[index];
+
+    if (source.pointer.kind == IrOpKind::None)
+        source.pointer = emitInst(IrCmd::LOAD_POINTER, build.vmReg(uint8_t(source.upvalue ? upvalueTemp[source.index] : source.index)));
+
+    return source.pointer;
+}
+
+IrOp LoopVectorizer::getLane(const LaneOperand& op, int lane)
+{
+    switch (op.kind)
+    {
+    case LaneOperand::Direct:
+        return op.op;
+    case LaneOperand::Node:
+        return getNodeLane(op.op.index, lane);
+    case LaneOperand::Reg:
+        return loadReg(op.reg);
+    case LaneOperand::Index:
+        if (lane == 0)
+            return loadReg(op.reg);
+
+        if (indexNext.kind == IrOpKind::None)
+            indexNext = emitInst(IrCmd::ADD_NUM, loadReg(op.reg), build.constDouble(1.0));
+
+        return indexNext;
+    case LaneOperand::Carried:
+        if (lane == 0)
+            return loadReg(op.reg);
+
+        return getLane(regs[op.reg].value, 0);
+    }
+
+    CODEGEN_ASSERT(!"Unknown lane operand");
+    return {};
+}
+
+IrOp LoopVectorizer::getNodeLane(uint32_t index, int lane)
+{
+    LaneNode& node = nodes[index];
+
+    if (node.info.shape == LaneShape::Uniform)
+        lane = 0;
+
+    if (node.lanes[lane].kind != IrOpKind::None)
+        return node.lanes[lane];
+
+    IrOp result;
+
+    if (node.info.shape == LaneShape::Packed)
+    {
+        result = emitInst(IrCmd::EXTRACT_NUM_X2, getNodePacked(index), build.constInt(lane));
+    }
+    else if (node.kind == LaneNodeKind::Read)
+    {
+        result = emitInst(node.accessCmd, getSourcePointer(node.source), getLane(node.args[0], lane));
+    }
+    else
+    {
+        CODEGEN_ASSERT(node.kind == LaneNodeKind::Op);
+
+        IrCmd cmd = function.instructions[index].cmd;
+        result = emitInst(cmd, getLane(node.args[0], lane), getLane(node.args[1], lane));
+    }
+
+    nodes[index].lanes[lane] = result;
+    return result;
+}
+
+IrOp LoopVectorizer::getPacked(const LaneOperand& op)
+{
+    if (op.kind == LaneOperand::Node)
+        return getNodePacked(op.op.index);
+
+    IrOp lane0 = getLane(op, 0);
+
+    for (auto [key, packed] : packedOperands)
+    {
+        if (key == lane0)
+            return packed;
+    }
+
+    IrOp packed;
+
+    if (op.kind == LaneOperand::Index || op.kind == LaneOperand::Carried)
+        packed = emitInst(IrCmd::PACK_NUM_X2, lane0, getLane(op, 1));
+    else
+        packed = emitInst(IrCmd::DUP_NUM_X2, lane0);
+
+    packedOperands.push_back({lane0, packed});
+    return packed;
+}
+
+IrOp LoopVectorizer::getNodePacked(uint32_t index)
+{
+    LaneNode& node = nodes[index];
+
+    if (node.packed.kind != IrOpKind::None)
+        return node.packed;
+
+    IrOp result;
+
+    if (node.info.shape == LaneShape::Uniform)
+    {
+        result = emitInst(IrCmd::DUP_NUM_X2, getNodeLane(index, 0));
+    }
+    else if (node.info.shape == LaneShape::PerLane)
+    {
+        IrOp lane0 = getNodeLane(index, 0);
+        result = emitInst(IrCmd::PACK_NUM_X2, lane0, getNodeLane(index, 1));
+    }
+    else if (node.kind == LaneNodeKind::Read)
+    {
+        IrOp pointer = getSourcePointer(node.source);
+        IrOp offset0 = getLane(node.args[0], 0);
+        IrOp offset1 = getLane(node.args[0], 1);
+        result = emitInst(IrCmd::BUFFER_READ_X2, pointer, offset0, offset1, build.constUint(unsigned(node.accessCmd)));
+    }
+    else
+    {
+        CODEGEN_ASSERT(node.kind == LaneNodeKind::Op);
+
+        IrCmd cmd = getPackedLaneCmd(function.instructions[index].cmd);
+        IrOp a = getPacked(node.args[0]);
+
+        if (node.args[1].kind == LaneOperand::Direct && node.args[1].op.kind == IrOpKind::None)
+            result = emitInst(cmd, a);
+        else
+            result = emitInst(cmd, a, getPacked(node.args[1]));
+    }
+
+    nodes[index].packed = result;
+    return result;
+}
+
+void LoopVectorizer::emit(const std::vector<uint32_t>& headerPredecessors)
+{
+    fallback = IrOp{IrOpKind::Block, loop.header};
+
+    IrOp stepCheck = stepReg >= 0 ? build.block(IrBlockKind::Internal) : IrOp{};
+    IrOp indexCheck = build.block(IrBlockKind::Internal);
+    IrOp rangeCheck = build.block(IrBlockKind::Internal);
+    IrOp body = build.block(IrBlockKind::Internal);
+    IrOp tail = build.block(IrBlockKind::Internal);
+
+    IrOp entry = stepReg >= 0 ? stepCheck : indexCheck;
+
+    if (stepReg >= 0)
+    {
+        build.beginBlock(stepCheck);
+        IrOp step = emitInst(IrCmd::LOAD_DOUBLE, build.vmReg(uint8_t(stepReg)));
+        emitInst(IrCmd::JUMP_CMP_NUM, step, build.constDouble(1.0), build.cond(IrCondition::NotEqual), fallback, indexCheck);
+    }
+
+    // Index is an exact integer so that the index of the second lane is computed without rounding
+    build.beginBlock(indexCheck);
+    IrOp index = emitInst(IrCmd::LOAD_DOUBLE, build.vmReg(uint8_t(loop.indexReg)));
+    IrOp rounded = emitInst(IrCmd::INT_TO_NUM, emitInst(IrCmd::NUM_TO_INT, index));
+    emitInst(IrCmd::JUMP_CMP_NUM, rounded, index, build.cond(IrCondition::NotEqual), fallback, rangeCheck);
+
+    build.beginBlock(rangeCheck);
+    IrOp second = emitInst(IrCmd::ADD_NUM, emitInst(IrCmd::LOAD_DOUBLE, build.vmReg(uint8_t(loop.indexReg))), build.constDouble(1.0));
+    emitInst(IrCmd::JUMP_CMP_NUM, second, loadLimit(), build.cond(IrCondition::LessEqual), body, fallback);
+
+    build.beginBlock(body);
+
+    if (interrupt.kind != IrOpKind::None)
+        emitInst(IrCmd::INTERRUPT, interrupt);
+
+    if (safeEnv)
+        emitInst(IrCmd::CHECK_SAFE_ENV, fallback);
+
+    for (int upvalue = 0; upvalue < 256; upvalue++)
+    {
+        if (upvalueTemp[upvalue] >= 0)
+            emitInst(IrCmd::GET_UPVALUE, build.vmReg(uint8_t(upvalueTemp[upvalue])), build.vmUpvalue(uint8_t(upvalue)));
+    }
+
+    for (const LaneTagGuard& guard : tagGuards)
+    {
+        IrOp reg = build.vmReg(uint8_t(guard.upvalue ? upvalueTemp[guard.index] : guard.index));
+        emitInst(IrCmd::CHECK_TAG, emitInst(IrCmd::LOAD_TAG, reg), build.constTag(guard.tag), fallback);
+    }
+
+    for (auto [a, b] : distinctSources)
+        emitInst(IrCmd::CHECK_BUFFER_NO_ALIAS, getSourcePointer(a), getSourcePointer(b), fallback);
+
+    for (const LaneLenGuard& guard : lenGuards)
+    {
+        emitInst(IrCmd::CHECK_BUFFER_LEN, getSourcePointer(guard.source), getLane(guard.offset, 0), guard.size, fallback);
+
+        if (getInfo(guard.offset).shape != LaneShape::Uniform)
+            emitInst(IrCmd::CHECK_BUFFER_LEN, getSourcePointer(guard.source), getLane(guard.offset, 1), guard.size, fallback);
+    }
+
+    // Buffer accesses are performed in their original order, first lane access happens before the second lane access
+    for (const LaneAccess& access : accesses)
+    {
+        LaneNode& node = nodes[access.node];
+
+        if (node.kind == LaneNodeKind::Read)
+        {
+            if (node.info.shape == LaneShape::Packed)
+            {
+                getNodePacked(access.node);
+            }
+            else
+            {
+                getNodeLane(access.node, 0);
+                getNodeLane(access.node, 1);
+            }
+            continue;
+        }
+
+        IrOp pointer = getSourcePointer(node.source);
+        IrOp offset0 = getLane(node.args[0], 0);
+        IrOp offset1 = getLane(node.args[0], 1);
+
+        bool isDouble = node.accessCmd == IrCmd::BUFFER_WRITEF32 || node.accessCmd == IrCmd::BUFFER_WRITEF64;
+
+        if (isDouble && getInfo(node.args[1]).shape == LaneShape::Packed)
+        {
+            IrOp value = getPacked(node.args[1]);
+            emitInst(IrCmd::BUFFER_WRITE_X2, pointer, offset0, offset1, value, build.constUint(unsigned(node.accessCmd)));
+        }
+        else
+        {
+            emitInst(node.accessCmd, pointer, offset0, getLane(node.args[1], 0));
+            emitInst(node.accessCmd, pointer, offset1, getLane(node.args[1], 1));
+        }
+    }
+
+    // All register values have to be computed before the registers are modified
+    std::vector<IrOp> values;
+
+    for (uint8_t reg : liveOut)
+        values.push_back(getLane(regs[reg].value, 1));
+
+    for (size_t i = 0; i < liveOut.size(); i++)
+    {
+        emitInst(IrCmd::STORE_DOUBLE, build.vmReg(liveOut[i]), values[i]);
+
+        if (tagWritten.test(liveOut[i]))
+            emitInst(IrCmd::STORE_TAG, build.vmReg(liveOut[i]), build.constTag(LUA_TNUMBER));
+    }
+
+    IrOp next = emitInst(IrCmd::ADD_NUM, loadReg(uint8_t(loop.indexReg)), build.constDouble(2.0));
+    emitInst(IrCmd::STORE_DOUBLE, build.vmReg(uint8_t(loop.indexReg)), next);
+
+    IrOp nextSecond = emitInst(IrCmd::ADD_NUM, next, build.constDouble(1.0));
+    emitInst(IrCmd::JUMP_CMP_NUM, nextSecond, loadLimit(), build.cond(IrCondition::LessEqual), body, tail);
+
+    // Some lane values are only used by the original instructions that were replaced
+    IrBlock& bodyBlock = function.blocks[body.index];
+
+    for (uint32_t i = bodyBlock.finish; i > bodyBlock.start; i--)
+    {
+        IrInst& inst = function.instructions[i - 1];
+
+        if (inst.cmd != IrCmd::NOP && hasResult(inst.cmd) && inst.useCount == 0)
+            kill(function, inst);
+    }
+
+    // Last iteration is performed by the original loop
+    build.beginBlock(tail);
+    IrOp last = emitInst(IrCmd::LOAD_DOUBLE, build.vmReg(uint8_t(loop.indexReg)));
+    emitInst(IrCmd::JUMP_CMP_NUM, last, loadLimit(), build.cond(IrCondition::LessEqual), fallback, IrOp{IrOpKind::Block, exit});
+
+    // New blocks are placed together in the original block order
+    uint32_t sortkey = function.blocks[entry.index].sortkey;
+    uint32_t chainkey = 0;
+
+    for (IrOp block : {stepCheck, indexCheck, rangeCheck, body, tail})
+    {
+        if (block.kind == IrOpKind::None)
+            continue;
+
+        function.blocks[block.index].sortkey = sortkey;
+        function.blocks[block.index].chainkey = chainkey++;
+    }
+
+    if (stepReg >= 0)
+        function.blocks[stepCheck.index].expectedNextBlock = indexCheck.index;
+
+    function.blocks[indexCheck.index].expectedNextBlock = rangeCheck.index;
+    function.blocks[rangeCheck.index].expectedNextBlock = body.index;
+    function.blocks[body.index].expectedNextBlock = tail.index;
+
+    // Loop is now entered through the vectorized entry
+    for (uint32_t pred : headerPredecessors)
+    {
+        if (loop.inLoop[pred])
+            continue;
+
+        IrBlock& block = function.blocks[pred];
+
+        for (uint32_t i = block.start; i <= block.finish; i++)
+        {
+            visitBlockTargets(function.instructions[i], [&](IrOp& op) {
+                if (op.index == loop.header)
+                    replace(function, op, entry);
+            });
+        }
+    }
+}
+
+void vectorizeNumericLoops(IrBuilder& build)
+{
+    IrFunction& function = build.function;
+
+    std::vector<uint32_t> latches;
+
+    for (size_t blockIdx = 0; blockIdx < function.blocks.size(); blockIdx++)
+    {
+        IrBlock& block = function.blocks[blockIdx];
+        NumericLoop loop;
+
+        if (block.kind != IrBlockKind::Dead && block.kind != IrBlockKind::Fallback && matchNumericLoopLatch(function, uint32_t(blockIdx), loop))
+            latches.push_back(uint32_t(blockIdx));
+    }
+
+    for (uint32_t latch : latches)
+    {
+        LoopVectorizer vectorizer(build);
+
+        if (function.blocks[latch].kind == IrBlockKind::Dead || !vectorizer.matchLoop(latch))
+            continue;
+
+        // Each loop changes the control flow, so predecessors are collected again
+        std::vector<std::vector<uint32_t>> predecessors = computePredecessors(function);
+
+        if (!collectLoopBlocks(function, predecessors, vectorizer.loop) || !vectorizer.analyze())
+            continue;
+
+        vectorizer.emit(predecessors[vectorizer.loop.header]);
+    }
+}
+
+} // namespace CodeGen
+} // namespace Luau
@@ -46,6 +46,7 @@
 // Version 3: Adds FORGPREP/JUMPXEQK* and enhances AUX encoding for FORGLOOP. Removes FORGLOOP_NEXT/INEXT and JUMPIFEQK/JUMPIFNOTEQK. Currently supported.
 // Version 4: Adds Proto::flags, typeinfo, and floor division opcodes IDIV/IDIVK. Currently supported.
 // Version 5: Adds SUBRK/DIVRK and vector constants. Currently supported.
+// Version 6: Adds GETTABLE_GETTABLE/GETTABLE_ADD/GETTABLEKS_GETTABLEKS superinstructions. Currently supported.
 
 // # Bytecode type information history
 // Version 1: (from bytecode version 4) Type information for function signature. Currently supported.
@@ -410,6 +411,19 @@ enum LuauOpcode
     // C: constant table index (0..255)
     LOP_IDIVK,
 
+    // Superinstructions replace the opcode of the first instruction in a frequently executed pair, so that the interpreter can run both with one
+    // dispatch. The encoding is the same as that of the first instruction, and the second instruction is left as is: it may still be a jump
+    // target or be executed on its own, which makes removing the fusion (by restoring the original opcode) always valid.
+
+    // GETTABLE_GETTABLE: GETTABLE that is followed by GETTABLE
+    LOP_GETTABLE_GETTABLE,
+
+    // GETTABLE_ADD: GETTABLE that is followed by ADD
+    LOP_GETTABLE_ADD,
+
+    // GETTABLEKS_GETTABLEKS: GETTABLEKS that is followed by GETTABLEKS
+    LOP_GETTABLEKS_GETTABLEKS,
+
     // Enum entry for number of opcodes, not a valid opcode by itself!
     LOP__COUNT
 };
@@ -434,7 +448,7 @@ enum LuauBytecodeTag
 {
     // Bytecode version; runtime supports [MIN, MAX], compiler emits TARGET by default but may emit a higher version when flags are enabled
     LBC_VERSION_MIN = 3,
-    LBC_VERSION_MAX = 5,
+    LBC_VERSION_MAX = 6,
     LBC_VERSION_TARGET = 5,
     // Type encoding version
     LBC_TYPE_VERSION_DEPRECATED = 1,
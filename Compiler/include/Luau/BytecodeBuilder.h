@@ -74,6 +74,7 @@ public:
 
     void foldJumps();
     void expandJumps();
+    void fuseInstructions();
 
     void setFunctionTypeInfo(std::string value);
     void pushLocalTypeInfo(LuauBytecodeType type, uint8_t reg, uint32_t startpc, uint32_t endpc);
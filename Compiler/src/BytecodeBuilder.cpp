@@ -10,6 +10,7 @@
 LUAU_FASTFLAGVARIABLE(LuauCompileNoJumpLineRetarget, false)
 LUAU_FASTFLAG(LuauCompileRepeatUntilSkippedLocals)
 LUAU_FASTFLAGVARIABLE(LuauCompileTypeInfo, false)
+LUAU_FASTFLAGVARIABLE(LuauCompileSuperinstructions, false)
 
 namespace Luau
 {
@@ -1180,6 +1181,47 @@ void BytecodeBuilder::expandJumps()
     lines.swap(newlines);
 }
 
+static LuauOpcode getSuperinstruction(LuauOpcode op, LuauOpcode next)
+{
+    // pairs are picked based on the dynamic pair frequencies over the benchmark suite
+    if (op == LOP_GETTABLE && next == LOP_GETTABLE)
+        return LOP_GETTABLE_GETTABLE;
+
+    if (op == LOP_GETTABLE && next == LOP_ADD)
+        return LOP_GETTABLE_ADD;
+
+    if (op == LOP_GETTABLEKS && next == LOP_GETTABLEKS)
+        return LOP_GETTABLEKS_GETTABLEKS;
+
+    return LOP__COUNT;
+}
+
+void BytecodeBuilder::fuseInstructions()
+{
+    // only the opcode of the first instruction in a pair is changed, so instruction offsets, jumps and debug information stay valid
+    for (size_t i = 0; i < insns.size();)
+    {
+        LuauOpcode op = LuauOpcode(LUAU_INSN_OP(insns[i]));
+        size_t next = i + getOpLength(op);
+
+        if (next < insns.size())
+        {
+            LuauOpcode nextop = LuauOpcode(LUAU_INSN_OP(insns[next]));
+            LuauOpcode fused = getSuperinstruction(op, nextop);
+
+            if (fused != LOP__COUNT)
+            {
+                insns[i] = (insns[i] & ~0xffu) | fused;
+
+                // the second instruction of the pair can't start another pair since it's executed by the superinstruction
+                next += getOpLength(nextop);
+            }
+        }
+
+        i = next;
+    }
+}
+
 std::string BytecodeBuilder::getError(const std::string& message)
 {
     // 0 acts as a special marker for error bytecode (it's equal to LBC_VERSION_TARGET for valid bytecode blobs)
@@ -1193,6 +1235,9 @@ std::string BytecodeBuilder::getError(const std::string& message)
 uint8_t BytecodeBuilder::getVersion()
 {
     // This function usually returns LBC_VERSION_TARGET but may sometimes return a higher number (within LBC_VERSION_MIN/MAX) under fast flags
+    if (FFlag::LuauCompileSuperinstructions)
+        return 6;
+
     return LBC_VERSION_TARGET;
 }
 
@@ -1312,6 +1357,21 @@ void BytecodeBuilder::validateInstructions() const
             VCONST(insns[i + 1], String);
             break;
 
+        case LOP_GETTABLE_GETTABLE:
+        case LOP_GETTABLE_ADD:
+            VREG(LUAU_INSN_A(insn));
+            VREG(LUAU_INSN_B(insn));
+            VREG(LUAU_INSN_C(insn));
+            LUAU_ASSERT(i + 1 < insns.size() && LUAU_INSN_OP(insns[i + 1]) == (op == LOP_GETTABLE_GETTABLE ? LOP_GETTABLE : LOP_ADD));
+            break;
+
+        case LOP_GETTABLEKS_GETTABLEKS:
+            VREG(LUAU_INSN_A(insn));
+            VREG(LUAU_INSN_B(insn));
+            VCONST(insns[i + 1], String);
+            LUAU_ASSERT(i + 2 < insns.size() && LUAU_INSN_OP(insns[i + 2]) == LOP_GETTABLEKS);
+            break;
+
         case LOP_GETTABLEN:
         case LOP_SETTABLEN:
             VREG(LUAU_INSN_A(insn));
@@ -1718,7 +1778,7 @@ void BytecodeBuilder::validateVariadic() const
             // (we can't simply start a variadic sequence here because that would trigger assertions during linked CALL validation)
         }
         else if (op == LOP_CLOSEUPVALS || op == LOP_NAMECALL || op == LOP_GETIMPORT || op == LOP_MOVE || op == LOP_GETUPVAL || op == LOP_GETGLOBAL ||
-                 op == LOP_GETTABLEKS || op == LOP_COVERAGE)
+                 op == LOP_GETTABLEKS || op == LOP_GETTABLEKS_GETTABLEKS || op == LOP_COVERAGE)
         {
             // instructions inside a variadic sequence must be neutral (can't change L->top)
             // while there are many neutral instructions like this, here we check that the instruction is one of the few
@@ -1910,6 +1970,21 @@ void BytecodeBuilder::dumpInstruction(const uint32_t* code, std::string& result,
         code++;
         break;
 
+    case LOP_GETTABLE_GETTABLE:
+        formatAppend(result, "GETTABLE_GETTABLE R%d R%d R%d\n", LUAU_INSN_A(insn), LUAU_INSN_B(insn), LUAU_INSN_C(insn));
+        break;
+
+    case LOP_GETTABLE_ADD:
+        formatAppend(result, "GETTABLE_ADD R%d R%d R%d\n", LUAU_INSN_A(insn), LUAU_INSN_B(insn), LUAU_INSN_C(insn));
+        break;
+
+    case LOP_GETTABLEKS_GETTABLEKS:
+        formatAppend(result, "GETTABLEKS_GETTABLEKS R%d R%d K%d [", LUAU_INSN_A(insn), LUAU_INSN_B(insn), *code);
+        dumpConstant(result, *code);
+        result.append("]\n");
+        code++;
+        break;
+
     case LOP_SETTABLEKS:
         formatAppend(result, "SETTABLEKS R%d R%d K%d [", LUAU_INSN_A(insn), LUAU_INSN_B(insn), *code);
         dumpConstant(result, *code);
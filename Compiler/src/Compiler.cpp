@@ -28,6 +28,7 @@ LUAU_FASTINTVARIABLE(LuauCompileInlineDepth, 5)
 
 LUAU_FASTFLAGVARIABLE(LuauCompileRepeatUntilSkippedLocals, false)
 LUAU_FASTFLAG(LuauCompileTypeInfo)
+LUAU_FASTFLAG(LuauCompileSuperinstructions)
 LUAU_FASTFLAGVARIABLE(LuauTypeInfoLookupImprovement, false)
 LUAU_FASTFLAGVARIABLE(LuauCompileTempTypeInfo, false)
 
@@ -281,6 +282,9 @@ struct Compiler
 
         bytecode.expandJumps();
 
+        if (FFlag::LuauCompileSuperinstructions && options.optimizationLevel >= 2)
+            bytecode.fuseInstructions();
+
         popLocals(0);
 
         if (bytecode.getInstructionCount() > kMaxInstructionCount)
@@ -91,6 +91,7 @@ target_sources(Luau.CodeGen PRIVATE
     CodeGen/include/Luau/OptimizeConstProp.h
     CodeGen/include/Luau/OptimizeDeadStore.h
     CodeGen/include/Luau/OptimizeFinalX64.h
+    CodeGen/include/Luau/OptimizeLoops.h
     CodeGen/include/Luau/RegisterA64.h
     CodeGen/include/Luau/RegisterX64.h
     CodeGen/include/Luau/SharedCodeAllocator.h
@@ -132,6 +133,7 @@ target_sources(Luau.CodeGen PRIVATE
     CodeGen/src/OptimizeConstProp.cpp
     CodeGen/src/OptimizeDeadStore.cpp
     CodeGen/src/OptimizeFinalX64.cpp
+    CodeGen/src/OptimizeLoops.cpp
     CodeGen/src/UnwindBuilderDwarf2.cpp
     CodeGen/src/UnwindBuilderWin.cpp
     CodeGen/src/BytecodeAnalysis.cpp
@@ -315,6 +317,7 @@ target_sources(Luau.VM PRIVATE
     VM/src/lfunc.cpp
     VM/src/lgc.cpp
     VM/src/lgcdebug.cpp
+    VM/src/lgcparallel.cpp
     VM/src/linit.cpp
     VM/src/lmathlib.cpp
     VM/src/lmem.cpp
@@ -322,6 +325,7 @@ target_sources(Luau.VM PRIVATE
     VM/src/lobject.cpp
     VM/src/loslib.cpp
     VM/src/lperf.cpp
+    VM/src/lsnapshot.cpp
     VM/src/lstate.cpp
     VM/src/lstring.cpp
     VM/src/lstrlib.cpp
@@ -343,6 +347,7 @@ target_sources(Luau.VM PRIVATE
     VM/src/ldo.h
     VM/src/lfunc.h
     VM/src/lgc.h
+    VM/src/lgctraverse.h
     VM/src/lmem.h
     VM/src/lnumutils.h
     VM/src/lobject.h
@@ -370,6 +375,8 @@ target_sources(Luau.CLI.lib PRIVATE
 if(TARGET Luau.Repl.CLI)
     # Luau.Repl.CLI Sources
     target_sources(Luau.Repl.CLI PRIVATE
+        CLI/Counters.h
+        CLI/Counters.cpp
         CLI/Coverage.h
         CLI/Coverage.cpp
         CLI/Profiler.h
@@ -506,8 +513,12 @@ endif()
 if(TARGET Luau.CLI.Test)
     # Luau.CLI.Test Sources
     target_sources(Luau.CLI.Test PRIVATE
+        CLI/Counters.h
+        CLI/Counters.cpp
         CLI/Coverage.h
         CLI/Coverage.cpp
+        CLI/HeapSnapshot.h
+        CLI/HeapSnapshot.cpp
         CLI/Profiler.h
         CLI/Profiler.cpp
         CLI/Repl.cpp
@@ -515,6 +526,7 @@ if(TARGET Luau.CLI.Test)
 
         tests/RegisterCallbacks.h
         tests/RegisterCallbacks.cpp
+        tests/HeapSnapshot.test.cpp
         tests/Repl.test.cpp
         tests/RequireByString.test.cpp
         tests/main.cpp)
@@ -544,3 +556,11 @@ if(TARGET Luau.Bytecode.CLI)
     target_sources(Luau.Bytecode.CLI PRIVATE
         CLI/Bytecode.cpp)
 endif()
+
+if(TARGET Luau.HeapDiff.CLI)
+    # Luau.HeapDiff.CLI Sources
+    target_sources(Luau.HeapDiff.CLI PRIVATE
+        CLI/HeapSnapshot.h
+        CLI/HeapSnapshot.cpp
+        CLI/HeapDiff.cpp)
+endif()
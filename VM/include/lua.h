@@ -228,6 +228,19 @@ LUA_API int luau_load(lua_State* L, const char* chunkname, const char* data, siz
 LUA_API void lua_call(lua_State* L, int nargs, int nresults);
 LUA_API int lua_pcall(lua_State* L, int nargs, int nresults, int errfunc);
 
+/*
+** shared bytecode images
+** an image holds a copy of the bytecode along with the instructions and line information of every function; chunks loaded from an image
+** into any number of states share these arrays instead of copying them. constants, strings and functions are still created in each state.
+** images are reference counted: luau_newimage returns an image with one reference, and each function loaded from it holds another one.
+** images can be shared between threads. lua_breakpoint fails with -1 for a function from an image while it is running
+*/
+typedef struct lua_BytecodeImage lua_BytecodeImage;
+
+LUA_API lua_BytecodeImage* luau_newimage(const char* data, size_t size);
+LUA_API void luau_releaseimage(lua_BytecodeImage* image);
+LUA_API int luau_loadimage(lua_State* L, const char* chunkname, lua_BytecodeImage* image, int env);
+
 /*
 ** coroutine functions
 */
@@ -290,6 +303,70 @@ enum lua_GCOp
     LUA_GCSETGOAL,
     LUA_GCSETSTEPMUL,
     LUA_GCSETSTEPSIZE,
+
+    /*
+    ** switch the collector to generational (GEN) or incremental (INC) mode; returns 1 if generational mode was enabled before the call
+    **
+    ** in generational mode, objects that survive a collection become old and are not traversed again by minor collections, which only
+    ** mark objects allocated since the last collection and old objects that were modified since then. minor collections are still
+    ** incremental and use the same step multiplier and step size as the incremental mode.
+    ** switching back to incremental mode performs a full collection to reset the age of all objects.
+    */
+    LUA_GCGEN,
+    LUA_GCINC,
+
+    /*
+    ** tune generational mode parameters: minor multiplier and major multiplier
+    **
+    ** minor collection starts when the heap grows by minor multiplier % since the end of the last collection (default 20%)
+    ** major collection, which traverses the entire heap, is performed when the heap grows by major multiplier % since the end of the
+    ** last major collection (default 100%)
+    */
+    LUA_GCSETGENMINORMUL,
+    LUA_GCSETGENMAJORMUL,
+
+    /*
+    ** set the number of helper threads used to mark the heap when the collector has to finish marking without interruption (the atomic
+    ** stage of every cycle and full collections); returns the previous number of helper threads
+    **
+    ** 0 (default) disables parallel marking; the value is clamped to LUAI_GCMAXMARKWORKERS
+    */
+    LUA_GCSETMARKWORKERS,
+
+    /*
+    ** enable (data=1) or disable (data=0) the background sweep thread; returns 1 if it was enabled before the call
+    **
+    ** the thread is disabled by default. when enabled, object pages emptied by the sweep are returned to the allocation function from a
+    ** background thread, so the allocation function has to support being called from another thread. objects are still freed and
+    ** userdata destructors still run on the thread that performs the GC step
+    */
+    LUA_GCSETSWEEPTHREAD,
+
+    /*
+    ** returns the allocation rate of memory category 'data' in Kbytes per second since the end of the last collection cycle, or -1 if
+    ** the interval is too short to measure; this is the net growth of the category, similar to the rate used by the collector pacing
+    */
+    LUA_GCMEMCATRATE,
+
+    /*
+    ** set the time budget of a single GC step in microseconds; returns the previous budget
+    **
+    ** incremental steps are sized using the mark and sweep throughput measured in earlier steps instead of the step size, and the
+    ** collector runs shorter steps more frequently to keep up with the allocations. the atomic stage can't be split and isn't bounded
+    ** by the budget. 0 (default) disables the time budget
+    */
+    LUA_GCSETSTEPTIME,
+
+    /*
+    ** set the number of collected threads whose stack and call info arrays are kept for reuse by new threads; returns the previous number
+    **
+    ** threads created by lua_newthread and coroutine.create take the arrays, including any extra space the collected thread grew, instead
+    ** of allocating new ones. the pool is accounted to memory category 0 and is emptied by a full collection (default LUAI_THREADPOOLSIZE)
+    */
+    LUA_GCSETTHREADPOOL,
+
+    // returns the number of threads currently kept in the thread pool
+    LUA_GCTHREADPOOLCOUNT,
 };
 
 LUA_API int lua_gc(lua_State* L, int what, int data);
@@ -302,6 +379,41 @@ LUA_API int lua_gc(lua_State* L, int what, int data);
 LUA_API void lua_setmemcat(lua_State* L, int category);
 LUA_API size_t lua_totalbytes(lua_State* L, int category);
 
+/*
+** memory category limits (0 means no limit)
+** while a category is above its soft limit, each allocation in it requests an extra collector step; an allocation that would take a
+** category above its hard limit raises a memory error. hard limits can't be set for category 0 which holds data shared by the VM
+*/
+LUA_API void lua_setmemcatlimit(lua_State* L, int category, size_t softlimit, size_t hardlimit);
+
+/*
+** heap snapshots
+** lua_heapsnapshot writes a compact binary description of all objects in the heap and the references between them; the data is passed to
+** the writer in chunks as the heap is traversed. snapshots of the same state can be compared offline with luau-heapdiff
+*/
+typedef void (*lua_HeapWriter)(void* ud, const void* data, size_t size);
+
+LUA_API void lua_heapsnapshot(lua_State* L, lua_HeapWriter writer, void* ud);
+
+/*
+** state images
+** lua_savestate writes every object reachable from the registry, the globals and the type metatables of a state; lua_restorestate
+** recreates these objects in another state (normally a fresh one) and makes them its registry, globals and type metatables.
+** C functions are saved by the name of the binding with the same function and continuation, and a restored C function gets the part of
+** the name after the last '.' as its debug name. images can't contain light userdata, userdata with inline destructors, open upvalues or
+** threads that aren't reset; userdata destructors and light userdata names are not part of the image and need to be set up by the host.
+** both functions return 0 on success; otherwise, the error message is pushed on the stack
+*/
+typedef struct lua_CBinding
+{
+    const char* name;
+    lua_CFunction func;
+    lua_Continuation cont;
+} lua_CBinding;
+
+LUA_API int lua_savestate(lua_State* L, const lua_CBinding* bindings, int nbindings, lua_HeapWriter writer, void* ud);
+LUA_API int lua_restorestate(lua_State* L, const char* data, size_t size, const lua_CBinding* bindings, int nbindings);
+
 /*
 ** miscellaneous functions
 */
@@ -331,6 +443,9 @@ LUA_API void lua_clonefunction(lua_State* L, int idx);
 
 LUA_API void lua_cleartable(lua_State* L, int idx);
 
+// pushes a copy of the table at idx that shares storage with it until either table is written to
+LUA_API void lua_clonetable(lua_State* L, int idx);
+
 LUA_API lua_Alloc lua_getallocf(lua_State* L, void** ud);
 
 /*
@@ -409,6 +524,14 @@ typedef void (*lua_Coverage)(void* context, const char* function, int linedefine
 
 LUA_API void lua_getcoverage(lua_State* L, int funcindex, void* context, lua_Coverage callback);
 
+// Execution counters are only collected when the VM is built with LUAI_EXECCOUNTERS; otherwise all counters read as zero
+typedef void (*lua_Counters)(void* context, const char* function, int linedefined, int depth, uint64_t calls, uint64_t loops);
+
+LUA_API void lua_getcounters(lua_State* L, int funcindex, void* context, lua_Counters callback);
+LUA_API void lua_resetcounters(lua_State* L, int funcindex);
+LUA_API int lua_getopcounters(lua_State* L, uint64_t* counts, int size);
+LUA_API void lua_resetopcounters(lua_State* L);
+
 // Warning: this function is not thread-safe since it stores the result in a shared global array! Only use for debugging.
 LUA_API const char* lua_debugtrace(lua_State* L);
 
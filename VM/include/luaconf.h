@@ -91,6 +91,36 @@
 #define LUAI_MAXCCALLS 200
 #endif
 
+// LUAI_GCSWEEPTHREAD controls support for releasing pages emptied by the sweep on a background thread
+#ifndef LUAI_GCSWEEPTHREAD
+#define LUAI_GCSWEEPTHREAD 1
+#endif
+
+// LUAI_GCMAXMARKWORKERS limits the number of helper threads the collector can use for parallel marking; 0 disables the use of threads
+#ifndef LUAI_GCMAXMARKWORKERS
+#define LUAI_GCMAXMARKWORKERS 8
+#endif
+
+// LUAI_STACKPOOLSIZE limits the memory kept for reuse in stack buffers released by dead, reset or shrunk threads; 0 disables the pool
+#ifndef LUAI_STACKPOOLSIZE
+#define LUAI_STACKPOOLSIZE (1 << 20)
+#endif
+
+// LUAI_THREADPOOLSIZE is the default number of collected threads whose stack and call info arrays are kept for new threads
+#ifndef LUAI_THREADPOOLSIZE
+#define LUAI_THREADPOOLSIZE 64
+#endif
+
+// LUAI_EXECCOUNTERS enables interpreter counters for function calls, loop iterations and executed opcodes; this slows down execution
+#ifndef LUAI_EXECCOUNTERS
+#define LUAI_EXECCOUNTERS 0
+#endif
+
+// LUAI_TYPEFEEDBACK enables recording of operand types in the interpreter for tier-up compilation; this slows down execution
+#ifndef LUAI_TYPEFEEDBACK
+#define LUAI_TYPEFEEDBACK 0
+#endif
+
 // buffer size used for on-stack string operations; this limit depends on native stack size
 #ifndef LUA_BUFFERSIZE
 #define LUA_BUFFERSIZE 512
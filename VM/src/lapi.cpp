@@ -7,6 +7,7 @@
 #include "ltable.h"
 #include "lfunc.h"
 #include "lgc.h"
+#include "lmem.h"
 #include "ldo.h"
 #include "ludata.h"
 #include "lvm.h"
@@ -764,7 +765,7 @@ void lua_setreadonly(lua_State* L, int objindex, int enabled)
     api_check(L, ttistable(o));
     Table* t = hvalue(o);
     api_check(L, t != hvalue(registry(L)));
-    t->readonly = bool(enabled);
+    t->readonly = enabled ? (t->readonly | LUAH_READONLY) : (t->readonly & ~LUAH_READONLY);
 }
 
 int lua_getreadonly(lua_State* L, int objindex)
@@ -772,7 +773,7 @@ int lua_getreadonly(lua_State* L, int objindex)
     const TValue* o = index2addr(L, objindex);
     api_check(L, ttistable(o));
     Table* t = hvalue(o);
-    int res = t->readonly;
+    int res = (t->readonly & LUAH_READONLY) != 0;
     return res;
 }
 
@@ -859,7 +860,7 @@ void lua_rawsetfield(lua_State* L, int idx, const char* k)
     StkId t = index2addr(L, idx);
     api_check(L, ttistable(t));
     if (hvalue(t)->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, hvalue(t));
     setobj2t(L, luaH_setstr(L, hvalue(t), luaS_new(L, k)), L->top - 1);
     luaC_barriert(L, hvalue(t), L->top - 1);
     L->top--;
@@ -871,7 +872,7 @@ void lua_rawset(lua_State* L, int idx)
     StkId t = index2addr(L, idx);
     api_check(L, ttistable(t));
     if (hvalue(t)->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, hvalue(t));
     setobj2t(L, luaH_set(L, hvalue(t), L->top - 2), L->top - 1);
     luaC_barriert(L, hvalue(t), L->top - 1);
     L->top -= 2;
@@ -883,7 +884,7 @@ void lua_rawseti(lua_State* L, int idx, int n)
     StkId o = index2addr(L, idx);
     api_check(L, ttistable(o));
     if (hvalue(o)->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, hvalue(o));
     setobj2t(L, luaH_setnum(L, hvalue(o), n), L->top - 1);
     luaC_barriert(L, hvalue(o), L->top - 1);
     L->top--;
@@ -905,7 +906,7 @@ int lua_setmetatable(lua_State* L, int objindex)
     case LUA_TTABLE:
     {
         if (hvalue(obj)->readonly)
-            luaG_readonlyerror(L);
+            luaH_makewritable(L, hvalue(obj));
         hvalue(obj)->metatable = mt;
         if (mt)
             luaC_objbarrier(L, hvalue(obj), mt);
@@ -1175,6 +1176,63 @@ int lua_gc(lua_State* L, int what, int data)
         g->gcstepsize = data << 10;
         break;
     }
+    case LUA_GCGEN:
+    {
+        res = g->gcgen;
+        luaC_setgenerational(L, true);
+        break;
+    }
+    case LUA_GCINC:
+    {
+        res = g->gcgen;
+        luaC_setgenerational(L, false);
+        break;
+    }
+    case LUA_GCSETGENMINORMUL:
+    {
+        res = g->gcgenminormul;
+        g->gcgenminormul = data;
+        break;
+    }
+    case LUA_GCSETGENMAJORMUL:
+    {
+        res = g->gcgenmajormul;
+        g->gcgenmajormul = data;
+        break;
+    }
+    case LUA_GCSETMARKWORKERS:
+    {
+        res = luaC_setmarkworkers(L, data);
+        break;
+    }
+    case LUA_GCSETSWEEPTHREAD:
+    {
+        res = luaM_setsweepthread(L, data != 0);
+        break;
+    }
+    case LUA_GCSETSTEPTIME:
+    {
+        res = g->gcsteptime;
+        g->gcsteptime = data < 0 ? 0 : data;
+        break;
+    }
+    case LUA_GCSETTHREADPOOL:
+    {
+        res = luaE_setthreadpool(L, data < 0 ? 0 : data);
+        break;
+    }
+    case LUA_GCTHREADPOOLCOUNT:
+    {
+        res = g->threadpoolsize;
+        break;
+    }
+    case LUA_GCMEMCATRATE:
+    {
+        api_check(L, unsigned(data) < LUA_MEMORY_CATEGORIES);
+        int64_t rate = luaC_memcatallocationrate(L, uint8_t(data));
+        res = rate < 0 ? -1 : int(rate >> 10);
+        break;
+    }
     default:
         res = -1; // invalid option
     }
@@ -1465,10 +1523,22 @@ void lua_cleartable(lua_State* L, int idx)
     api_check(L, ttistable(t));
     Table* tt = hvalue(t);
     if (tt->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, tt);
     luaH_clear(tt);
 }
 
+void lua_clonetable(lua_State* L, int idx)
+{
+    luaC_checkGC(L);
+    luaC_threadbarrier(L);
+    StkId t = index2addr(L, idx);
+    api_check(L, ttistable(t));
+    api_check(L, hvalue(t) != hvalue(registry(L)));
+    Table* tt = luaH_cloneshared(L, hvalue(t));
+    sethvalue(L, L->top, tt);
+    api_incr_top(L);
+}
+
 lua_Callbacks* lua_callbacks(lua_State* L)
 {
     return &L->global->cb;
@@ -1486,6 +1556,21 @@ size_t lua_totalbytes(lua_State* L, int category)
     return category < 0 ? L->global->totalbytes : L->global->memcatbytes[category];
 }
 
+void lua_setmemcatlimit(lua_State* L, int category, size_t softlimit, size_t hardlimit)
+{
+    api_check(L, unsigned(category) < LUA_MEMORY_CATEGORIES);
+    api_check(L, category != 0 || hardlimit == 0);
+
+    global_State* g = L->global;
+    g->memcathardlimit[category] = hardlimit ? hardlimit : SIZE_MAX;
+    g->memcatsoftlimit[category] = softlimit && softlimit < g->memcathardlimit[category] ? softlimit : g->memcathardlimit[category];
+}
+
+void lua_heapsnapshot(lua_State* L, lua_HeapWriter writer, void* ud)
+{
+    luaC_heapsnapshot(L, ud, writer);
+}
+
 lua_Alloc lua_getallocf(lua_State* L, void** ud)
 {
     lua_Alloc f = L->global->frealloc;
@@ -347,9 +347,47 @@ void luaG_pusherror(lua_State* L, const char* error)
     pusherror(L, error);
 }
 
-void luaG_breakpoint(lua_State* L, Proto* p, int line, bool enable)
+struct ActiveProtoContext
+{
+    Proto* p;
+    bool active;
+};
+
+static bool isprotoonstack(lua_State* th, Proto* p)
+{
+    for (CallInfo* ci = th->base_ci; ci <= th->ci; ++ci)
+        if (isLua(ci) && clvalue(ci->func)->l.p == p)
+            return true;
+
+    return false;
+}
+
+static bool visitactiveproto(void* context, lua_Page* page, GCObject* gco)
+{
+    ActiveProtoContext* ctx = (ActiveProtoContext*)context;
+
+    if (gco->gch.tt == LUA_TTHREAD && isprotoonstack(gco2th(gco), ctx->p))
+        ctx->active = true;
+
+    return false;
+}
+
+static bool isprotoactive(lua_State* L, Proto* p)
+{
+    // main thread isn't allocated from the GC pages, so the visitor doesn't see it
+    if (isprotoonstack(L->global->mainthread, p))
+        return true;
+
+    ActiveProtoContext ctx = {p, false};
+    luaM_visitgco(L, &ctx, visitactiveproto);
+
+    return ctx.active;
+}
+
+bool luaG_breakpoint(lua_State* L, Proto* p, int line, bool enable)
 {
     void (*ondisable)(lua_State*, Proto*) = L->global->ecb.disable;
+    bool result = true;
 
     // since native code doesn't support breakpoints, we would need to update all call frames with LUAU_CALLINFO_NATIVE that refer to p
     if (p->lineinfo && (ondisable || !p->execdata))
@@ -363,6 +401,23 @@ void luaG_breakpoint(lua_State* L, Proto* p, int line, bool enable)
             if (luaG_getline(p, i) != line)
                 continue;
 
+            // instructions shared with other states can't be patched, so we need a private copy first
+            // running frames keep raw pointers into the shared array, so this is only safe when the function isn't on any call stack
+            if (p->image)
+            {
+                // shared instructions never have breakpoints, so there is nothing to disable
+                if (!enable)
+                    break;
+
+                if (isprotoactive(L, p))
+                {
+                    result = false;
+                    break;
+                }
+
+                luaF_detachimage(L, p);
+            }
+
             // lazy copy of the original opcode array; done when the first breakpoint is set
             if (!p->debuginsn)
             {
@@ -392,8 +447,11 @@ void luaG_breakpoint(lua_State* L, Proto* p, int line, bool enable)
 
     for (int i = 0; i < p->sizep; ++i)
     {
-        luaG_breakpoint(L, p->p[i], line, enable);
+        if (!luaG_breakpoint(L, p->p[i], line, enable))
+            result = false;
     }
+
+    return result;
 }
 
 bool luaG_onbreak(lua_State* L)
@@ -497,8 +555,9 @@ int lua_breakpoint(lua_State* L, int funcindex, int line, int enabled)
     // set the breakpoint to the next closest line with valid instructions
     int target = getnextline(p, line);
 
-    if (target != -1)
-        luaG_breakpoint(L, p, target, bool(enabled));
+    // functions that share instructions with a bytecode image can't get a breakpoint while they are running
+    if (target != -1 && !luaG_breakpoint(L, p, target, bool(enabled)))
+        return -1;
 
     return target;
 }
@@ -547,6 +606,70 @@ void lua_getcoverage(lua_State* L, int funcindex, void* context, lua_Coverage ca
     luaM_freearray(L, buffer, size, int, 0);
 }
 
+static void getcounters(Proto* p, int depth, void* context, lua_Counters callback)
+{
+    const char* debugname = p->debugname ? getstr(p->debugname) : NULL;
+    int linedefined = p->linedefined;
+
+#if LUAI_EXECCOUNTERS
+    callback(context, debugname, linedefined, depth, p->execcalls, p->execloops);
+#else
+    callback(context, debugname, linedefined, depth, 0, 0);
+#endif
+
+    for (int i = 0; i < p->sizep; ++i)
+        getcounters(p->p[i], depth + 1, context, callback);
+}
+
+void lua_getcounters(lua_State* L, int funcindex, void* context, lua_Counters callback)
+{
+    const TValue* func = luaA_toobject(L, funcindex);
+    api_check(L, ttisfunction(func) && !clvalue(func)->isC);
+
+    getcounters(clvalue(func)->l.p, 0, context, callback);
+}
+
+static void resetcounters(Proto* p)
+{
+#if LUAI_EXECCOUNTERS
+    p->execcalls = 0;
+    p->execloops = 0;
+#endif
+
+    for (int i = 0; i < p->sizep; ++i)
+        resetcounters(p->p[i]);
+}
+
+void lua_resetcounters(lua_State* L, int funcindex)
+{
+    const TValue* func = luaA_toobject(L, funcindex);
+    api_check(L, ttisfunction(func) && !clvalue(func)->isC);
+
+    resetcounters(clvalue(func)->l.p);
+}
+
+int lua_getopcounters(lua_State* L, uint64_t* counts, int size)
+{
+    for (int i = 0; i < size && i < LOP__COUNT; ++i)
+    {
+#if LUAI_EXECCOUNTERS
+        counts[i] = L->global->execops[i];
+#else
+        counts[i] = 0;
+#endif
+    }
+
+    return LOP__COUNT;
+}
+
+void lua_resetopcounters(lua_State* L)
+{
+#if LUAI_EXECCOUNTERS
+    for (int i = 0; i < 256; ++i)
+        L->global->execops[i] = 0;
+#endif
+}
+
 static size_t append(char* buf, size_t bufsize, size_t offset, const char* data)
 {
     size_t size = strlen(data);
@@ -174,12 +174,109 @@ static void correctstack(lua_State* L, TValue* oldstack)
     L->base = (L->base - oldstack) + L->stack;
 }
 
+/*
+** Stack pool
+**
+** Stacks are contiguous, so growing one has to move it and fix up all pointers into it. To keep memory use of many idle threads
+** low, the collector shrinks stacks that are mostly unused. Large stacks are sized in powers of two and their buffers are kept
+** in a pool when a thread releases them, so that threads that need a larger stack, often coroutines running similar code, can
+** take a buffer from the pool instead of going to the allocator. Pooled memory is accounted to memory category 0 and is
+** limited by LUAI_STACKPOOLSIZE.
+*/
+
+// returns the pool class for stack buffers with `size' slots, or -1 if such buffers aren't pooled
+static int stackpoolclass(int size)
+{
+    if (size < (1 << STACKPOOL_MINLOG) || (size & (size - 1)) != 0)
+        return -1;
+
+    int cls = luaO_log2(size) - STACKPOOL_MINLOG;
+    return cls < STACKPOOL_CLASSES ? cls : -1;
+}
+
+static TValue* takepooledstack(lua_State* L, int size)
+{
+    global_State* g = L->global;
+    int cls = stackpoolclass(size);
+
+    if (cls < 0 || g->stackpool[cls] == NULL)
+        return NULL;
+
+    size_t bytes = size * sizeof(TValue);
+    luaM_movememcat_(L, bytes, 0, L->memcat);
+
+    TValue* stack = g->stackpool[cls];
+    g->stackpool[cls] = *cast_to(TValue**, stack);
+    g->stackpoolbytes -= bytes;
+    return stack;
+}
+
+int luaD_ispooledstack(int size)
+{
+    return stackpoolclass(size) >= 0;
+}
+
+void luaD_releasestack(lua_State* L, TValue* stack, int size, uint8_t memcat)
+{
+    global_State* g = L->global;
+    int cls = stackpoolclass(size);
+    size_t bytes = size * sizeof(TValue);
+
+    // moving the buffer to category 0 can't take it over the soft limit, since this can run during a sweep which mustn't fail
+    if (cls >= 0 && g->stackpoolbytes + bytes <= LUAI_STACKPOOLSIZE && g->memcatbytes[0] + bytes <= g->memcatsoftlimit[0])
+    {
+        luaM_movememcat_(L, bytes, memcat, 0);
+
+        *cast_to(TValue**, stack) = g->stackpool[cls];
+        g->stackpool[cls] = stack;
+        g->stackpoolbytes += bytes;
+    }
+    else
+    {
+        luaM_freearray(L, stack, size, TValue, memcat);
+    }
+}
+
+void luaD_flushstackpool(lua_State* L)
+{
+    global_State* g = L->global;
+
+    for (int cls = 0; cls < STACKPOOL_CLASSES; cls++)
+    {
+        int size = 1 << (cls + STACKPOOL_MINLOG);
+
+        while (TValue* stack = g->stackpool[cls])
+        {
+            g->stackpool[cls] = *cast_to(TValue**, stack);
+            luaM_freearray(L, stack, size, TValue, 0);
+        }
+    }
+
+    g->stackpoolbytes = 0;
+}
+
 void luaD_reallocstack(lua_State* L, int newsize)
 {
     TValue* oldstack = L->stack;
     int realsize = newsize + EXTRA_STACK;
     LUAU_ASSERT(L->stack_last - L->stack == L->stacksize - EXTRA_STACK);
-    luaM_reallocarray(L, L->stack, L->stacksize, realsize, TValue, L->memcat);
+
+    // pooled buffers are moved instead of reallocated, so that a large buffer can be reused after the thread no longer needs it
+    TValue* pooled = takepooledstack(L, realsize);
+    if (!pooled && realsize < L->stacksize && stackpoolclass(L->stacksize) >= 0)
+        pooled = luaM_newarray(L, realsize, TValue, L->memcat);
+
+    if (pooled)
+    {
+        memcpy(pooled, oldstack, (L->stacksize < realsize ? L->stacksize : realsize) * sizeof(TValue));
+        luaD_releasestack(L, oldstack, L->stacksize, L->memcat);
+        L->stack = pooled;
+    }
+    else
+    {
+        luaM_reallocarray(L, L->stack, L->stacksize, realsize, TValue, L->memcat);
+    }
+
     TValue* newstack = L->stack;
     for (int i = L->stacksize; i < realsize; i++)
         setnilvalue(newstack + i); // erase new segment
@@ -199,10 +296,13 @@ void luaD_reallocCI(lua_State* L, int newsize)
 
 void luaD_growstack(lua_State* L, int n)
 {
-    if (n <= L->stacksize) // double size is enough?
-        luaD_reallocstack(L, 2 * L->stacksize);
-    else
-        luaD_reallocstack(L, L->stacksize + n);
+    int newsize = (n <= L->stacksize) ? 2 * L->stacksize : L->stacksize + n; // double size is enough?
+
+    // large stacks are sized in powers of two so that their buffers can go through the stack pool
+    if (newsize + EXTRA_STACK > (1 << STACKPOOL_MINLOG))
+        newsize = (1 << ceillog2(newsize + EXTRA_STACK)) - EXTRA_STACK;
+
+    luaD_reallocstack(L, newsize);
 }
 
 CallInfo* luaD_growCI(lua_State* L)
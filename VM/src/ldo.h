@@ -49,6 +49,9 @@ LUAI_FUNC int luaD_pcall(lua_State* L, Pfunc func, void* u, ptrdiff_t oldtop, pt
 LUAI_FUNC void luaD_reallocCI(lua_State* L, int newsize);
 LUAI_FUNC void luaD_reallocstack(lua_State* L, int newsize);
 LUAI_FUNC void luaD_growstack(lua_State* L, int n);
+LUAI_FUNC int luaD_ispooledstack(int size);
+LUAI_FUNC void luaD_releasestack(lua_State* L, TValue* stack, int size, uint8_t memcat);
+LUAI_FUNC void luaD_flushstackpool(lua_State* L);
 LUAI_FUNC void luaD_checkCstack(lua_State* L);
 
 LUAI_FUNC l_noret luaD_throw(lua_State* L, int errcode);
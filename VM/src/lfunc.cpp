@@ -6,6 +6,8 @@
 #include "lmem.h"
 #include "lgc.h"
 
+#include <string.h>
+
 LUAU_FASTFLAGVARIABLE(LuauLoadTypeInfo, false)
 
 Proto* luaF_newproto(lua_State* L)
@@ -41,6 +43,16 @@ Proto* luaF_newproto(lua_State* L)
 
     f->userdata = NULL;
 
+    f->image = NULL;
+
+    f->inlinecache = NULL;
+    f->typefeedback = NULL;
+
+#if LUAI_EXECCOUNTERS
+    f->execcalls = 0;
+    f->execloops = 0;
+#endif
+
     f->gclist = NULL;
 
     f->sizecode = 0;
@@ -52,6 +64,8 @@ Proto* luaF_newproto(lua_State* L)
     f->linegaplog2 = 0;
     f->linedefined = 0;
     f->bytecodeid = 0;
+    f->sizeinlinecache = 0;
+    f->tierupcount = L->global->tierupthreshold;
 
     if (FFlag::LuauLoadTypeInfo)
         f->sizetypeinfo = 0;
@@ -126,6 +140,16 @@ UpVal* luaF_findupval(lua_State* L, StkId level)
     return uv;
 }
 
+UpVal* luaF_newclosedupval(lua_State* L)
+{
+    UpVal* uv = luaM_newgco(L, UpVal, sizeof(UpVal), L->activememcat);
+    luaC_init(L, uv, LUA_TUPVAL);
+    uv->markedopen = 0;
+    uv->v = &uv->u.value;
+    setnilvalue(uv->v);
+    return uv;
+}
+
 void luaF_freeupval(lua_State* L, UpVal* uv, lua_Page* page)
 {
     luaM_freegco(L, uv, sizeof(UpVal), uv->memcat, page); // free upvalue
@@ -163,13 +187,54 @@ void luaF_closeupval(lua_State* L, UpVal* uv, bool dead)
     luaC_upvalclosed(L, uv);
 }
 
+void luaF_detachimage(lua_State* L, Proto* f)
+{
+    LUAU_ASSERT(f->image);
+
+    Instruction* code = luaM_newarray(L, f->sizecode, Instruction, f->memcat);
+    memcpy(code, f->code, f->sizecode * sizeof(Instruction));
+
+    uint8_t* lineinfo = NULL;
+
+    if (f->lineinfo)
+    {
+        lineinfo = luaM_newarray(L, f->sizelineinfo, uint8_t, f->memcat);
+        memcpy(lineinfo, f->lineinfo, f->sizelineinfo);
+    }
+
+    // native code and the interpreter entry refer to the old instruction array
+    if (f->codeentry == f->code)
+        f->codeentry = code;
+
+    if (f->lineinfo)
+        f->abslineinfo = (int*)(lineinfo + ((uint8_t*)f->abslineinfo - f->lineinfo));
+
+    f->code = code;
+    f->lineinfo = lineinfo;
+
+    luau_releaseimage(f->image);
+    f->image = NULL;
+}
+
 void luaF_freeproto(lua_State* L, Proto* f, lua_Page* page)
 {
-    luaM_freearray(L, f->code, f->sizecode, Instruction, f->memcat);
+    if (f->image)
+    {
+        luau_releaseimage(f->image);
+    }
+    else
+    {
+        luaM_freearray(L, f->code, f->sizecode, Instruction, f->memcat);
+        if (f->lineinfo)
+            luaM_freearray(L, f->lineinfo, f->sizelineinfo, uint8_t, f->memcat);
+    }
+
     luaM_freearray(L, f->p, f->sizep, Proto*, f->memcat);
     luaM_freearray(L, f->k, f->sizek, TValue, f->memcat);
-    if (f->lineinfo)
-        luaM_freearray(L, f->lineinfo, f->sizelineinfo, uint8_t, f->memcat);
+    if (f->inlinecache)
+        luaM_freearray(L, f->inlinecache, f->sizeinlinecache, InlineCache, f->memcat);
+    if (f->typefeedback)
+        luaM_freearray(L, f->typefeedback, f->sizecode * 2, uint8_t, f->memcat);
     luaM_freearray(L, f->locvars, f->sizelocvars, struct LocVar, f->memcat);
     luaM_freearray(L, f->upvalues, f->sizeupvalues, TString*, f->memcat);
     if (f->debuginsn)
@@ -2,6 +2,7 @@
 // This code is based on Lua 5.x implementation licensed under MIT License; see lua_LICENSE.txt for details
 #include "lgc.h"
 
+#include "lgctraverse.h"
 #include "lobject.h"
 #include "lstate.h"
 #include "ltable.h"
@@ -17,13 +18,14 @@
 LUAU_FASTFLAG(LuauLoadTypeInfo)
 
 /*
- * Luau uses an incremental non-generational non-moving mark&sweep garbage collector.
+ * Luau uses an incremental non-moving mark&sweep garbage collector, with an optional generational mode (described at the end).
  *
  * The collector runs in three stages: mark, atomic and sweep. Mark and sweep are incremental and try to do a limited amount
  * of work every GC step; atomic is ran once per the GC cycle and is indivisible. In either case, the work happens during GC
  * steps that are "scheduled" by the GC pacing algorithm - the steps happen either from explicit calls to lua_gc, or after
  * the mutator (aka application) allocates some amount of memory, which is known as "GC assist". In either case, GC steps
- * can't happen concurrently with other access to VM state.
+ * can't happen concurrently with other access to VM state. Optionally, stages that have to run to completion (atomic and the mark
+ * during full collections) can spread gray list traversal across helper threads, see lgcparallel.cpp.
  *
  * Current GC stage is stored in global_State::gcstate, and has two additional stages for pause and second-phase mark, explained below.
  *
@@ -89,6 +91,7 @@ LUAU_FASTFLAG(LuauLoadTypeInfo)
  * mark. During sweeping we don't need to maintain the GC invariant, because our goal is to paint all objects with current white -
  * however, some barriers will still trigger (because some reachable objects are still black as sweeping didn't get to them yet), and
  * some barriers will proactively mark black objects as white to avoid extra barriers from triggering excessively.
+ * When the background sweep thread is enabled (LUA_GCSETSWEEPTHREAD), pages emptied by the sweep are returned to the system on that thread.
  *
  * Most references that GC deals with are strong, and as such they fit neatly into the incremental marking scheme. Some, however, are
  * weak - notably, tables can be marked as having weak keys/values (using __mode metafield). During incremental marking, we don't know
@@ -117,10 +120,33 @@ LUAU_FASTFLAG(LuauLoadTypeInfo)
  * as black (doing so would violate the GC invariant), and they are kept in a special global list (global_State::uvhead) which is traversed
  * during atomic phase. This is needed because an open upvalue might point to a stack location in a dead thread that never marked the stack
  * slot - upvalues like this are identified since they don't have `markedopen` bit set during thread traversal and closed in `clearupvals`.
+ *
+ * Generational mode (enabled via LUA_GCGEN) uses "sticky" marks: instead of repainting surviving objects white, the sweep that follows
+ * a generational cycle keeps their marks intact (global_State::gcsticky). Black objects that survived a cycle are old; white objects are
+ * young. The next cycle is a minor collection: since old objects are already black, marking never reaches them again and only young
+ * objects are traversed. Because the tri-color invariant is kept between cycles, any store of a young object into an old one goes
+ * through a write barrier: backward barriers put the old object on the `grayagain` list, which serves as the remembered set for the next
+ * minor collection, and forward barriers mark the young object immediately, queueing it on the `gray` list if it has references. Both
+ * lists are preserved from the end of atomic phase until the next cycle starts, and weak tables are kept on `grayagain` so that minor
+ * collections can clear their dead entries. Threads with open upvalues are also kept there because `clearupvals` relies on every live
+ * thread with open upvalues to be traversed during the cycle. Since old objects can't die in a minor collection, the sweep also skips
+ * pages that didn't receive any allocations since they were last swept and only contain old objects (see luaM_ispageyoung).
+ *
+ * Old objects are only reclaimed by a major collection, which is a regular incremental cycle that starts from an all-white heap. At the
+ * end of the mark of a minor cycle, if the heap has grown by more than the major multiplier since the last major collection, the sweep
+ * repaints all survivors white, which makes the following cycle a major one. Generational mode shares the pacing and incremental
+ * stepping with the regular mode, but minor collections are triggered once the heap grows by the minor multiplier.
  */
 
 #define GC_SWEEPPAGESTEPCOST 16
 
+// number of string table buckets moved by a sweep step while the string table is being resized, and the cost of moving one bucket
+#define GC_STRTREHASHSTEP 64
+#define GC_STRTREHASHCOST 4
+
+// smallest amount of work done by a step with a time budget, guarantees progress when the throughput estimate is off
+#define GC_MINSTEPWORK 256
+
 #define GC_INTERRUPT(state) \
     { \
         void (*interrupt)(lua_State*, int) = g->cb.interrupt; \
@@ -227,13 +253,6 @@ static void finishGcCycleMetrics(global_State* g)
 }
 #endif
 
-static void removeentry(LuaNode* n)
-{
-    LUAU_ASSERT(ttisnil(gval(n)));
-    if (iscollectable(gkey(n)))
-        setttype(gkey(n), LUA_TDEADKEY); // dead key; remove it
-}
-
 static void reallymarkobject(global_State* g, GCObject* o)
 {
     LUAU_ASSERT(iswhite(o) && !isdead(g, o));
@@ -296,6 +315,10 @@ static void reallymarkobject(global_State* g, GCObject* o)
 
 static const char* gettablemode(global_State* g, Table* h)
 {
+    // shared storage can't be cleared in place; luaH_cloneshared doesn't share weak tables, and setting a metatable unshares
+    if (luaH_isshared(h))
+        return NULL;
+
     const TValue* mode = gfasttm(g, h->metatable, TM_MODE);
 
     if (mode && ttisstring(mode))
@@ -304,13 +327,32 @@ static const char* gettablemode(global_State* g, Table* h)
     return NULL;
 }
 
+// marks references of gray objects with the regular mark primitive, see lgctraverse.h
+struct GCMarker
+{
+    global_State* g;
+
+    void mark(GCObject* o)
+    {
+        if (iswhite(o))
+            reallymarkobject(g, o);
+    }
+
+    void markstring(TString* s)
+    {
+        stringmark(s);
+    }
+
+    void removeentry(LuaNode* n)
+    {
+        removedeadkey(n);
+    }
+};
+
 static int traversetable(global_State* g, Table* h)
 {
-    int i;
     int weakkey = 0;
     int weakvalue = 0;
-    if (h->metatable)
-        markobject(g, cast_to(Table*, h->metatable));
 
     // is there a weak mode?
     if (const char* modev = gettablemode(g, h))
@@ -324,82 +366,11 @@ static int traversetable(global_State* g, Table* h)
         }
     }
 
-    if (weakkey && weakvalue)
-        return 1;
-    if (!weakvalue)
-    {
-        i = h->sizearray;
-        while (i--)
-            markvalue(g, &h->array[i]);
-    }
-    i = sizenode(h);
-    while (i--)
-    {
-        LuaNode* n = gnode(h, i);
-        LUAU_ASSERT(ttype(gkey(n)) != LUA_TDEADKEY || ttisnil(gval(n)));
-        if (ttisnil(gval(n)))
-            removeentry(n); // remove empty entries
-        else
-        {
-            LUAU_ASSERT(!ttisnil(gkey(n)));
-            if (!weakkey)
-                markvalue(g, gkey(n));
-            if (!weakvalue)
-                markvalue(g, gval(n));
-        }
-    }
+    GCMarker m = {g};
+    traversetable(m, h, weakkey, weakvalue);
     return weakkey || weakvalue;
 }
 
-/*
-** All marks are conditional because a GC may happen while the
-** prototype is still being created
-*/
-static void traverseproto(global_State* g, Proto* f)
-{
-    int i;
-    if (f->source)
-        stringmark(f->source);
-    if (f->debugname)
-        stringmark(f->debugname);
-    for (i = 0; i < f->sizek; i++) // mark literals
-        markvalue(g, &f->k[i]);
-    for (i = 0; i < f->sizeupvalues; i++)
-    { // mark upvalue names
-        if (f->upvalues[i])
-            stringmark(f->upvalues[i]);
-    }
-    for (i = 0; i < f->sizep; i++)
-    { // mark nested protos
-        if (f->p[i])
-            markobject(g, f->p[i]);
-    }
-    for (i = 0; i < f->sizelocvars; i++)
-    { // mark local-variable names
-        if (f->locvars[i].varname)
-            stringmark(f->locvars[i].varname);
-    }
-}
-
-static void traverseclosure(global_State* g, Closure* cl)
-{
-    markobject(g, cl->env);
-    if (cl->isC)
-    {
-        int i;
-        for (i = 0; i < cl->nupvalues; i++) // mark its upvalues
-            markvalue(g, &cl->c.upvals[i]);
-    }
-    else
-    {
-        int i;
-        LUAU_ASSERT(cl->nupvalues == cl->l.p->nups);
-        markobject(g, cast_to(Proto*, cl->l.p));
-        for (i = 0; i < cl->nupvalues; i++) // mark its upvalues
-            markvalue(g, &cl->l.uprefs[i]);
-    }
-}
-
 static void traversestack(global_State* g, lua_State* l)
 {
     markobject(g, l->gt);
@@ -438,11 +409,15 @@ static void shrinkstack(lua_State* L)
     int s_used = cast_int(lim - L->stack);      // part of stack in use
     if (L->size_ci > LUAI_MAXCALLS)             // handling overflow?
         return;                                 // do not touch the stacks
+    // stacks that go through the stack pool keep power of two sizes, and idle threads hand them back at once so that other threads can
+    // reuse the buffer; other threads halve the arrays every cycle
+    bool pooled = luaD_ispooledstack(L->stacksize);
+    bool idle = pooled && ci_used == 0 && s_used <= BASIC_STACK_SIZE;
     if (3 * ci_used < L->size_ci && 2 * BASIC_CI_SIZE < L->size_ci)
-        luaD_reallocCI(L, L->size_ci / 2); // still big enough...
+        luaD_reallocCI(L, idle ? BASIC_CI_SIZE : L->size_ci / 2); // still big enough...
     condhardstacktests(luaD_reallocCI(L, ci_used + 1));
     if (3 * s_used < L->stacksize && 2 * (BASIC_STACK_SIZE + EXTRA_STACK) < L->stacksize)
-        luaD_reallocstack(L, L->stacksize / 2); // still big enough...
+        luaD_reallocstack(L, idle ? BASIC_STACK_SIZE : pooled ? L->stacksize / 2 - EXTRA_STACK : L->stacksize / 2); // still big enough...
     condhardstacktests(luaD_reallocstack(L, s_used));
 }
 
@@ -469,7 +444,8 @@ static size_t propagatemark(global_State* g)
     {
         Closure* cl = gco2cl(o);
         g->gray = cl->gclist;
-        traverseclosure(g, cl);
+        GCMarker m = {g};
+        traverseclosure(m, cl);
         return cl->isC ? sizeCclosure(cl->nupvalues) : sizeLclosure(cl->nupvalues);
     }
     case LUA_TTHREAD:
@@ -505,7 +481,8 @@ static size_t propagatemark(global_State* g)
     {
         Proto* p = gco2p(o);
         g->gray = p->gclist;
-        traverseproto(g, p);
+        GCMarker m = {g};
+        traverseproto(m, p);
 
         if (FFlag::LuauLoadTypeInfo)
         {
@@ -529,7 +506,28 @@ static size_t propagateall(global_State* g)
     size_t work = 0;
     while (g->gray)
     {
-        work += propagatemark(g);
+        if (g->markpool)
+        {
+            // helper threads leave threads and tables that might be weak on the gray list, objects they reference go to the next pass
+            work += luaC_propagateparallel(g);
+
+            GCObject* deferred = g->gray;
+            g->gray = NULL;
+
+            while (GCObject* o = deferred)
+            {
+                GCObject** next = o->gch.tt == LUA_TTHREAD ? &gco2th(o)->gclist : &gco2h(o)->gclist;
+                deferred = *next;
+
+                *next = g->gray;
+                g->gray = o;
+                work += propagatemark(g);
+            }
+        }
+        else
+        {
+            work += propagatemark(g);
+        }
     }
     return work;
 }
@@ -584,7 +582,7 @@ static size_t cleartable(lua_State* L, GCObject* l)
                 if (iscleared(gkey(n)) || iscleared(gval(n)))
                 {
                     setnilvalue(gval(n)); // remove value ...
-                    removeentry(n);       // remove entry from table
+                    removedeadkey(n);     // remove entry from table
                 }
                 else
                 {
@@ -646,8 +644,8 @@ static void freeobj(lua_State* L, GCObject* o, lua_Page* page)
 static void shrinkbuffers(lua_State* L)
 {
     global_State* g = L->global;
-    // check size of string hash
-    if (g->strt.nuse < cast_to(uint32_t, g->strt.size / 4) && g->strt.size > LUA_MINSTRTABSIZE * 2)
+    // check size of string hash; a resize that is still in progress will be checked at the end of the next cycle
+    if (g->strt.nuse < cast_to(uint32_t, g->strt.size / 4) && g->strt.size > LUA_MINSTRTABSIZE * 2 && !g->strt.oldhash)
         luaS_resize(L, g->strt.size / 2); // table is too big
 }
 
@@ -679,6 +677,8 @@ void luaC_freeall(lua_State* L)
 
     for (int i = 0; i < g->strt.size; i++) // free all string lists
         LUAU_ASSERT(g->strt.hash[i] == NULL);
+    for (int i = 0; i < g->strt.oldsize; i++)
+        LUAU_ASSERT(g->strt.oldhash[i] == NULL);
 
     LUAU_ASSERT(L->global->strt.nuse == 0);
 }
@@ -695,8 +695,13 @@ static void markmt(global_State* g)
 static void markroot(lua_State* L)
 {
     global_State* g = L->global;
-    g->gray = NULL;
-    g->grayagain = NULL;
+    // minor collections start from the gray lists that were accumulated by write barriers since the end of the last cycle
+    g->gcgenminor = g->gcsticky;
+    if (!g->gcgenminor)
+    {
+        g->gray = NULL;
+        g->grayagain = NULL;
+    }
     g->weak = NULL;
     markobject(g, g->mainthread);
     // make global table be traversed before main stack
@@ -759,6 +764,29 @@ static size_t clearupvals(lua_State* L)
     return work;
 }
 
+// weak tables stay gray after the atomic phase; keep them in the remembered set so that the next minor collection clears them
+static size_t rememberweak(global_State* g)
+{
+    size_t work = 0;
+
+    for (GCObject* o = g->weak; o;)
+    {
+        Table* h = gco2h(o);
+        GCObject* next = h->gclist;
+
+        work += sizeof(Table);
+
+        LUAU_ASSERT(isgray(o));
+        h->gclist = g->grayagain;
+        g->grayagain = o;
+
+        o = next;
+    }
+
+    g->weak = NULL;
+    return work;
+}
+
 static size_t atomic(lua_State* L)
 {
     global_State* g = L->global;
@@ -783,8 +811,9 @@ static size_t atomic(lua_State* L)
     g->gray = g->weak;
     g->weak = NULL;
     LUAU_ASSERT(!iswhite(obj2gco(g->mainthread)));
-    markobject(g, L); // mark running thread
-    markmt(g);        // mark basic metatables (again)
+    markobject(g, L);          // mark running thread
+    markvalue(g, registry(L)); // mark registry (again), lua_restorestate can replace it during the cycle
+    markmt(g);                 // mark basic metatables (again)
     work += propagateall(g);
 
 #ifdef LUAI_GCMETRICS
@@ -802,7 +831,6 @@ static size_t atomic(lua_State* L)
 
     // remove collected objects from weak tables
     work += cleartable(L, g->weak);
-    g->weak = NULL;
 
 #ifdef LUAI_GCMETRICS
     g->gcmetrics.currcycle.atomictimeclear += recordGcDeltaTime(currts);
@@ -815,6 +843,21 @@ static size_t atomic(lua_State* L)
     g->gcmetrics.currcycle.atomictimeupval += recordGcDeltaTime(currts);
 #endif
 
+    // in generational mode, survivors become old unless the heap grew enough to require a major collection
+    if (g->gcgen)
+    {
+        g->gcsticky = !g->gcgenminor || g->totalbytes <= (g->gcgenmajorbase / 100) * (100 + g->gcgenmajormul);
+
+        if (g->gcsticky)
+            work += rememberweak(g);
+    }
+    else
+    {
+        g->gcsticky = 0;
+    }
+
+    g->weak = NULL;
+
     // flip current white
     g->currentwhite = cast_byte(otherwhite(g));
     g->sweepgcopage = g->allgcopages;
@@ -840,6 +883,13 @@ static int sweepgcopage(lua_State* L, lua_Page* page)
     LUAU_ASSERT(testbit(deadmask, FIXEDBIT)); // make sure we never sweep fixed objects
 
     int newwhite = luaC_white(g);
+    bool sticky = g->gcsticky;
+
+    // pages that only contain old objects can't have dead objects in generational mode
+    if (sticky && !luaM_ispageyoung(page))
+        return 1;
+
+    bool young = !sticky;
 
     for (char* pos = start; pos != end; pos += blockSize)
     {
@@ -853,8 +903,22 @@ static int sweepgcopage(lua_State* L, lua_Page* page)
         if ((gco->gch.marked ^ WHITEBITS) & deadmask)
         {
             LUAU_ASSERT(!isdead(g, gco));
-            // make it white (for next cycle)
-            gco->gch.marked = cast_byte((gco->gch.marked & maskmarks) | newwhite);
+
+            if (!sticky)
+            {
+                // make it white (for next cycle)
+                gco->gch.marked = cast_byte((gco->gch.marked & maskmarks) | newwhite);
+            }
+            else if (gco->gch.tt == LUA_TTHREAD && isblack(gco) && gco2th(gco)->openupval)
+            {
+                // old thread keeps its mark, but its open upvalues have to be revisited by the next minor collection
+                luaC_barrierback(L, gco, &gco2th(gco)->gclist);
+                young = true;
+            }
+            else if (iswhite(gco))
+            {
+                young = true;
+            }
         }
         else
         {
@@ -867,6 +931,8 @@ static int sweepgcopage(lua_State* L, lua_Page* page)
         }
     }
 
+    luaM_setpageyoung(page, young);
+
     return int(end - start) / blockSize;
 }
 
@@ -874,6 +940,10 @@ static size_t gcstep(lua_State* L, size_t limit)
 {
     size_t cost = 0;
     global_State* g = L->global;
+
+    // allocations made by the step don't count against memory category limits; if the allocator fails, the flag is reset by the next step
+    g->memcatexempt = true;
+
     switch (g->gcstate)
     {
     case GCSpause:
@@ -884,6 +954,10 @@ static size_t gcstep(lua_State* L, size_t limit)
     }
     case GCSpropagate:
     {
+        // full collections don't need to interleave the mark with the mutator and can use helper threads
+        if (limit == SIZE_MAX)
+            cost += propagateall(g);
+
         while (g->gray && cost < limit)
         {
             cost += propagatemark(g);
@@ -905,6 +979,9 @@ static size_t gcstep(lua_State* L, size_t limit)
     }
     case GCSpropagateagain:
     {
+        if (limit == SIZE_MAX)
+            cost += propagateall(g);
+
         while (g->gray && cost < limit)
         {
             cost += propagatemark(g);
@@ -930,6 +1007,7 @@ static size_t gcstep(lua_State* L, size_t limit)
 
         g->gcstats.atomicstarttimestamp = lua_clock();
         g->gcstats.atomicstarttotalsizebytes = g->totalbytes;
+        memcpy(g->memcatatomicbytes, g->memcatbytes, sizeof(g->memcatbytes));
 
         cost = atomic(L); // finish mark phase
 
@@ -938,6 +1016,10 @@ static size_t gcstep(lua_State* L, size_t limit)
     }
     case GCSsweep:
     {
+        // sweep also moves strings to the new bucket array when the string table is being resized
+        if (g->strt.oldhash)
+            cost += luaS_rehash(L, GC_STRTREHASHSTEP) * GC_STRTREHASHCOST;
+
         while (g->sweepgcopage && cost < limit)
         {
             lua_Page* next = luaM_getnextpage(g->sweepgcopage); // page sweep might destroy the page
@@ -953,7 +1035,8 @@ static size_t gcstep(lua_State* L, size_t limit)
         {
             // don't forget to visit main thread, it's the only object not allocated in GCO pages
             LUAU_ASSERT(!isdead(g, obj2gco(g->mainthread)));
-            makewhite(g, obj2gco(g->mainthread)); // make it white (for next cycle)
+            if (!g->gcsticky)
+                makewhite(g, obj2gco(g->mainthread)); // make it white (for next cycle)
 
             shrinkbuffers(L);
 
@@ -964,9 +1047,20 @@ static size_t gcstep(lua_State* L, size_t limit)
     default:
         LUAU_ASSERT(!"Unexpected GC state");
     }
+
+    g->memcatexempt = false;
     return cost;
 }
 
+static size_t getheapgoal(global_State* g)
+{
+    // minor collections only need to process objects allocated since the end of the last cycle
+    if (g->gcsticky)
+        return (g->totalbytes / 100) * (100 + g->gcgenminormul);
+
+    return (g->totalbytes / 100) * g->gcgoal;
+}
+
 static int64_t getheaptriggererroroffset(global_State* g)
 {
     // adjust for error using Proportional-Integral controller
@@ -1021,11 +1115,56 @@ static size_t getheaptrigger(global_State* g, size_t heapgoal)
     return heaptrigger < int64_t(g->totalbytes) ? g->totalbytes : (heaptrigger > int64_t(heapgoal) ? heapgoal : size_t(heaptrigger));
 }
 
-size_t luaC_step(lua_State* L, bool assist)
+// with a step time budget, the amount of work is derived from the throughput measured in earlier steps of the same phase
+// steps that do less work than gcstepsize move the threshold forward by a smaller amount, so the collector keeps pace with the
+// allocations by running more frequent short steps instead of longer ones
+static int getsteptimelimit(global_State* g, int lim)
+{
+    double rate = g->gcstate == GCSsweep ? g->gcsweeprate : g->gcmarkrate;
+
+    // until the phase is measured, use the regular step size
+    if (rate == 0)
+        return lim;
+
+    double work = g->gcsteptime * rate / 1e6;
+
+    return work < GC_MINSTEPWORK ? GC_MINSTEPWORK : work > INT_MAX ? INT_MAX : int(work);
+}
+
+int luaC_steplimit(lua_State* L)
 {
     global_State* g = L->global;
 
     int lim = g->gcstepsize * g->gcstepmul / 100; // how much to work
+
+    if (g->gcsteptime)
+        lim = getsteptimelimit(g, lim);
+
+    return lim;
+}
+
+void luaC_recordsteprate(lua_State* L, int state, size_t work, double duration)
+{
+    global_State* g = L->global;
+
+    // pause and atomic stages can't be split into smaller steps and don't contribute to the estimate
+    double* rate = state == GCSsweep ? &g->gcsweeprate : (state == GCSpropagate || state == GCSpropagateagain) ? &g->gcmarkrate : NULL;
+
+    if (!rate || work == 0 || duration <= 0)
+        return;
+
+    double sample = work / duration;
+
+    // exponential moving average smooths out the variance between individual steps
+    *rate = *rate == 0 ? sample : *rate * 0.75 + sample * 0.25;
+}
+
+size_t luaC_step(lua_State* L, bool assist)
+{
+    global_State* g = L->global;
+
+    int lim = luaC_steplimit(L);
+
     LUAU_ASSERT(g->totalbytes >= g->GCthreshold);
     size_t debt = g->totalbytes - g->GCthreshold;
 
@@ -1044,8 +1183,13 @@ size_t luaC_step(lua_State* L, bool assist)
 
     int lastgcstate = g->gcstate;
 
+    double steptimestamp = g->gcsteptime ? lua_clock() : 0.0;
+
     size_t work = gcstep(L, lim);
 
+    if (g->gcsteptime)
+        luaC_recordsteprate(L, lastgcstate, work, lua_clock() - steptimestamp);
+
 #ifdef LUAI_GCMETRICS
     recordGcStateStep(g, lastgcstate, lua_clock() - lasttimestamp, assist, work);
 #endif
@@ -1055,8 +1199,11 @@ size_t luaC_step(lua_State* L, bool assist)
     // at the end of the last cycle
     if (g->gcstate == GCSpause)
     {
+        if (g->gcgen && !g->gcgenminor)
+            g->gcgenmajorbase = g->totalbytes;
+
         // at the end of a collection cycle, set goal based on gcgoal setting
-        size_t heapgoal = (g->totalbytes / 100) * g->gcgoal;
+        size_t heapgoal = getheapgoal(g);
         size_t heaptrigger = getheaptrigger(g, heapgoal);
 
         g->GCthreshold = heaptrigger;
@@ -1064,6 +1211,7 @@ size_t luaC_step(lua_State* L, bool assist)
         g->gcstats.heapgoalsizebytes = heapgoal;
         g->gcstats.endtimestamp = lua_clock();
         g->gcstats.endtotalsizebytes = g->totalbytes;
+        memcpy(g->memcatendbytes, g->memcatbytes, sizeof(g->memcatbytes));
 
 #ifdef LUAI_GCMETRICS
         finishGcCycleMetrics(g);
@@ -1092,14 +1240,15 @@ void luaC_fullgc(lua_State* L)
         startGcCycleMetrics(g);
 #endif
 
-    if (keepinvariant(g))
+    if (keepinvariant(g) || g->gcsticky)
     {
-        // reset sweep marks to sweep all elements (returning them to white)
+        // reset sweep marks to sweep all elements (returning them to white, including old objects in generational mode)
         g->sweepgcopage = g->allgcopages;
         // reset other collector lists
         g->gray = NULL;
         g->grayagain = NULL;
         g->weak = NULL;
+        g->gcsticky = 0;
         g->gcstate = GCSsweep;
     }
     LUAU_ASSERT(g->gcstate == GCSpause || g->gcstate == GCSsweep);
@@ -1130,8 +1279,14 @@ void luaC_fullgc(lua_State* L)
     }
     // reclaim as much buffer memory as possible (shrinkbuffers() called during sweep is incremental)
     shrinkbuffersfull(L);
+    // stack buffers and thread arrays kept for reuse are released as well
+    luaD_flushstackpool(L);
+    luaE_flushthreadpool(L);
+
+    if (g->gcgen)
+        g->gcgenmajorbase = g->totalbytes;
 
-    size_t heapgoalsizebytes = (g->totalbytes / 100) * g->gcgoal;
+    size_t heapgoalsizebytes = getheapgoal(g);
 
     // trigger cannot be correctly adjusted after a forced full GC.
     // we will try to place it so that we can reach the goal based on
@@ -1144,6 +1299,10 @@ void luaC_fullgc(lua_State* L)
     if (g->GCthreshold < g->totalbytes)
         g->GCthreshold = g->totalbytes;
 
+    // in generational mode, the next minor collection starts once the young generation is large enough
+    if (g->gcsticky)
+        g->GCthreshold = heapgoalsizebytes;
+
     g->gcstats.heapgoalsizebytes = heapgoalsizebytes;
 
 #ifdef LUAI_GCMETRICS
@@ -1155,9 +1314,9 @@ void luaC_barrierf(lua_State* L, GCObject* o, GCObject* v)
 {
     global_State* g = L->global;
     LUAU_ASSERT(isblack(o) && iswhite(v) && !isdead(g, v) && !isdead(g, o));
-    LUAU_ASSERT(g->gcstate != GCSpause);
-    // must keep invariant?
-    if (keepinvariant(g))
+    LUAU_ASSERT(g->gcstate != GCSpause || g->gcsticky);
+    // must keep invariant? (old objects in generational mode must never point to young objects outside of the remembered set)
+    if (keepinvariant(g) || g->gcsticky)
         reallymarkobject(g, v); // restore invariant
     else                        // don't mind
         makewhite(g, o);        // mark as white just to avoid other barriers
@@ -1177,7 +1336,7 @@ void luaC_barriertable(lua_State* L, Table* t, GCObject* v)
     }
 
     LUAU_ASSERT(isblack(o) && !isdead(g, o));
-    LUAU_ASSERT(g->gcstate != GCSpause);
+    LUAU_ASSERT(g->gcstate != GCSpause || g->gcsticky);
     black2gray(o); // make table gray (again)
     t->gclist = g->grayagain;
     g->grayagain = o;
@@ -1187,7 +1346,7 @@ void luaC_barrierback(lua_State* L, GCObject* o, GCObject** gclist)
 {
     global_State* g = L->global;
     LUAU_ASSERT(isblack(o) && !isdead(g, o));
-    LUAU_ASSERT(g->gcstate != GCSpause);
+    LUAU_ASSERT(g->gcstate != GCSpause || g->gcsticky);
 
     black2gray(o); // make object gray (again)
     *gclist = g->grayagain;
@@ -1203,7 +1362,7 @@ void luaC_upvalclosed(lua_State* L, UpVal* uv)
 
     if (isgray(o))
     {
-        if (keepinvariant(g))
+        if (keepinvariant(g) || g->gcsticky)
         {
             gray2black(o); // closed upvalues need barrier
             luaC_barrier(L, uv, uv->v);
@@ -1216,6 +1375,17 @@ void luaC_upvalclosed(lua_State* L, UpVal* uv)
     }
 }
 
+void luaC_setgenerational(lua_State* L, bool enabled)
+{
+    global_State* g = L->global;
+
+    g->gcgen = enabled;
+
+    // old objects are only recognized by the generational mode; a full collection returns them to white
+    if (!enabled && g->gcsticky)
+        luaC_fullgc(L);
+}
+
 // measure the allocation rate in bytes/sec
 // returns -1 if allocation rate cannot be measured
 int64_t luaC_allocationrate(lua_State* L)
@@ -1242,6 +1412,36 @@ int64_t luaC_allocationrate(lua_State* L)
     return int64_t((g->gcstats.atomicstarttotalsizebytes - g->gcstats.endtotalsizebytes) / duration);
 }
 
+// category can shrink outside of the sweep when memory is freed explicitly, which is reported as no growth
+static int64_t memcatgrowth(size_t current, size_t start, double duration)
+{
+    return current > start ? int64_t((current - start) / duration) : 0;
+}
+
+int64_t luaC_memcatallocationrate(lua_State* L, uint8_t memcat)
+{
+    global_State* g = L->global;
+    const double durationthreshold = 1e-3; // avoid measuring intervals smaller than 1ms
+
+    if (g->gcstate <= GCSatomic)
+    {
+        double duration = lua_clock() - g->gcstats.endtimestamp;
+
+        if (duration < durationthreshold)
+            return -1;
+
+        return memcatgrowth(g->memcatbytes[memcat], g->memcatendbytes[memcat], duration);
+    }
+
+    // memory use is unstable during the sweep, use the rate measured at the end of mark phase
+    double duration = g->gcstats.atomicstarttimestamp - g->gcstats.endtimestamp;
+
+    if (duration < durationthreshold)
+        return -1;
+
+    return memcatgrowth(g->memcatatomicbytes[memcat], g->memcatendbytes[memcat], duration);
+}
+
 const char* luaC_statename(int state)
 {
     switch (state)
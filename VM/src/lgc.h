@@ -13,6 +13,12 @@
 #define LUAI_GCSTEPMUL 200 // GC runs 'twice the speed' of memory allocation
 #define LUAI_GCSTEPSIZE 1  // GC runs every KB of memory allocation
 
+/*
+** Default settings for generational mode tunables (settable via lua_gc)
+*/
+#define LUAI_GCGENMINORMUL 20  // minor collection starts after the heap grows by 20% since the end of the last cycle
+#define LUAI_GCGENMAJORMUL 100 // major collection is performed after the heap grows by 100% since the last major collection
+
 /*
 ** Possible states of the Garbage Collector
 */
@@ -128,7 +134,12 @@
 
 LUAI_FUNC void luaC_freeall(lua_State* L);
 LUAI_FUNC size_t luaC_step(lua_State* L, bool assist);
+LUAI_FUNC int luaC_steplimit(lua_State* L);
+LUAI_FUNC void luaC_recordsteprate(lua_State* L, int state, size_t work, double duration);
 LUAI_FUNC void luaC_fullgc(lua_State* L);
+LUAI_FUNC void luaC_setgenerational(lua_State* L, bool enabled);
+LUAI_FUNC int luaC_setmarkworkers(lua_State* L, int count);
+LUAI_FUNC size_t luaC_propagateparallel(global_State* g);
 LUAI_FUNC void luaC_initobj(lua_State* L, GCObject* o, uint8_t tt);
 LUAI_FUNC void luaC_upvalclosed(lua_State* L, UpVal* uv);
 LUAI_FUNC void luaC_barrierf(lua_State* L, GCObject* o, GCObject* v);
@@ -139,5 +150,7 @@ LUAI_FUNC void luaC_dump(lua_State* L, void* file, const char* (*categoryName)(l
 LUAI_FUNC void luaC_enumheap(lua_State* L, void* context,
     void (*node)(void* context, void* ptr, uint8_t tt, uint8_t memcat, size_t size, const char* name),
     void (*edge)(void* context, void* from, void* to, const char* name));
+LUAI_FUNC void luaC_heapsnapshot(lua_State* L, void* ud, void (*writer)(void* ud, const void* data, size_t size));
 LUAI_FUNC int64_t luaC_allocationrate(lua_State* L);
+LUAI_FUNC int64_t luaC_memcatallocationrate(lua_State* L, uint8_t memcat);
 LUAI_FUNC const char* luaC_statename(int state);
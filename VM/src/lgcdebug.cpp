@@ -2,6 +2,7 @@
 // This code is based on Lua 5.x implementation licensed under MIT License; see lua_LICENSE.txt for details
 #include "lgc.h"
 
+#include "ldo.h"
 #include "lfunc.h"
 #include "lmem.h"
 #include "lobject.h"
@@ -18,9 +19,10 @@ static void validateobjref(global_State* g, GCObject* f, GCObject* t)
 {
     LUAU_ASSERT(!isdead(g, t));
 
-    if (keepinvariant(g))
+    if (keepinvariant(g) || g->gcsticky)
     {
         // basic incremental invariant: black can't point to white
+        // in generational mode, it is preserved between cycles so that old objects never point to young objects
         LUAU_ASSERT(!(isblack(f) && iswhite(t)));
     }
 }
@@ -185,7 +187,7 @@ static void validateobj(global_State* g, GCObject* o)
 
 static void validategraylist(global_State* g, GCObject* o)
 {
-    if (!keepinvariant(g))
+    if (!keepinvariant(g) && !g->gcsticky)
         return;
 
     while (o)
@@ -903,3 +905,475 @@ void luaC_enumheap(lua_State* L, void* context, void (*node)(void* context, void
 
     luaM_visitgco(L, &ctx, enumgco);
 }
+
+/*
+ * Heap snapshot is a compact binary stream that describes all objects in the heap, the references between them, and names for the objects
+ * that can be found by walking string keys of tables starting from the registry and the globals of the main thread. It's designed to be
+ * written in one linear pass over heap pages, and to be compared offline with another snapshot of the same state.
+ *
+ * All integers are encoded as unsigned LEB128; object ids are object addresses, so they are stable between snapshots of the same state as
+ * long as the object is alive. The stream has the following structure:
+ *
+ * header: 'L' 'H' 'S' 0, version
+ * object: HSR_OBJECT, id, type, memory category, size, ids of referenced objects, 0
+ * name:   HSR_NAME, id, length, data (names of C functions and function prototypes)
+ * path:   HSR_PATH, id, length, data (shortest chain of string keys that leads to the table or function from one of the roots)
+ * root:   HSR_ROOT, id, length, data
+ * end:    HSR_END, total size of the heap in bytes
+ *
+ * Weak references are not recorded since they don't keep objects alive.
+ */
+
+#define LUAI_HEAPSNAPSHOT_VERSION 1
+
+enum HeapSnapshotRecord
+{
+    HSR_END,
+    HSR_OBJECT,
+    HSR_NAME,
+    HSR_PATH,
+    HSR_ROOT,
+};
+
+struct SnapshotWriter
+{
+    lua_State* L;
+    void (*writer)(void* ud, const void* data, size_t size);
+    void* ud;
+
+    int namedobjects; // number of objects that can get a path name
+
+    size_t pos;
+    uint8_t buffer[4096];
+};
+
+static void snapshotflush(SnapshotWriter* w)
+{
+    if (w->pos)
+    {
+        w->writer(w->ud, w->buffer, w->pos);
+        w->pos = 0;
+    }
+}
+
+static void snapshotint(SnapshotWriter* w, uint64_t value)
+{
+    if (w->pos + 10 > sizeof(w->buffer))
+        snapshotflush(w);
+
+    do
+    {
+        uint8_t byte = value & 127;
+        value >>= 7;
+        w->buffer[w->pos++] = byte | (value ? 128 : 0);
+    } while (value);
+}
+
+static void snapshotstring(SnapshotWriter* w, const char* data, size_t len)
+{
+    snapshotint(w, len);
+
+    while (len)
+    {
+        if (w->pos == sizeof(w->buffer))
+            snapshotflush(w);
+
+        size_t chunk = sizeof(w->buffer) - w->pos < len ? sizeof(w->buffer) - w->pos : len;
+        memcpy(w->buffer + w->pos, data, chunk);
+
+        w->pos += chunk;
+        data += chunk;
+        len -= chunk;
+    }
+}
+
+static void snapshotref(SnapshotWriter* w, GCObject* o)
+{
+    snapshotint(w, uintptr_t(o));
+}
+
+static void snapshotrefs(SnapshotWriter* w, TValue* data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (iscollectable(&data[i]))
+            snapshotref(w, gcvalue(&data[i]));
+    }
+}
+
+static void snapshotname(SnapshotWriter* w, int record, GCObject* o, const char* name)
+{
+    snapshotint(w, record);
+    snapshotref(w, o);
+    snapshotstring(w, name, strlen(name));
+}
+
+static void snapshotheader(SnapshotWriter* w, GCObject* o, size_t size)
+{
+    snapshotint(w, HSR_OBJECT);
+    snapshotref(w, o);
+    snapshotint(w, o->gch.tt);
+    snapshotint(w, o->gch.memcat);
+    snapshotint(w, size);
+}
+
+static void snapshottable(SnapshotWriter* w, Table* h)
+{
+    size_t size = sizeof(Table) + (h->node == &luaH_dummynode ? 0 : sizenode(h) * sizeof(LuaNode)) + h->sizearray * sizeof(TValue);
+
+    snapshotheader(w, obj2gco(h), size);
+
+    bool weakkey = false;
+    bool weakvalue = false;
+
+    if (const TValue* mode = gfasttm(w->L->global, h->metatable, TM_MODE))
+    {
+        if (ttisstring(mode))
+        {
+            weakkey = strchr(svalue(mode), 'k') != NULL;
+            weakvalue = strchr(svalue(mode), 'v') != NULL;
+        }
+    }
+
+    if (h->node != &luaH_dummynode)
+    {
+        for (int i = 0; i < sizenode(h); ++i)
+        {
+            const LuaNode& n = h->node[i];
+
+            if (ttisnil(&n.val))
+                continue;
+
+            if (!weakkey && iscollectable(&n.key))
+                snapshotref(w, gcvalue(&n.key));
+
+            if (!weakvalue && iscollectable(&n.val))
+                snapshotref(w, gcvalue(&n.val));
+        }
+    }
+
+    if (!weakvalue)
+        snapshotrefs(w, h->array, h->sizearray);
+
+    if (h->metatable)
+        snapshotref(w, obj2gco(h->metatable));
+}
+
+static void snapshotclosure(SnapshotWriter* w, Closure* cl)
+{
+    snapshotheader(w, obj2gco(cl), cl->isC ? sizeCclosure(cl->nupvalues) : sizeLclosure(cl->nupvalues));
+
+    snapshotref(w, obj2gco(cl->env));
+
+    if (cl->isC)
+    {
+        snapshotrefs(w, cl->c.upvals, cl->nupvalues);
+    }
+    else
+    {
+        snapshotref(w, obj2gco(cl->l.p));
+        snapshotrefs(w, cl->l.uprefs, cl->nupvalues);
+    }
+}
+
+static void snapshotthread(SnapshotWriter* w, lua_State* th)
+{
+    size_t size = sizeof(lua_State) + sizeof(TValue) * th->stacksize + sizeof(CallInfo) * th->size_ci;
+
+    snapshotheader(w, obj2gco(th), size);
+
+    snapshotref(w, obj2gco(th->gt));
+
+    if (th->namecall)
+        snapshotref(w, obj2gco(th->namecall));
+
+    snapshotrefs(w, th->stack, th->top - th->stack);
+
+    for (UpVal* uv = th->openupval; uv; uv = uv->u.open.threadnext)
+        snapshotref(w, obj2gco(uv));
+}
+
+static void snapshotproto(SnapshotWriter* w, Proto* p)
+{
+    size_t size = sizeof(Proto) + sizeof(Instruction) * p->sizecode + sizeof(Proto*) * p->sizep + sizeof(TValue) * p->sizek + p->sizelineinfo +
+                  sizeof(LocVar) * p->sizelocvars + sizeof(TString*) * p->sizeupvalues + p->sizetypeinfo;
+
+    if (p->execdata && w->L->global->ecb.getmemorysize)
+        size += w->L->global->ecb.getmemorysize(w->L, p);
+
+    snapshotheader(w, obj2gco(p), size);
+
+    snapshotrefs(w, p->k, p->sizek);
+
+    for (int i = 0; i < p->sizep; ++i)
+        snapshotref(w, obj2gco(p->p[i]));
+
+    if (p->source)
+        snapshotref(w, obj2gco(p->source));
+
+    if (p->debugname)
+        snapshotref(w, obj2gco(p->debugname));
+
+    for (int i = 0; i < p->sizeupvalues; ++i)
+        if (p->upvalues[i])
+            snapshotref(w, obj2gco(p->upvalues[i]));
+
+    for (int i = 0; i < p->sizelocvars; ++i)
+        if (p->locvars[i].varname)
+            snapshotref(w, obj2gco(p->locvars[i].varname));
+}
+
+static void snapshotobj(SnapshotWriter* w, GCObject* o)
+{
+    switch (o->gch.tt)
+    {
+    case LUA_TSTRING:
+        snapshotheader(w, o, sizestring(gco2ts(o)->len));
+        break;
+
+    case LUA_TTABLE:
+        snapshottable(w, gco2h(o));
+        w->namedobjects++;
+        break;
+
+    case LUA_TFUNCTION:
+        snapshotclosure(w, gco2cl(o));
+        w->namedobjects++;
+        break;
+
+    case LUA_TUSERDATA:
+        snapshotheader(w, o, sizeudata(gco2u(o)->len));
+        if (gco2u(o)->metatable)
+            snapshotref(w, obj2gco(gco2u(o)->metatable));
+        break;
+
+    case LUA_TTHREAD:
+        snapshotthread(w, gco2th(o));
+        break;
+
+    case LUA_TBUFFER:
+        snapshotheader(w, o, sizebuffer(gco2buf(o)->len));
+        break;
+
+    case LUA_TPROTO:
+        snapshotproto(w, gco2p(o));
+        break;
+
+    case LUA_TUPVAL:
+        snapshotheader(w, o, sizeof(UpVal));
+        if (iscollectable(gco2uv(o)->v))
+            snapshotref(w, gcvalue(gco2uv(o)->v));
+        break;
+
+    default:
+        LUAU_ASSERT(!"Unknown object tag");
+    }
+
+    snapshotint(w, 0); // end of references
+
+    // names that don't depend on the object graph are written right after the object
+    if (o->gch.tt == LUA_TFUNCTION && gco2cl(o)->isC && gco2cl(o)->c.debugname)
+    {
+        snapshotname(w, HSR_NAME, o, gco2cl(o)->c.debugname);
+    }
+    else if (o->gch.tt == LUA_TPROTO)
+    {
+        Proto* p = gco2p(o);
+        char buf[LUA_IDSIZE];
+
+        if (p->source)
+            snprintf(buf, sizeof(buf), "%s:%d %s", p->debugname ? getstr(p->debugname) : "", p->linedefined, getstr(p->source));
+        else
+            snprintf(buf, sizeof(buf), "%s:%d", p->debugname ? getstr(p->debugname) : "", p->linedefined);
+
+        snapshotname(w, HSR_NAME, o, buf);
+    }
+}
+
+static bool snapshotgco(void* context, lua_Page* page, GCObject* gco)
+{
+    SnapshotWriter* w = (SnapshotWriter*)context;
+
+    // objects that are waiting to be swept are unreachable
+    if (isdead(w->L->global, gco))
+        return false;
+
+    snapshotobj(w, gco);
+    return false;
+}
+
+struct SnapshotPathEntry
+{
+    GCObject* o;
+    int parent;      // index of the entry this one was reached from, -1 for roots
+    const char* key; // key in the parent table (or name of the root)
+    size_t keylen;
+};
+
+// open addressing set of objects that already got a name
+static bool snapshotvisit(GCObject** set, size_t mask, GCObject* o)
+{
+    size_t pos = (uintptr_t(o) >> 3) & mask;
+
+    while (set[pos])
+    {
+        if (set[pos] == o)
+            return false;
+
+        pos = (pos + 1) & mask;
+    }
+
+    set[pos] = o;
+    return true;
+}
+
+static void snapshotpath(SnapshotWriter* w, SnapshotPathEntry* entries, int index)
+{
+    char buf[256];
+    size_t pos = sizeof(buf) - 1;
+    buf[pos] = 0;
+
+    // names are assembled back to front by walking the chain of parents
+    for (int i = index; i >= 0; i = entries[i].parent)
+    {
+        const SnapshotPathEntry& e = entries[i];
+        size_t len = e.keylen + (e.parent >= 0 ? 1 : 0);
+
+        if (len + 3 > pos)
+        {
+            buf[--pos] = '.';
+            buf[--pos] = '.';
+            buf[--pos] = '.';
+            break;
+        }
+
+        pos -= len;
+        buf[pos] = '.';
+        memcpy(buf + pos + (e.parent >= 0 ? 1 : 0), e.key, e.keylen);
+    }
+
+    snapshotname(w, HSR_PATH, entries[index].o, buf + pos);
+}
+
+struct SnapshotPaths
+{
+    SnapshotWriter* w;
+
+    SnapshotPathEntry* entries;
+    int capacity;
+
+    GCObject** set;
+    size_t setsize;
+};
+
+static void snapshotpathwalk(lua_State* L, void* ud)
+{
+    SnapshotPaths* s = (SnapshotPaths*)ud;
+    global_State* g = L->global;
+
+    SnapshotPathEntry* entries = s->entries;
+    size_t mask = s->setsize - 1;
+    int count = 0;
+
+    // breadth-first search assigns the shortest path from the roots to each object
+    if (snapshotvisit(s->set, mask, gcvalue(registry(L))))
+        entries[count++] = {gcvalue(registry(L)), -1, "registry", 8};
+
+    if (snapshotvisit(s->set, mask, obj2gco(g->mainthread->gt)))
+        entries[count++] = {obj2gco(g->mainthread->gt), -1, "_G", 2};
+
+    for (int i = 0; i < count; ++i)
+    {
+        GCObject* o = entries[i].o;
+
+        if (entries[i].parent >= 0)
+            snapshotpath(s->w, entries, i);
+
+        if (o->gch.tt != LUA_TTABLE)
+            continue;
+
+        Table* h = gco2h(o);
+
+        if (h->node == &luaH_dummynode)
+            continue;
+
+        const TValue* mode = gfasttm(g, h->metatable, TM_MODE);
+
+        if (mode && ttisstring(mode) && strchr(svalue(mode), 'v'))
+            continue;
+
+        for (int j = 0; j < sizenode(h); ++j)
+        {
+            LuaNode* n = &h->node[j];
+
+            if (!ttisstring(&n->key) || !(ttistable(&n->val) || ttisfunction(&n->val)))
+                continue;
+
+            if (snapshotvisit(s->set, mask, gcvalue(&n->val)))
+            {
+                LUAU_ASSERT(count < s->capacity);
+                entries[count++] = {gcvalue(&n->val), i, svalue(&n->key), tsvalue(&n->key)->len};
+            }
+        }
+    }
+}
+
+static void snapshotpaths(SnapshotWriter* w)
+{
+    lua_State* L = w->L;
+
+    // each table and function gets at most one entry; two extra entries are for the roots
+    int capacity = w->namedobjects + 2;
+
+    size_t setsize = 16;
+    while (setsize < size_t(capacity) * 2)
+        setsize *= 2;
+
+    // both arrays share one allocation, so a failed allocation leaves nothing to free
+    size_t bytes = sizeof(SnapshotPathEntry) * capacity + sizeof(GCObject*) * setsize;
+    char* block = luaM_newarray(L, bytes, char, 0);
+
+    SnapshotPaths s = {w, (SnapshotPathEntry*)block, capacity, (GCObject**)(block + sizeof(SnapshotPathEntry) * capacity), setsize};
+    memset(s.set, 0, sizeof(GCObject*) * setsize);
+
+    // the writer may throw; the temporary arrays are released before the error is propagated
+    int status = luaD_rawrunprotected(L, snapshotpathwalk, &s);
+
+    luaM_freearray(L, block, bytes, char, 0);
+
+    if (status != 0)
+        luaD_throw(L, status);
+}
+
+void luaC_heapsnapshot(lua_State* L, void* ud, void (*writer)(void* ud, const void* data, size_t size))
+{
+    global_State* g = L->global;
+
+    SnapshotWriter writerstate;
+    SnapshotWriter* w = &writerstate;
+    w->L = L;
+    w->writer = writer;
+    w->ud = ud;
+    w->namedobjects = 0;
+    w->pos = 0;
+
+    static const char magic[] = {'L', 'H', 'S', 0};
+
+    for (char ch : magic)
+        w->buffer[w->pos++] = uint8_t(ch);
+
+    snapshotint(w, LUAI_HEAPSNAPSHOT_VERSION);
+
+    snapshotgco(w, NULL, obj2gco(g->mainthread));
+
+    luaM_visitgco(L, w, snapshotgco);
+
+    snapshotname(w, HSR_ROOT, obj2gco(g->mainthread), "mainthread");
+    snapshotname(w, HSR_ROOT, gcvalue(registry(L)), "registry");
+
+    snapshotpaths(w);
+
+    snapshotint(w, HSR_END);
+    snapshotint(w, g->totalbytes);
+    snapshotflush(w);
+}
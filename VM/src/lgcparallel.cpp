@@ -0,0 +1,616 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "lgc.h"
+
+#include "lgctraverse.h"
+#include "lobject.h"
+#include "lstate.h"
+#include "ltable.h"
+#include "lfunc.h"
+#include "lmem.h"
+
+#if LUAI_GCMAXMARKWORKERS > 0
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#endif
+
+LUAU_FASTFLAG(LuauLoadTypeInfo)
+
+/*
+ * Parallel marking
+ *
+ * When the collector has to finish marking without returning to the mutator (the atomic stage and full collections), the traversal of
+ * the gray list can be spread across a pool of helper threads. The thread running the collector participates as worker 0.
+ *
+ * Each worker owns a private stack of gray objects that is linked through `gclist' just like the regular gray list. Once the stack
+ * grows past GC_MARKPUBLISHSIZE objects, everything but the top object is published in a slot other workers can steal from; a thief
+ * takes the entire published list with a single exchange. Since the lists are intrusive, no memory is allocated during the mark.
+ *
+ * Mark bits are updated with atomic operations on GCheader::marked: a white object is claimed by the worker that clears its white
+ * bits first, and only that worker pushes the object to its stack or traverses it. Other fields of an object are only accessed by
+ * the worker that claimed it, except for table storage shared between copy-on-write clones; because of that, workers never write to the
+ * nodes they traverse, and tables with keys that have to be marked dead are recorded for the collector to fix up after the pass.
+ *
+ * Some objects are handed back to the collector, which traverses them serially and starts another parallel pass for the objects they
+ * reference. Threads are never traversed by the workers, since traversal can clear and reallocate the stack. Tables are handed back
+ * unless their metatable has cached the absence of __mode, since looking the field up updates that cache. Weak tables are always
+ * traversed serially as a result.
+ *
+ * Workers that run out of work spin for a while waiting for new published lists and then sleep until another worker publishes one;
+ * since idle workers never hold gray objects, marking is complete once all workers are idle.
+ */
+
+#if LUAI_GCMAXMARKWORKERS > 0
+
+#define GC_MARKPUBLISHSIZE 32
+#define GC_MARKIDLESPINS 64
+
+struct GCMarkWorker
+{
+    GCObject* gray;                // private stack of gray objects
+    int graycount;                 // number of objects pushed to the private stack since the last publish
+    std::atomic<GCObject*> shared; // gray objects that can be taken by any worker
+
+    GCObject* deferred; // gray threads and tables that have to be traversed by the collector
+    GCObject* deadkeys; // traversed tables with entries whose keys have to be marked dead by the collector
+
+    size_t work;
+    double time;
+
+    char padding[64]; // keep hot fields of different workers on separate cache lines
+};
+
+struct GCMarkPool
+{
+    global_State* g;
+
+    int count; // number of helper threads
+    std::thread threads[LUAI_GCMAXMARKWORKERS];
+
+    std::mutex lock;
+    std::condition_variable wake; // signals helpers that a new pass started or that the pool is shutting down
+    std::condition_variable done; // signals the collector that all helpers finished the pass
+    unsigned pass;
+    int running;
+    bool shutdown;
+
+    std::atomic<int> idle; // number of workers that ran out of work in the current pass
+
+    std::mutex sleeplock;
+    std::condition_variable published; // signals sleeping workers that new work was published or that the pass is complete
+    std::atomic<int> sleepers;         // number of workers waiting on `published'
+
+    GCMarkWorker workers[LUAI_GCMAXMARKWORKERS + 1];
+};
+
+static std::atomic<uint8_t>& markbits(GCObject* o)
+{
+    static_assert(sizeof(std::atomic<uint8_t>) == sizeof(uint8_t), "mark bits are updated in place");
+    return *reinterpret_cast<std::atomic<uint8_t>*>(&o->gch.marked);
+}
+
+// clears the white bits of the object; returns true for the one worker that turned the object gray
+static bool claimwhite(GCObject* o)
+{
+    std::atomic<uint8_t>& marked = markbits(o);
+    uint8_t bits = marked.load(std::memory_order_relaxed);
+
+    while (bits & WHITEBITS)
+    {
+        if (marked.compare_exchange_weak(bits, cast_byte(bits & ~WHITEBITS), std::memory_order_relaxed))
+            return true;
+    }
+
+    return false;
+}
+
+static void setblack(GCObject* o)
+{
+    markbits(o).fetch_or(bitmask(BLACKBIT), std::memory_order_relaxed);
+}
+
+static void markstring(TString* s)
+{
+    std::atomic<uint8_t>& marked = markbits(obj2gco(s));
+
+    if (marked.load(std::memory_order_relaxed) & WHITEBITS)
+        marked.fetch_and(cast_byte(~WHITEBITS), std::memory_order_relaxed);
+}
+
+static GCObject** getgclist(GCObject* o)
+{
+    switch (o->gch.tt)
+    {
+    case LUA_TTABLE:
+        return &gco2h(o)->gclist;
+    case LUA_TFUNCTION:
+        return &gco2cl(o)->gclist;
+    case LUA_TTHREAD:
+        return &gco2th(o)->gclist;
+    case LUA_TPROTO:
+        return &gco2p(o)->gclist;
+    default:
+        LUAU_ASSERT(!"Unexpected object in gray list");
+        return NULL;
+    }
+}
+
+static void pushgray(GCMarkWorker* w, GCObject* o)
+{
+    *getgclist(o) = w->gray;
+    w->gray = o;
+    w->graycount++;
+}
+
+static void markgco(global_State* g, GCMarkWorker* w, GCObject* o)
+{
+    if (!claimwhite(o))
+        return;
+
+    LUAU_ASSERT(!isdead(g, o));
+
+    switch (o->gch.tt)
+    {
+    case LUA_TSTRING:
+        break;
+    case LUA_TUSERDATA:
+    {
+        Table* mt = gco2u(o)->metatable;
+        setblack(o); // udata are never gray
+        if (mt)
+            markgco(g, w, obj2gco(mt));
+        break;
+    }
+    case LUA_TUPVAL:
+    {
+        UpVal* uv = gco2uv(o);
+        checkconsistency(uv->v);
+        if (iscollectable(uv->v))
+            markgco(g, w, gcvalue(uv->v));
+        if (!upisopen(uv)) // closed?
+            setblack(o);   // open upvalues are never black
+        break;
+    }
+    case LUA_TBUFFER:
+        setblack(o); // buffers are never gray
+        break;
+    case LUA_TFUNCTION:
+    case LUA_TTABLE:
+    case LUA_TTHREAD:
+    case LUA_TPROTO:
+        pushgray(w, o);
+        break;
+    default:
+        LUAU_ASSERT(0);
+    }
+}
+
+// tables that might be weak are traversed by the collector; the metatable cache is only updated by the collector and the mutator
+static bool isdeferredtable(Table* h)
+{
+    // shared storage is never cleared in place, see gettablemode in lgc.cpp
+    return h->metatable && !luaH_isshared(h) && !(h->metatable->tmcache & (1u << TM_MODE));
+}
+
+// marks references of gray objects for one worker, see lgctraverse.h
+struct GCWorkerMarker
+{
+    global_State* g;
+    GCMarkWorker* w;
+
+    // tables with shared storage can be traversed by two workers at once, so dead keys are only recorded here
+    bool deadkeys;
+
+    void mark(GCObject* o)
+    {
+        markgco(g, w, o);
+    }
+
+    void markstring(TString* s)
+    {
+        ::markstring(s);
+    }
+
+    void removeentry(LuaNode* n)
+    {
+        if (iscollectable(gkey(n)))
+            deadkeys = true;
+    }
+};
+
+// traverse the top object of the private stack; mirrors propagatemark
+static size_t propagatemark(global_State* g, GCMarkWorker* w)
+{
+    GCObject* o = w->gray;
+    LUAU_ASSERT(isgray(o));
+
+    switch (o->gch.tt)
+    {
+    case LUA_TTABLE:
+    {
+        Table* h = gco2h(o);
+        w->gray = h->gclist;
+
+        if (isdeferredtable(h))
+        {
+            h->gclist = w->deferred;
+            w->deferred = o;
+            return 0;
+        }
+
+        setblack(o);
+
+        GCWorkerMarker m = {g, w, false};
+        traversetable(m, h, false, false);
+
+        // black tables are not on any list, so gclist can link the tables that need their dead keys removed
+        if (m.deadkeys)
+        {
+            h->gclist = w->deadkeys;
+            w->deadkeys = o;
+        }
+
+        return sizeof(Table) + sizeof(TValue) * h->sizearray + sizeof(LuaNode) * sizenode(h);
+    }
+    case LUA_TFUNCTION:
+    {
+        Closure* cl = gco2cl(o);
+        w->gray = cl->gclist;
+        setblack(o);
+        GCWorkerMarker m = {g, w, false};
+        traverseclosure(m, cl);
+        return cl->isC ? sizeCclosure(cl->nupvalues) : sizeLclosure(cl->nupvalues);
+    }
+    case LUA_TTHREAD:
+    {
+        lua_State* th = gco2th(o);
+        w->gray = th->gclist;
+        th->gclist = w->deferred;
+        w->deferred = o;
+        return 0;
+    }
+    case LUA_TPROTO:
+    {
+        Proto* p = gco2p(o);
+        w->gray = p->gclist;
+        setblack(o);
+        GCWorkerMarker m = {g, w, false};
+        traverseproto(m, p);
+
+        if (FFlag::LuauLoadTypeInfo)
+        {
+            return sizeof(Proto) + sizeof(Instruction) * p->sizecode + sizeof(Proto*) * p->sizep + sizeof(TValue) * p->sizek + p->sizelineinfo +
+                   sizeof(LocVar) * p->sizelocvars + sizeof(TString*) * p->sizeupvalues + p->sizetypeinfo;
+        }
+        else
+        {
+            return sizeof(Proto) + sizeof(Instruction) * p->sizecode + sizeof(Proto*) * p->sizep + sizeof(TValue) * p->sizek + p->sizelineinfo +
+                   sizeof(LocVar) * p->sizelocvars + sizeof(TString*) * p->sizeupvalues;
+        }
+    }
+    default:
+        LUAU_ASSERT(0);
+        return 0;
+    }
+}
+
+// wakes up the workers sleeping in runworker; the counter and the state they wait for are sequentially consistent, so either the sleeper
+// sees the new state before waiting, or the waker sees the sleeper and notifies it under the lock after it started waiting
+static void wakesleepers(GCMarkPool* pool)
+{
+    if (pool->sleepers.load() == 0)
+        return;
+
+    std::unique_lock<std::mutex> guard(pool->sleeplock);
+    pool->published.notify_all();
+}
+
+// share everything but the top of the private stack if the previously published objects were taken
+static void publish(GCMarkPool* pool, GCMarkWorker* w)
+{
+    GCObject* top = w->gray;
+    GCObject** next = getgclist(top);
+
+    if (*next && !w->shared.load(std::memory_order_relaxed))
+    {
+        w->shared.store(*next);
+        *next = NULL;
+
+        wakesleepers(pool);
+    }
+
+    w->graycount = 0;
+}
+
+static bool haswork(GCMarkPool* pool, int workers)
+{
+    // sequentially consistent so that a worker going to sleep can't miss a list published concurrently, see wakesleepers
+    for (int i = 0; i < workers; i++)
+        if (pool->workers[i].shared.load())
+            return true;
+
+    return false;
+}
+
+static GCObject* takework(GCMarkPool* pool, int workers, int id)
+{
+    // take back our own published objects first to keep the traversal local
+    for (int i = 0; i < workers; i++)
+    {
+        GCMarkWorker* victim = &pool->workers[(id + i) % workers];
+
+        if (victim->shared.load(std::memory_order_relaxed))
+        {
+            if (GCObject* list = victim->shared.exchange(NULL, std::memory_order_acquire))
+                return list;
+        }
+    }
+
+    return NULL;
+}
+
+static void runworker(GCMarkPool* pool, int id)
+{
+    global_State* g = pool->g;
+    GCMarkWorker* w = &pool->workers[id];
+    int workers = pool->count + 1;
+
+#ifdef LUAI_GCMETRICS
+    double starttime = lua_clock();
+#endif
+
+    for (;;)
+    {
+        while (w->gray)
+        {
+            if (w->graycount >= GC_MARKPUBLISHSIZE)
+                publish(pool, w);
+
+            w->work += propagatemark(g, w);
+        }
+
+        if (GCObject* list = takework(pool, workers, id))
+        {
+            w->gray = list;
+            continue;
+        }
+
+        // idle workers don't hold any objects, so the mark is complete once every worker is idle
+        if (pool->idle.fetch_add(1) + 1 == workers)
+            wakesleepers(pool);
+
+        for (int spins = 0;; spins++)
+        {
+            if (pool->idle.load() == workers)
+            {
+#ifdef LUAI_GCMETRICS
+                w->time += lua_clock() - starttime;
+#endif
+                return;
+            }
+
+            if (haswork(pool, workers))
+            {
+                pool->idle.fetch_sub(1);
+                break;
+            }
+
+            if (spins < GC_MARKIDLESPINS)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> guard(pool->sleeplock);
+            pool->sleepers.fetch_add(1);
+            pool->published.wait(guard, [&] {
+                return pool->idle.load() == workers || haswork(pool, workers);
+            });
+            pool->sleepers.fetch_sub(1);
+        }
+    }
+}
+
+static void helpermain(GCMarkPool* pool, int id)
+{
+    unsigned pass = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> guard(pool->lock);
+            pool->wake.wait(guard, [&] {
+                return pool->shutdown || pool->pass != pass;
+            });
+
+            if (pool->shutdown)
+                return;
+
+            pass = pool->pass;
+        }
+
+        runworker(pool, id);
+
+        {
+            std::unique_lock<std::mutex> guard(pool->lock);
+            if (--pool->running == 0)
+                pool->done.notify_one();
+        }
+    }
+}
+
+static void stopworkers(lua_State* L, GCMarkPool* pool)
+{
+    {
+        std::unique_lock<std::mutex> guard(pool->lock);
+        pool->shutdown = true;
+    }
+    pool->wake.notify_all();
+
+    for (int i = 0; i < pool->count; i++)
+        pool->threads[i].join();
+
+    pool->~GCMarkPool();
+    luaM_free_(L, pool, sizeof(GCMarkPool), 0);
+}
+
+int luaC_setmarkworkers(lua_State* L, int count)
+{
+    global_State* g = L->global;
+    GCMarkPool* pool = g->markpool;
+    int res = pool ? pool->count : 0;
+
+    if (count < 0)
+        count = 0;
+    if (count > LUAI_GCMAXMARKWORKERS)
+        count = LUAI_GCMAXMARKWORKERS;
+
+    if (count == res)
+        return res;
+
+    if (pool)
+    {
+        g->markpool = NULL;
+        stopworkers(L, pool);
+    }
+
+    if (count == 0)
+        return res;
+
+    pool = new (luaM_new_(L, sizeof(GCMarkPool), 0)) GCMarkPool();
+    pool->g = g;
+    pool->count = 0;
+    pool->pass = 0;
+    pool->running = 0;
+    pool->shutdown = false;
+
+    for (int i = 0; i < count; i++)
+    {
+        try
+        {
+            pool->threads[i] = std::thread(helpermain, pool, i + 1);
+        }
+        catch (std::system_error&)
+        {
+            break; // run with the helpers we managed to start
+        }
+
+        pool->count++;
+    }
+
+    if (pool->count == 0)
+    {
+        stopworkers(L, pool);
+        return res;
+    }
+
+    g->markpool = pool;
+    return res;
+}
+
+size_t luaC_propagateparallel(global_State* g)
+{
+    GCMarkPool* pool = g->markpool;
+    LUAU_ASSERT(pool);
+
+    int workers = pool->count + 1;
+
+    for (int i = 0; i < workers; i++)
+    {
+        GCMarkWorker* w = &pool->workers[i];
+        w->gray = NULL;
+        w->graycount = 0;
+        w->shared.store(NULL, std::memory_order_relaxed);
+        w->deferred = NULL;
+        w->deadkeys = NULL;
+        w->work = 0;
+        w->time = 0;
+    }
+
+    // deal the gray list to the workers so that all of them have something to start with
+    int next = 0;
+    while (GCObject* o = g->gray)
+    {
+        g->gray = *getgclist(o);
+
+        *getgclist(o) = pool->workers[next].gray;
+        pool->workers[next].gray = o;
+
+        next = (next + 1) % workers;
+    }
+
+    pool->idle.store(0, std::memory_order_relaxed);
+    pool->sleepers.store(0, std::memory_order_relaxed);
+
+    {
+        std::unique_lock<std::mutex> guard(pool->lock);
+        pool->running = pool->count;
+        pool->pass++;
+    }
+    pool->wake.notify_all();
+
+    runworker(pool, 0);
+
+    {
+        std::unique_lock<std::mutex> guard(pool->lock);
+        pool->done.wait(guard, [&] {
+            return pool->running == 0;
+        });
+    }
+
+    // hand deferred objects back to the collector
+    size_t work = 0;
+
+    for (int i = 0; i < workers; i++)
+    {
+        GCMarkWorker* w = &pool->workers[i];
+        LUAU_ASSERT(!w->gray && !w->shared.load(std::memory_order_relaxed));
+
+        while (GCObject* o = w->deferred)
+        {
+            GCObject** next = getgclist(o);
+            w->deferred = *next;
+            *next = g->gray;
+            g->gray = o;
+        }
+
+        while (GCObject* o = w->deadkeys)
+        {
+            Table* h = gco2h(o);
+            w->deadkeys = h->gclist;
+
+            for (int j = 0; j < sizenode(h); j++)
+            {
+                LuaNode* n = gnode(h, j);
+                if (ttisnil(gval(n)))
+                    removedeadkey(n);
+            }
+        }
+
+        work += w->work;
+
+#ifdef LUAI_GCMETRICS
+        g->gcmetrics.currcycle.markworkertime[i] += w->time;
+        g->gcmetrics.currcycle.markworkerwork[i] += w->work;
+#endif
+    }
+
+    return work;
+}
+
+#else
+
+int luaC_setmarkworkers(lua_State* L, int count)
+{
+    return 0;
+}
+
+size_t luaC_propagateparallel(global_State* g)
+{
+    LUAU_ASSERT(!"Parallel marking is disabled");
+    return 0;
+}
+
+#endif
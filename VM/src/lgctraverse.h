@@ -0,0 +1,116 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+// This code is based on Lua 5.x implementation licensed under MIT License; see lua_LICENSE.txt for details
+#pragma once
+
+#include "lobject.h"
+#include "ltable.h"
+
+/*
+ * Traversal of gray objects is shared by the collector (lgc.cpp) and the parallel mark workers (lgcparallel.cpp), which only differ in how
+ * references are marked. The marker type provides:
+ *
+ * mark(GCObject* o): marks an object that may already be marked
+ * markstring(TString* s): marks a string
+ * removeentry(LuaNode* n): handles a table entry with a nil value, which may need its key marked dead
+ */
+
+inline void removedeadkey(LuaNode* n)
+{
+    LUAU_ASSERT(ttisnil(gval(n)));
+    if (iscollectable(gkey(n)))
+        setttype(gkey(n), LUA_TDEADKEY); // dead key; remove it
+}
+
+template<typename Marker>
+inline void traversevalue(Marker& m, const TValue* o)
+{
+    checkconsistency(o);
+    if (iscollectable(o))
+        m.mark(gcvalue(o));
+}
+
+template<typename Marker>
+inline void traversetable(Marker& m, Table* h, bool weakkey, bool weakvalue)
+{
+    if (h->metatable)
+        m.mark(obj2gco(h->metatable));
+
+    if (weakkey && weakvalue)
+        return;
+
+    int i;
+    if (!weakvalue)
+    {
+        i = h->sizearray;
+        while (i--)
+            traversevalue(m, &h->array[i]);
+    }
+    i = sizenode(h);
+    while (i--)
+    {
+        LuaNode* n = gnode(h, i);
+        LUAU_ASSERT(ttype(gkey(n)) != LUA_TDEADKEY || ttisnil(gval(n)));
+        if (ttisnil(gval(n)))
+            m.removeentry(n); // remove empty entries
+        else
+        {
+            LUAU_ASSERT(!ttisnil(gkey(n)));
+            checkconsistency(gkey(n));
+            if (!weakkey && iscollectable(gkey(n)))
+                m.mark(gcvalue(gkey(n)));
+            if (!weakvalue)
+                traversevalue(m, gval(n));
+        }
+    }
+}
+
+/*
+** All marks are conditional because a GC may happen while the
+** prototype is still being created
+*/
+template<typename Marker>
+inline void traverseproto(Marker& m, Proto* f)
+{
+    int i;
+    if (f->source)
+        m.markstring(f->source);
+    if (f->debugname)
+        m.markstring(f->debugname);
+    for (i = 0; i < f->sizek; i++) // mark literals
+        traversevalue(m, &f->k[i]);
+    for (i = 0; i < f->sizeupvalues; i++)
+    { // mark upvalue names
+        if (f->upvalues[i])
+            m.markstring(f->upvalues[i]);
+    }
+    for (i = 0; i < f->sizep; i++)
+    { // mark nested protos
+        if (f->p[i])
+            m.mark(obj2gco(f->p[i]));
+    }
+    for (i = 0; i < f->sizelocvars; i++)
+    { // mark local-variable names
+        if (f->locvars[i].varname)
+            m.markstring(f->locvars[i].varname);
+    }
+}
+
+template<typename Marker>
+inline void traverseclosure(Marker& m, Closure* cl)
+{
+    m.mark(obj2gco(cl->env));
+    if (cl->isC)
+    {
+        int i;
+        for (i = 0; i < cl->nupvalues; i++) // mark its upvalues
+            traversevalue(m, &cl->c.upvals[i]);
+    }
+    else
+    {
+        int i;
+        LUAU_ASSERT(cl->nupvalues == cl->l.p->nups);
+        m.mark(obj2gco(cl->l.p));
+        for (i = 0; i < cl->nupvalues; i++) // mark its upvalues
+            traversevalue(m, &cl->l.uprefs[i]);
+    }
+}
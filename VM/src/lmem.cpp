@@ -5,9 +5,17 @@
 #include "lstate.h"
 #include "ldo.h"
 #include "ldebug.h"
+#include "lgc.h"
 
 #include <string.h>
 
+#if LUAI_GCSWEEPTHREAD
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#endif
+
 /*
  * Luau heap uses a size-segregated page structure, with individual pages and large allocations
  * allocated using system heap (via frealloc callback).
@@ -75,6 +83,12 @@
  * memory manager doesn't currently attempt to keep unused memory around. This can result in excessive
  * allocation traffic and can be mitigated by adding a page cache in the future.
  *
+ * Optionally (see LUA_GCSETSWEEPTHREAD), GCO pages that become empty while the GC sweeps the heap are handed to a
+ * background thread which returns them to frealloc. Objects are still freed by the sweep, and all other memory,
+ * including memory freed by the mutator during the sweep, is released directly. Memory accounting is updated by
+ * the mutator immediately, so the background thread only interacts with frealloc, which has to be safe to call
+ * from multiple threads when this mode is used.
+ *
  * For both GCO and non-GCO pages, the per-page block allocation combines bump pointer style allocation
  * (lua_Page::freeNext) and per-page free list (lua_Page::freeList). We use the bump allocator to allocate
  * the contents of the page, and the free list for further reuse; this allows shorter page setup times
@@ -111,6 +125,8 @@
 #define ABISWITCH(x64, ms32, gcc32) (sizeof(void*) == 8 ? x64 : ms32)
 #endif
 
+// note: compressing GC references to 32-bit heap offsets doesn't reduce these sizes; Value also stores 64-bit numbers and the first two
+// vector components, so TValue stays at 16 bytes (value, extra, tt) and LuaNode at 32 bytes. only headers of GC objects could shrink
 #if LUA_VECTOR_SIZE == 4
 static_assert(sizeof(TValue) == ABISWITCH(24, 24, 24), "size mismatch for value");
 static_assert(sizeof(LuaNode) == ABISWITCH(48, 48, 48), "size mismatch for table entry");
@@ -217,6 +233,8 @@ struct lua_Page
     int freeNext;   // next free block offset in this page, in bytes; when negative, freeList is used instead
     int busyBlocks; // number of blocks allocated out of this page
 
+    bool young; // GCO page may contain objects that were allocated after the last generational sweep of this page
+
     union
     {
         char data[1];
@@ -259,6 +277,8 @@ static lua_Page* newpage(lua_State* L, lua_Page** pageset, int pageSize, int blo
     page->freeNext = (blockCount - 1) * blockSize;
     page->busyBlocks = 0;
 
+    page->young = true;
+
     if (pageset)
     {
         page->listnext = *pageset;
@@ -305,6 +325,78 @@ LUAU_NOINLINE static lua_Page* newclasspage(lua_State* L, lua_Page** freepageset
     }
 }
 
+#if LUAI_GCSWEEPTHREAD
+struct ReleasedBlock
+{
+    ReleasedBlock* next;
+    size_t size;
+};
+
+struct GCSweepThread
+{
+    lua_Alloc frealloc;
+    void* ud;
+
+    std::thread thread;
+
+    std::mutex lock;
+    std::condition_variable wake;
+    ReleasedBlock* pending; // blocks waiting to be returned to frealloc; linked through the freed memory itself
+    bool shutdown;
+};
+
+static void sweepthreadmain(GCSweepThread* st)
+{
+    for (;;)
+    {
+        ReleasedBlock* list;
+        bool shutdown;
+
+        {
+            std::unique_lock<std::mutex> guard(st->lock);
+            st->wake.wait(guard, [&] {
+                return st->shutdown || st->pending;
+            });
+
+            list = st->pending;
+            shutdown = st->shutdown;
+            st->pending = NULL;
+        }
+
+        while (list)
+        {
+            ReleasedBlock* next = list->next;
+            st->frealloc(st->ud, list, list->size, 0);
+            list = next;
+        }
+
+        // nothing can be queued after shutdown is requested, so the last batch has been released
+        if (shutdown)
+            return;
+    }
+}
+
+static void queuerelease(GCSweepThread* st, void* block, size_t size)
+{
+    LUAU_ASSERT(size >= sizeof(ReleasedBlock));
+
+    ReleasedBlock* rb = (ReleasedBlock*)block;
+    rb->size = size;
+
+    bool wasempty;
+
+    {
+        std::unique_lock<std::mutex> guard(st->lock);
+        rb->next = st->pending;
+        wasempty = st->pending == NULL;
+        st->pending = rb;
+    }
+
+    if (wasempty)
+        st->wake.notify_one();
+}
+#endif
+
 static void freepage(lua_State* L, lua_Page** pageset, lua_Page* page)
 {
     global_State* g = L->global;
@@ -321,6 +413,16 @@ static void freepage(lua_State* L, lua_Page** pageset, lua_Page* page)
             *pageset = page->listnext;
     }
 
+#if LUAI_GCSWEEPTHREAD
+    // GCO pages are only emptied by the sweep; these are handed to the background thread, other memory is released right away
+    if (g->sweepthread && g->gcstate == GCSsweep && pageset == &g->allgcopages)
+    {
+        ASAN_UNPOISON_MEMORY_REGION(page, sizeof(ReleasedBlock));
+        queuerelease(g->sweepthread, page, page->pageSize);
+        return;
+    }
+#endif
+
     // so long
     (*g->frealloc)(g->ud, page, page->pageSize, 0);
 }
@@ -420,6 +522,8 @@ static void* newgcoblock(lua_State* L, int sizeClass)
         page->busyBlocks++;
     }
 
+    page->young = true;
+
     // if we allocate the last block out of a page, we need to remove it from free list
     if (!page->freeList && page->freeNext < 0)
     {
@@ -503,10 +607,35 @@ static void freegcoblock(lua_State* L, int sizeClass, void* block, lua_Page* pag
         freeclasspage(L, g->freegcopages, &g->allgcopages, page, sizeClass);
 }
 
+// slow path of the memory category limit check; only called when the allocation takes the category over its soft limit
+static LUAU_NOINLINE void memcatlimit(lua_State* L, size_t nsize, uint8_t memcat)
+{
+    global_State* g = L->global;
+
+    // collector allocations (such as weak table resizes) can't fail in the middle of a step, and the step is already running
+    if (g->memcatexempt)
+        return;
+
+    if (g->memcatbytes[memcat] + nsize > g->memcathardlimit[memcat])
+        luaD_throw(L, LUA_ERRMEM);
+
+    // request an extra collector step at the next GC check; this doesn't override a stopped collector
+    if (g->GCthreshold != SIZE_MAX && g->GCthreshold > g->totalbytes)
+        g->GCthreshold = g->totalbytes;
+}
+
+static LUAU_FORCEINLINE void checkmemcatlimit(lua_State* L, global_State* g, size_t nsize, uint8_t memcat)
+{
+    if (LUAU_UNLIKELY(g->memcatbytes[memcat] + nsize > g->memcatsoftlimit[memcat]))
+        memcatlimit(L, nsize, memcat);
+}
+
 void* luaM_new_(lua_State* L, size_t nsize, uint8_t memcat)
 {
     global_State* g = L->global;
 
+    checkmemcatlimit(L, g, nsize, memcat);
+
     int nclass = sizeclass(nsize);
 
     void* block = nclass >= 0 ? newblock(L, nclass) : (*g->frealloc)(g->ud, NULL, 0, nsize);
@@ -526,6 +655,8 @@ GCObject* luaM_newgco_(lua_State* L, size_t nsize, uint8_t memcat)
 
     global_State* g = L->global;
 
+    checkmemcatlimit(L, g, nsize, memcat);
+
     int nclass = sizeclass(nsize);
 
     void* block = NULL;
@@ -601,6 +732,9 @@ void* luaM_realloc_(lua_State* L, void* block, size_t osize, size_t nsize, uint8
     global_State* g = L->global;
     LUAU_ASSERT((osize == 0) == (block == NULL));
 
+    if (nsize > osize)
+        checkmemcatlimit(L, g, nsize - osize, memcat);
+
     int nclass = sizeclass(nsize);
     int oclass = sizeclass(osize);
     void* result;
@@ -633,6 +767,16 @@ void* luaM_realloc_(lua_State* L, void* block, size_t osize, size_t nsize, uint8
     return result;
 }
 
+void luaM_movememcat_(lua_State* L, size_t size, uint8_t from, uint8_t to)
+{
+    global_State* g = L->global;
+
+    checkmemcatlimit(L, g, size, to);
+
+    g->memcatbytes[from] -= size;
+    g->memcatbytes[to] += size;
+}
+
 void luaM_getpagewalkinfo(lua_Page* page, char** start, char** end, int* busyBlocks, int* blockSize)
 {
     int blockCount = (page->pageSize - offsetof(lua_Page, data)) / page->blockSize;
@@ -655,11 +799,72 @@ void luaM_getpageinfo(lua_Page* page, int* pageBlocks, int* busyBlocks, int* blo
     *pageSize = page->pageSize;
 }
 
+bool luaM_setsweepthread(lua_State* L, bool enabled)
+{
+    global_State* g = L->global;
+
+#if LUAI_GCSWEEPTHREAD
+    GCSweepThread* st = g->sweepthread;
+
+    if (enabled == (st != NULL))
+        return enabled;
+
+    if (st)
+    {
+        g->sweepthread = NULL;
+
+        {
+            std::unique_lock<std::mutex> guard(st->lock);
+            st->shutdown = true;
+        }
+        st->wake.notify_one();
+        st->thread.join();
+
+        st->~GCSweepThread();
+        luaM_free_(L, st, sizeof(GCSweepThread), 0);
+        return true;
+    }
+
+    st = new (luaM_new_(L, sizeof(GCSweepThread), 0)) GCSweepThread();
+    st->frealloc = g->frealloc;
+    st->ud = g->ud;
+    st->pending = NULL;
+    st->shutdown = false;
+
+    try
+    {
+        st->thread = std::thread(sweepthreadmain, st);
+    }
+    catch (std::system_error&)
+    {
+        // without a thread, memory is released by the sweep itself
+        st->~GCSweepThread();
+        luaM_free_(L, st, sizeof(GCSweepThread), 0);
+        return false;
+    }
+
+    g->sweepthread = st;
+    return false;
+#else
+    return false;
+#endif
+}
+
 lua_Page* luaM_getnextpage(lua_Page* page)
 {
     return page->listnext;
 }
 
+bool luaM_ispageyoung(lua_Page* page)
+{
+    return page->young;
+}
+
+void luaM_setpageyoung(lua_Page* page, bool young)
+{
+    page->young = young;
+}
+
 void luaM_visitpage(lua_Page* page, void* context, bool (*visitor)(void* context, lua_Page* page, GCObject* gco))
 {
     char* start;
@@ -22,12 +22,16 @@ LUAI_FUNC GCObject* luaM_newgco_(lua_State* L, size_t nsize, uint8_t memcat);
 LUAI_FUNC void luaM_free_(lua_State* L, void* block, size_t osize, uint8_t memcat);
 LUAI_FUNC void luaM_freegco_(lua_State* L, GCObject* block, size_t osize, uint8_t memcat, lua_Page* page);
 LUAI_FUNC void* luaM_realloc_(lua_State* L, void* block, size_t osize, size_t nsize, uint8_t memcat);
+LUAI_FUNC void luaM_movememcat_(lua_State* L, size_t size, uint8_t from, uint8_t to);
 
 LUAI_FUNC l_noret luaM_toobig(lua_State* L);
 
 LUAI_FUNC void luaM_getpagewalkinfo(lua_Page* page, char** start, char** end, int* busyBlocks, int* blockSize);
 LUAI_FUNC void luaM_getpageinfo(lua_Page* page, int* pageBlocks, int* busyBlocks, int* blockSize, int* pageSize);
 LUAI_FUNC lua_Page* luaM_getnextpage(lua_Page* page);
+LUAI_FUNC bool luaM_ispageyoung(lua_Page* page);
+LUAI_FUNC void luaM_setpageyoung(lua_Page* page, bool young);
+LUAI_FUNC bool luaM_setsweepthread(lua_State* L, bool enabled);
 
 LUAI_FUNC void luaM_visitpage(lua_Page* page, void* context, bool (*visitor)(void* context, lua_Page* page, GCObject* gco));
 LUAI_FUNC void luaM_visitgco(lua_State* L, void* context, bool (*visitor)(void* context, lua_Page* page, GCObject* gco));
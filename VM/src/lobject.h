@@ -323,6 +323,17 @@ typedef struct Proto
 
     void* userdata;
 
+    struct lua_BytecodeImage* image; // shared image that owns code and lineinfo arrays, NULL when they are owned by the proto
+
+    struct InlineCache* inlinecache; // polymorphic inline caches of GETTABLEKS/NAMECALL, allocated on the first miss
+
+    uint8_t* typefeedback; // two operand tags observed by the interpreter for each instruction, see TYPEFEEDBACK_MIXED
+
+#if LUAI_EXECCOUNTERS
+    uint64_t execcalls; // number of calls to the function made by the interpreter
+    uint64_t execloops; // number of loop back edges taken by the interpreter
+#endif
+
     GCObject* gclist;
 
 
@@ -336,9 +347,27 @@ typedef struct Proto
     int linedefined;
     int bytecodeid;
     int sizetypeinfo;
+    int sizeinlinecache;
+    int tierupcount; // calls and loop back edges left before the function is passed to ecb.tierup; 0 when tiering is disabled or done
 } Proto;
 // clang-format on
 
+// type feedback stores tt + 1 for an operand that has only been seen with one type; 0 means the instruction hasn't run yet
+#define TYPEFEEDBACK_MIXED 0xff
+
+#define INLINECACHE_WAYS 4
+
+// metatables seen by one GETTABLEKS/NAMECALL instruction, with the node slot of the key in the indexed table or in its __index table
+typedef struct InlineCache
+{
+    int pcoff;         // instruction that owns the entry, -1 if unused
+    uint8_t inherited; // bit per way: the slot is in the __index table of the metatable
+    uint8_t next;      // way to replace on the next miss
+
+    int slots[INLINECACHE_WAYS];
+    const struct Table* metatables[INLINECACHE_WAYS]; // compared by identity only, so entries don't keep metatables alive
+} InlineCache;
+
 typedef struct LocVar
 {
     TString* varname;
@@ -460,7 +489,7 @@ typedef struct Table
 
 
     uint8_t tmcache;    // 1<<p means tagmethod(p) is not present
-    uint8_t readonly;   // sandboxing feature to prohibit writes to table
+    uint8_t readonly;   // LUAH_* bits; sandboxing feature to prohibit writes to table, or storage shared with a clone
     uint8_t safeenv;    // environment doesn't share globals with other scripts
     uint8_t lsizenode;  // log2 of size of `node' array
     uint8_t nodemask8; // (1<<lsizenode)-1, truncated to 8 bits
@@ -0,0 +1,1043 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+// This code is based on Lua 5.x implementation licensed under MIT License; see lua_LICENSE.txt for details
+#include "lua.h"
+
+#include "lstate.h"
+#include "ltable.h"
+#include "lfunc.h"
+#include "lstring.h"
+#include "ludata.h"
+#include "lbuffer.h"
+#include "lgc.h"
+#include "lmem.h"
+#include "ldo.h"
+#include "ldebug.h"
+
+#include <string.h>
+
+LUAU_FASTFLAG(LuauLoadTypeInfo)
+
+/*
+ * State image is a binary stream with all objects reachable from the roots of a state: the registry, the globals of the main thread and the
+ * metatables of basic types. Objects are numbered from 1 in the order of discovery, and references to objects use these numbers (0 is NULL).
+ * Restoring an image first creates all objects from their headers and then fills their contents, so references can point in any direction.
+ *
+ * All integers are encoded as unsigned LEB128. The stream has the following structure:
+ *
+ * header:   'L' 'S' 'I' 0, version, object count
+ * objects:  type, type-specific data needed to allocate the object (string and userdata contents, array sizes, etc.)
+ * contents: type-specific data for each object in the same order (references, values, function prototype contents)
+ * roots:    registry value, first free registry slot, globals table, metatables of basic types
+ *
+ * Values are encoded as the type tag followed by the payload; collectable values use object numbers as the payload.
+ */
+
+#define LUAI_STATEIMAGE_VERSION 1
+
+struct ImageBuffer
+{
+    char* data;
+    size_t size;
+    size_t capacity;
+};
+
+struct SaveState
+{
+    const lua_CBinding* bindings;
+    int nbindings;
+
+    Table* ids;     // light userdata (object address) -> object number
+    Table* objects; // object number -> light userdata (object address)
+    int count;
+
+    ImageBuffer headers;
+    ImageBuffer contents;
+    ImageBuffer roots;
+};
+
+struct RestoreState
+{
+    const lua_CBinding* bindings;
+    int nbindings;
+
+    const char* data;
+    size_t size;
+    size_t offset;
+
+    GCObject** objects;
+    int count;
+};
+
+static void imagegrow(lua_State* L, ImageBuffer* b, size_t size)
+{
+    if (b->size + size <= b->capacity)
+        return;
+
+    size_t capacity = b->capacity ? b->capacity : 4096;
+    while (capacity < b->size + size)
+        capacity *= 2;
+
+    b->data = (char*)luaM_realloc_(L, b->data, b->capacity, capacity, 0);
+    b->capacity = capacity;
+}
+
+static void imagefree(lua_State* L, ImageBuffer* b)
+{
+    luaM_free_(L, b->data, b->capacity, 0);
+}
+
+static void saveint(lua_State* L, ImageBuffer* b, uint64_t value)
+{
+    imagegrow(L, b, 10);
+
+    do
+    {
+        uint8_t byte = value & 127;
+        value >>= 7;
+        b->data[b->size++] = byte | (value ? 128 : 0);
+    } while (value);
+}
+
+static void savebytes(lua_State* L, ImageBuffer* b, const void* data, size_t size)
+{
+    imagegrow(L, b, size);
+
+    memcpy(b->data + b->size, data, size);
+    b->size += size;
+}
+
+static void savestring(lua_State* L, ImageBuffer* b, const char* data, size_t size)
+{
+    saveint(L, b, size);
+    savebytes(L, b, data, size);
+}
+
+static bool isthreadreset(lua_State* th)
+{
+    return th->ci == th->base_ci && th->base == th->top && th->status == LUA_OK;
+}
+
+static const lua_CBinding* findbinding(SaveState* s, Closure* cl)
+{
+    for (int i = 0; i < s->nbindings; ++i)
+        if (s->bindings[i].func == cl->c.f && s->bindings[i].cont == cl->c.cont)
+            return &s->bindings[i];
+
+    return NULL;
+}
+
+static unsigned saveref(lua_State* L, SaveState* s, GCObject* o)
+{
+    if (!o)
+        return 0;
+
+    TValue key;
+    setpvalue(&key, o, 0);
+
+    const TValue* id = luaH_get(s->ids, &key);
+
+    if (ttisnumber(id))
+        return unsigned(nvalue(id));
+
+    // validate objects as they are discovered so that the error is reported before any work is spent on them
+    switch (o->gch.tt)
+    {
+    case LUA_TUSERDATA:
+        if (gco2u(o)->tag == UTAG_IDTOR)
+            luaG_runerror(L, "can't save userdata with an inline destructor");
+        break;
+
+    case LUA_TTHREAD:
+        if (gco2th(o) != L->global->mainthread && !isthreadreset(gco2th(o)))
+            luaG_runerror(L, "can't save a thread that is running or suspended");
+        break;
+
+    case LUA_TUPVAL:
+        if (upisopen(gco2uv(o)))
+            luaG_runerror(L, "can't save an open upvalue");
+        break;
+
+    case LUA_TFUNCTION:
+        if (gco2cl(o)->isC && !findbinding(s, gco2cl(o)))
+            luaG_runerror(L, "can't save C function '%s' without a binding", gco2cl(o)->c.debugname ? gco2cl(o)->c.debugname : "?");
+        break;
+    }
+
+    s->count++;
+
+    TValue* idslot = luaH_set(L, s->ids, &key);
+    setnvalue(idslot, double(s->count));
+
+    TValue* objslot = luaH_setnum(L, s->objects, s->count);
+    setpvalue(objslot, o, 0);
+
+    return unsigned(s->count);
+}
+
+static void savevalue(lua_State* L, SaveState* s, const TValue* v)
+{
+    ImageBuffer* b = &s->contents;
+
+    saveint(L, b, ttype(v));
+
+    switch (ttype(v))
+    {
+    case LUA_TNIL:
+        break;
+
+    case LUA_TBOOLEAN:
+        saveint(L, b, bvalue(v));
+        break;
+
+    case LUA_TNUMBER:
+    {
+        double n = nvalue(v);
+        savebytes(L, b, &n, sizeof(n));
+        break;
+    }
+
+    case LUA_TVECTOR:
+    {
+        const float* vv = vvalue(v);
+        float xyzw[4] = {vv[0], vv[1], vv[2], LUA_VECTOR_SIZE == 4 ? vv[3] : 0.0f};
+        savebytes(L, b, xyzw, sizeof(xyzw));
+        break;
+    }
+
+    case LUA_TLIGHTUSERDATA:
+        luaG_runerror(L, "can't save light userdata");
+
+    default:
+        LUAU_ASSERT(iscollectable(v));
+        saveint(L, b, saveref(L, s, gcvalue(v)));
+    }
+}
+
+static void savetable(lua_State* L, SaveState* s, Table* h)
+{
+    int nhash = 0;
+
+    for (int i = 0; i < sizenode(h); ++i)
+        if (!ttisnil(gval(gnode(h, i))))
+            nhash++;
+
+    saveint(L, &s->headers, h->sizearray);
+    saveint(L, &s->headers, nhash);
+
+    saveint(L, &s->contents, h->readonly & LUAH_READONLY);
+    saveint(L, &s->contents, h->safeenv);
+    saveint(L, &s->contents, saveref(L, s, cast_to(GCObject*, h->metatable)));
+    saveint(L, &s->contents, nhash);
+
+    for (int i = 0; i < h->sizearray; ++i)
+        savevalue(L, s, &h->array[i]);
+
+    for (int i = 0; i < sizenode(h); ++i)
+    {
+        LuaNode* n = gnode(h, i);
+
+        if (!ttisnil(gval(n)))
+        {
+            TValue key;
+            getnodekey(L, &key, n);
+
+            savevalue(L, s, &key);
+            savevalue(L, s, gval(n));
+        }
+    }
+}
+
+static void saveclosure(lua_State* L, SaveState* s, Closure* cl)
+{
+    saveint(L, &s->headers, cl->isC);
+    saveint(L, &s->headers, cl->nupvalues);
+
+    saveint(L, &s->contents, saveref(L, s, cast_to(GCObject*, cl->env)));
+
+    if (cl->isC)
+    {
+        const lua_CBinding* binding = findbinding(s, cl);
+        LUAU_ASSERT(binding);
+
+        savestring(L, &s->contents, binding->name, strlen(binding->name));
+
+        for (int i = 0; i < cl->nupvalues; ++i)
+            savevalue(L, s, &cl->c.upvals[i]);
+    }
+    else
+    {
+        saveint(L, &s->headers, saveref(L, s, cast_to(GCObject*, cl->l.p)));
+
+        saveint(L, &s->contents, cl->preload);
+
+        for (int i = 0; i < cl->nupvalues; ++i)
+            savevalue(L, s, &cl->l.uprefs[i]);
+    }
+}
+
+static void saveproto(lua_State* L, SaveState* s, Proto* p)
+{
+    ImageBuffer* b = &s->contents;
+
+    saveint(L, b, p->nups);
+    saveint(L, b, p->numparams);
+    saveint(L, b, p->is_vararg);
+    saveint(L, b, p->maxstacksize);
+    saveint(L, b, p->flags);
+    saveint(L, b, p->linedefined);
+    saveint(L, b, p->bytecodeid);
+
+    saveint(L, b, saveref(L, s, cast_to(GCObject*, p->source)));
+    saveint(L, b, saveref(L, s, cast_to(GCObject*, p->debugname)));
+
+    // breakpoints are not saved; the original opcodes are kept in debuginsn while they are set
+    saveint(L, b, p->sizecode);
+
+    for (int i = 0; i < p->sizecode; ++i)
+    {
+        Instruction insn = p->code[i];
+
+        if (p->debuginsn)
+            insn = (insn & ~0xff) | p->debuginsn[i];
+
+        savebytes(L, b, &insn, sizeof(insn));
+    }
+
+    saveint(L, b, p->sizek);
+
+    for (int i = 0; i < p->sizek; ++i)
+        savevalue(L, s, &p->k[i]);
+
+    saveint(L, b, p->sizep);
+
+    for (int i = 0; i < p->sizep; ++i)
+        saveint(L, b, saveref(L, s, cast_to(GCObject*, p->p[i])));
+
+    saveint(L, b, p->lineinfo ? p->sizelineinfo : 0);
+
+    if (p->lineinfo)
+    {
+        saveint(L, b, p->linegaplog2);
+        savebytes(L, b, p->lineinfo, p->sizelineinfo);
+    }
+
+    saveint(L, b, p->sizelocvars);
+
+    for (int i = 0; i < p->sizelocvars; ++i)
+    {
+        saveint(L, b, saveref(L, s, cast_to(GCObject*, p->locvars[i].varname)));
+        saveint(L, b, p->locvars[i].startpc);
+        saveint(L, b, p->locvars[i].endpc);
+        saveint(L, b, p->locvars[i].reg);
+    }
+
+    saveint(L, b, p->sizeupvalues);
+
+    for (int i = 0; i < p->sizeupvalues; ++i)
+        saveint(L, b, saveref(L, s, cast_to(GCObject*, p->upvalues[i])));
+
+    int sizetypeinfo = !p->typeinfo ? 0 : FFlag::LuauLoadTypeInfo ? p->sizetypeinfo : p->numparams + 2;
+
+    saveint(L, b, sizetypeinfo);
+    savebytes(L, b, p->typeinfo, sizetypeinfo);
+}
+
+static void saveobject(lua_State* L, SaveState* s, GCObject* o)
+{
+    saveint(L, &s->headers, o->gch.tt);
+
+    switch (o->gch.tt)
+    {
+    case LUA_TSTRING:
+        savestring(L, &s->headers, getstr(gco2ts(o)), gco2ts(o)->len);
+        break;
+
+    case LUA_TTABLE:
+        savetable(L, s, gco2h(o));
+        break;
+
+    case LUA_TFUNCTION:
+        saveclosure(L, s, gco2cl(o));
+        break;
+
+    case LUA_TUSERDATA:
+    {
+        Udata* u = gco2u(o);
+        saveint(L, &s->headers, u->tag);
+        savestring(L, &s->headers, u->data, u->len);
+        saveint(L, &s->contents, saveref(L, s, cast_to(GCObject*, u->metatable)));
+        break;
+    }
+
+    case LUA_TBUFFER:
+        savestring(L, &s->headers, gco2buf(o)->data, gco2buf(o)->len);
+        break;
+
+    case LUA_TTHREAD:
+    {
+        lua_State* th = gco2th(o);
+        saveint(L, &s->headers, th == L->global->mainthread);
+        saveint(L, &s->contents, saveref(L, s, cast_to(GCObject*, th->gt)));
+        break;
+    }
+
+    case LUA_TPROTO:
+        saveproto(L, s, gco2p(o));
+        break;
+
+    case LUA_TUPVAL:
+        savevalue(L, s, gco2uv(o)->v);
+        break;
+
+    default:
+        LUAU_ASSERT(!"Unknown object tag");
+    }
+}
+
+static void savestate(lua_State* L, void* ud)
+{
+    SaveState* s = (SaveState*)ud;
+    global_State* g = L->global;
+
+    s->ids = luaH_new(L, 0, 0);
+    sethvalue(L, L->top, s->ids);
+    incr_top(L);
+
+    s->objects = luaH_new(L, 0, 0);
+    sethvalue(L, L->top, s->objects);
+    incr_top(L);
+
+    // objects are discovered starting from the roots, but the roots themselves are written last since restoring them replaces the roots of the target state
+    savevalue(L, s, registry(L));
+    saveint(L, &s->contents, g->registryfree);
+    saveint(L, &s->contents, saveref(L, s, cast_to(GCObject*, g->mainthread->gt)));
+
+    for (int i = 0; i < LUA_T_COUNT; ++i)
+        saveint(L, &s->contents, saveref(L, s, cast_to(GCObject*, g->mt[i])));
+
+    s->roots = s->contents;
+    s->contents = ImageBuffer();
+
+    // note that s->count grows as new objects are discovered
+    for (int i = 1; i <= s->count; ++i)
+        saveobject(L, s, (GCObject*)pvalue(luaH_getnum(s->objects, i)));
+
+    savebytes(L, &s->contents, s->roots.data, s->roots.size);
+
+    L->top -= 2;
+}
+
+int lua_savestate(lua_State* L, const lua_CBinding* bindings, int nbindings, lua_HeapWriter writer, void* ud)
+{
+    global_State* g = L->global;
+
+    SaveState s = {};
+    s.bindings = bindings;
+    s.nbindings = nbindings;
+
+    // objects can't be collected while they are being numbered since the numbering is keyed by address
+    size_t threshold = g->GCthreshold;
+    g->GCthreshold = SIZE_MAX;
+
+    int status = luaD_pcall(L, savestate, &s, savestack(L, L->top), 0);
+
+    g->GCthreshold = threshold;
+
+    if (status == 0)
+    {
+        ImageBuffer header = {};
+        savebytes(L, &header, "LSI", 4);
+        saveint(L, &header, LUAI_STATEIMAGE_VERSION);
+        saveint(L, &header, s.count);
+
+        writer(ud, header.data, header.size);
+        writer(ud, s.headers.data, s.headers.size);
+        writer(ud, s.contents.data, s.contents.size);
+
+        imagefree(L, &header);
+    }
+
+    imagefree(L, &s.headers);
+    imagefree(L, &s.contents);
+    imagefree(L, &s.roots);
+
+    return status;
+}
+
+static l_noret malformed(lua_State* L)
+{
+    luaG_runerror(L, "malformed state image");
+}
+
+static const char* restorebytes(lua_State* L, RestoreState* r, size_t size)
+{
+    if (size > r->size - r->offset)
+        malformed(L);
+
+    const char* result = r->data + r->offset;
+    r->offset += size;
+    return result;
+}
+
+static uint64_t restoreint(lua_State* L, RestoreState* r)
+{
+    uint64_t result = 0;
+    unsigned shift = 0;
+    uint8_t byte;
+
+    do
+    {
+        if (r->offset == r->size || shift >= 64)
+            malformed(L);
+
+        byte = uint8_t(r->data[r->offset++]);
+        result |= uint64_t(byte & 127) << shift;
+        shift += 7;
+    } while (byte & 128);
+
+    return result;
+}
+
+static int restoresize(lua_State* L, RestoreState* r)
+{
+    uint64_t size = restoreint(L, r);
+
+    // every element takes at least one byte in the image
+    if (size > r->size - r->offset)
+        malformed(L);
+
+    return int(size);
+}
+
+// returns NULL for empty references; otherwise the object is guaranteed to have the requested type
+static GCObject* restoreref(lua_State* L, RestoreState* r, int tt)
+{
+    uint64_t id = restoreint(L, r);
+
+    if (id == 0)
+        return NULL;
+
+    if (id > uint64_t(r->count) || r->objects[id]->gch.tt != tt)
+        malformed(L);
+
+    return r->objects[id];
+}
+
+static void restorevalue(lua_State* L, RestoreState* r, TValue* v)
+{
+    uint64_t tt = restoreint(L, r);
+
+    switch (tt)
+    {
+    case LUA_TNIL:
+        setnilvalue(v);
+        break;
+
+    case LUA_TBOOLEAN:
+        setbvalue(v, int(restoreint(L, r)));
+        break;
+
+    case LUA_TNUMBER:
+    {
+        double n;
+        memcpy(&n, restorebytes(L, r, sizeof(n)), sizeof(n));
+        setnvalue(v, n);
+        break;
+    }
+
+    case LUA_TVECTOR:
+    {
+        float xyzw[4];
+        memcpy(xyzw, restorebytes(L, r, sizeof(xyzw)), sizeof(xyzw));
+        setvvalue(v, xyzw[0], xyzw[1], xyzw[2], xyzw[3]);
+        break;
+    }
+
+    case LUA_TSTRING:
+    case LUA_TTABLE:
+    case LUA_TFUNCTION:
+    case LUA_TUSERDATA:
+    case LUA_TTHREAD:
+    case LUA_TBUFFER:
+    case LUA_TUPVAL:
+    {
+        GCObject* o = restoreref(L, r, int(tt));
+
+        if (!o)
+            malformed(L);
+
+        v->value.gc = o;
+        v->tt = int(tt);
+        break;
+    }
+
+    default:
+        malformed(L);
+    }
+}
+
+static Proto* restoreprotoheader(lua_State* L, RestoreState* r, uint64_t id)
+{
+    if (id == 0 || id > uint64_t(r->count))
+        malformed(L);
+
+    // function prototypes have no header data and are created by the first closure that refers to them
+    if (!r->objects[id])
+    {
+        Proto* p = luaF_newproto(L);
+        r->objects[id] = obj2gco(p);
+    }
+
+    if (r->objects[id]->gch.tt != LUA_TPROTO)
+        malformed(L);
+
+    return gco2p(r->objects[id]);
+}
+
+static void restoreheader(lua_State* L, RestoreState* r, int id)
+{
+    uint64_t tt = restoreint(L, r);
+
+    // only function prototypes can be created ahead of their header
+    if (r->objects[id] && tt != LUA_TPROTO)
+        malformed(L);
+
+    switch (tt)
+    {
+    case LUA_TSTRING:
+    {
+        size_t len = size_t(restoreint(L, r));
+        const char* data = restorebytes(L, r, len);
+
+        TString* ts = luaS_newlstr(L, data, len);
+        r->objects[id] = obj2gco(ts);
+        break;
+    }
+
+    case LUA_TTABLE:
+    {
+        int sizearray = restoresize(L, r);
+        int nhash = restoresize(L, r);
+
+        Table* h = luaH_new(L, sizearray, nhash);
+        r->objects[id] = obj2gco(h);
+        break;
+    }
+
+    case LUA_TFUNCTION:
+    {
+        bool isC = restoreint(L, r) != 0;
+        uint64_t nupvalues = restoreint(L, r);
+
+        if (nupvalues > 255)
+            malformed(L);
+
+        Closure* cl = isC ? luaF_newCclosure(L, int(nupvalues), L->gt)
+                          : luaF_newLclosure(L, int(nupvalues), L->gt, restoreprotoheader(L, r, restoreint(L, r)));
+        r->objects[id] = obj2gco(cl);
+        break;
+    }
+
+    case LUA_TUSERDATA:
+    {
+        uint64_t tag = restoreint(L, r);
+        size_t len = size_t(restoreint(L, r));
+        const char* data = restorebytes(L, r, len);
+
+        if (tag >= UTAG_IDTOR && tag != UTAG_PROXY)
+            malformed(L);
+
+        Udata* u = luaU_newudata(L, len, int(tag));
+        memcpy(u->data, data, len);
+        r->objects[id] = obj2gco(u);
+        break;
+    }
+
+    case LUA_TBUFFER:
+    {
+        size_t len = size_t(restoreint(L, r));
+        const char* data = restorebytes(L, r, len);
+
+        Buffer* b = luaB_newbuffer(L, len);
+        memcpy(b->data, data, len);
+        r->objects[id] = obj2gco(b);
+        break;
+    }
+
+    case LUA_TTHREAD:
+    {
+        lua_State* th = restoreint(L, r) ? L->global->mainthread : luaE_newthread(L);
+        r->objects[id] = obj2gco(th);
+        break;
+    }
+
+    case LUA_TPROTO:
+        restoreprotoheader(L, r, id);
+        break;
+
+    case LUA_TUPVAL:
+    {
+        UpVal* uv = luaF_newclosedupval(L);
+        r->objects[id] = obj2gco(uv);
+        break;
+    }
+
+    default:
+        malformed(L);
+    }
+}
+
+static void restoretable(lua_State* L, RestoreState* r, Table* h)
+{
+    int readonly = int(restoreint(L, r));
+    int safeenv = int(restoreint(L, r));
+
+    if (Table* mt = (Table*)restoreref(L, r, LUA_TTABLE))
+    {
+        h->metatable = mt;
+        luaC_objbarrier(L, h, mt);
+    }
+
+    int nhash = restoresize(L, r);
+
+    for (int i = 0; i < h->sizearray; ++i)
+    {
+        TValue v;
+        restorevalue(L, r, &v);
+        setobj2t(L, &h->array[i], &v);
+        luaC_barriert(L, h, &v);
+    }
+
+    for (int i = 0; i < nhash; ++i)
+    {
+        TValue key, val;
+        restorevalue(L, r, &key);
+        restorevalue(L, r, &val);
+
+        TValue* slot = luaH_set(L, h, &key);
+        setobj2t(L, slot, &val);
+        luaC_barriert(L, h, &key);
+        luaC_barriert(L, h, &val);
+    }
+
+    invalidateTMcache(h);
+
+    h->readonly = uint8_t(readonly);
+    h->safeenv = uint8_t(safeenv);
+}
+
+static const lua_CBinding* restorebinding(lua_State* L, RestoreState* r)
+{
+    size_t len = size_t(restoreint(L, r));
+    const char* name = restorebytes(L, r, len);
+
+    for (int i = 0; i < r->nbindings; ++i)
+        if (strlen(r->bindings[i].name) == len && memcmp(r->bindings[i].name, name, len) == 0)
+            return &r->bindings[i];
+
+    luaG_runerror(L, "no binding for C function '%.*s'", int(len), name);
+}
+
+static void restoreclosure(lua_State* L, RestoreState* r, Closure* cl)
+{
+    Table* env = (Table*)restoreref(L, r, LUA_TTABLE);
+
+    if (!env)
+        malformed(L);
+
+    cl->env = env;
+    luaC_objbarrier(L, cl, env);
+
+    if (cl->isC)
+    {
+        const lua_CBinding* binding = restorebinding(L, r);
+        const char* shortname = strrchr(binding->name, '.');
+
+        cl->c.f = binding->func;
+        cl->c.cont = binding->cont;
+        cl->c.debugname = shortname ? shortname + 1 : binding->name;
+
+        for (int i = 0; i < cl->nupvalues; ++i)
+        {
+            restorevalue(L, r, &cl->c.upvals[i]);
+            luaC_barrier(L, cl, &cl->c.upvals[i]);
+        }
+    }
+    else
+    {
+        cl->preload = uint8_t(restoreint(L, r));
+
+        for (int i = 0; i < cl->nupvalues; ++i)
+        {
+            restorevalue(L, r, &cl->l.uprefs[i]);
+            luaC_barrier(L, cl, &cl->l.uprefs[i]);
+        }
+    }
+}
+
+static TString* restorestring(lua_State* L, RestoreState* r, Proto* p)
+{
+    TString* ts = (TString*)restoreref(L, r, LUA_TSTRING);
+
+    if (ts)
+        luaC_objbarrier(L, p, ts);
+
+    return ts;
+}
+
+static void restoreproto(lua_State* L, RestoreState* r, Proto* p)
+{
+    p->nups = uint8_t(restoreint(L, r));
+    p->numparams = uint8_t(restoreint(L, r));
+    p->is_vararg = uint8_t(restoreint(L, r));
+    p->maxstacksize = uint8_t(restoreint(L, r));
+    p->flags = uint8_t(restoreint(L, r));
+    p->linedefined = int(restoreint(L, r));
+    p->bytecodeid = int(restoreint(L, r));
+
+    p->source = restorestring(L, r, p);
+    p->debugname = restorestring(L, r, p);
+
+    int sizecode = restoresize(L, r);
+    p->code = luaM_newarray(L, sizecode, Instruction, p->memcat);
+    p->sizecode = sizecode;
+    memcpy(p->code, restorebytes(L, r, sizecode * sizeof(Instruction)), sizecode * sizeof(Instruction));
+    p->codeentry = p->code;
+
+    int sizek = restoresize(L, r);
+    p->k = luaM_newarray(L, sizek, TValue, p->memcat);
+    p->sizek = sizek;
+
+    for (int i = 0; i < sizek; ++i)
+        setnilvalue(&p->k[i]);
+
+    for (int i = 0; i < sizek; ++i)
+    {
+        restorevalue(L, r, &p->k[i]);
+        luaC_barrier(L, p, &p->k[i]);
+    }
+
+    int sizep = restoresize(L, r);
+    p->p = luaM_newarray(L, sizep, Proto*, p->memcat);
+    p->sizep = sizep;
+
+    for (int i = 0; i < sizep; ++i)
+        p->p[i] = NULL;
+
+    for (int i = 0; i < sizep; ++i)
+    {
+        Proto* child = (Proto*)restoreref(L, r, LUA_TPROTO);
+
+        if (!child)
+            malformed(L);
+
+        p->p[i] = child;
+        luaC_objbarrier(L, p, child);
+    }
+
+    if (int sizelineinfo = restoresize(L, r))
+    {
+        p->linegaplog2 = int(restoreint(L, r));
+
+        int absoffset = (p->sizecode + 3) & ~3;
+
+        if (sizelineinfo < absoffset)
+            malformed(L);
+
+        p->lineinfo = luaM_newarray(L, sizelineinfo, uint8_t, p->memcat);
+        p->sizelineinfo = sizelineinfo;
+        memcpy(p->lineinfo, restorebytes(L, r, sizelineinfo), sizelineinfo);
+
+        p->abslineinfo = (int*)(p->lineinfo + absoffset);
+    }
+
+    int sizelocvars = restoresize(L, r);
+    p->locvars = luaM_newarray(L, sizelocvars, LocVar, p->memcat);
+    p->sizelocvars = sizelocvars;
+
+    for (int i = 0; i < sizelocvars; ++i)
+        p->locvars[i].varname = NULL;
+
+    for (int i = 0; i < sizelocvars; ++i)
+    {
+        p->locvars[i].varname = restorestring(L, r, p);
+        p->locvars[i].startpc = int(restoreint(L, r));
+        p->locvars[i].endpc = int(restoreint(L, r));
+        p->locvars[i].reg = uint8_t(restoreint(L, r));
+    }
+
+    int sizeupvalues = restoresize(L, r);
+    p->upvalues = luaM_newarray(L, sizeupvalues, TString*, p->memcat);
+    p->sizeupvalues = sizeupvalues;
+
+    for (int i = 0; i < sizeupvalues; ++i)
+        p->upvalues[i] = NULL;
+
+    for (int i = 0; i < sizeupvalues; ++i)
+        p->upvalues[i] = restorestring(L, r, p);
+
+    if (int sizetypeinfo = restoresize(L, r))
+    {
+        if (!FFlag::LuauLoadTypeInfo && sizetypeinfo != p->numparams + 2)
+            malformed(L);
+
+        p->typeinfo = luaM_newarray(L, sizetypeinfo, uint8_t, p->memcat);
+        memcpy(p->typeinfo, restorebytes(L, r, sizetypeinfo), sizetypeinfo);
+
+        if (FFlag::LuauLoadTypeInfo)
+            p->sizetypeinfo = sizetypeinfo;
+    }
+}
+
+static void restorecontents(lua_State* L, RestoreState* r, GCObject* o)
+{
+    switch (o->gch.tt)
+    {
+    case LUA_TSTRING:
+    case LUA_TBUFFER:
+        break;
+
+    case LUA_TTABLE:
+        restoretable(L, r, gco2h(o));
+        break;
+
+    case LUA_TFUNCTION:
+        restoreclosure(L, r, gco2cl(o));
+        break;
+
+    case LUA_TUSERDATA:
+        if (Table* mt = (Table*)restoreref(L, r, LUA_TTABLE))
+        {
+            Udata* u = gco2u(o);
+            u->metatable = mt;
+            luaC_objbarrier(L, u, mt);
+        }
+        break;
+
+    case LUA_TTHREAD:
+    {
+        Table* gt = (Table*)restoreref(L, r, LUA_TTABLE);
+
+        if (!gt)
+            malformed(L);
+
+        lua_State* th = gco2th(o);
+        th->gt = gt;
+        luaC_objbarrier(L, th, gt);
+        break;
+    }
+
+    case LUA_TPROTO:
+        restoreproto(L, r, gco2p(o));
+        break;
+
+    case LUA_TUPVAL:
+    {
+        UpVal* uv = gco2uv(o);
+        restorevalue(L, r, uv->v);
+        luaC_barrier(L, uv, uv->v);
+        break;
+    }
+
+    default:
+        LUAU_ASSERT(!"Unknown object tag");
+    }
+}
+
+static void restorestate(lua_State* L, void* ud)
+{
+    RestoreState* r = (RestoreState*)ud;
+    global_State* g = L->global;
+
+    const char* magic = restorebytes(L, r, 4);
+
+    if (memcmp(magic, "LSI", 4) != 0)
+        malformed(L);
+
+    uint64_t version = restoreint(L, r);
+
+    if (version != LUAI_STATEIMAGE_VERSION)
+        luaG_runerror(L, "state image version mismatch (expected %d, got %d)", LUAI_STATEIMAGE_VERSION, int(version));
+
+    uint64_t count = restoreint(L, r);
+
+    // every object takes at least one byte in the image
+    if (count > r->size - r->offset)
+        malformed(L);
+
+    r->objects = luaM_newarray(L, size_t(count) + 1, GCObject*, 0);
+    r->count = int(count);
+
+    for (int i = 0; i <= r->count; ++i)
+        r->objects[i] = NULL;
+
+    for (int i = 1; i <= r->count; ++i)
+        restoreheader(L, r, i);
+
+    for (int i = 1; i <= r->count; ++i)
+        restorecontents(L, r, r->objects[i]);
+
+    // closures take the stack size from their prototypes, which didn't have it when the closures were created
+    for (int i = 1; i <= r->count; ++i)
+        if (r->objects[i]->gch.tt == LUA_TFUNCTION && !gco2cl(r->objects[i])->isC)
+            gco2cl(r->objects[i])->stacksize = gco2cl(r->objects[i])->l.p->maxstacksize;
+
+    TValue reg;
+    restorevalue(L, r, &reg);
+
+    int registryfree = int(restoreint(L, r));
+
+    Table* gt = (Table*)restoreref(L, r, LUA_TTABLE);
+
+    if (!ttistable(&reg) || !gt)
+        malformed(L);
+
+    Table* mt[LUA_T_COUNT];
+
+    for (int i = 0; i < LUA_T_COUNT; ++i)
+        mt[i] = (Table*)restoreref(L, r, LUA_TTABLE);
+
+    if (r->offset != r->size)
+        malformed(L);
+
+    // roots are only replaced once the image is known to be valid
+    // the main thread stays gray during marking, so a barrier against it wouldn't mark the registry; the atomic stage marks it again instead
+    setobj(L, registry(L), &reg);
+    g->registryfree = registryfree;
+
+    g->mainthread->gt = gt;
+    luaC_objbarrier(L, g->mainthread, gt);
+
+    if (L != g->mainthread)
+    {
+        L->gt = gt;
+        luaC_objbarrier(L, L, gt);
+    }
+
+    for (int i = 0; i < LUA_T_COUNT; ++i)
+        g->mt[i] = mt[i];
+}
+
+int lua_restorestate(lua_State* L, const char* data, size_t size, const lua_CBinding* bindings, int nbindings)
+{
+    global_State* g = L->global;
+
+    RestoreState r = {};
+    r.bindings = bindings;
+    r.nbindings = nbindings;
+    r.data = data;
+    r.size = size;
+
+    // restored objects are not reachable from the roots until the very end
+    size_t threshold = g->GCthreshold;
+    g->GCthreshold = SIZE_MAX;
+
+    int status = luaD_pcall(L, restorestate, &r, savestack(L, L->top), 0);
+
+    g->GCthreshold = threshold;
+
+    if (r.objects)
+        luaM_freearray(L, r.objects, r.count + 1, GCObject*, 0);
+
+    return status;
+}
@@ -19,18 +19,39 @@ typedef struct LG
     global_State g;
 } LG;
 
+static size_t pooledthreadsize(int stacksize, int size_ci)
+{
+    return stacksize * sizeof(TValue) + size_ci * sizeof(CallInfo);
+}
+
 static void stack_init(lua_State* L1, lua_State* L)
 {
+    global_State* g = L->global;
+    if (g->threadpoolsize > 0)
+    {
+        // take the arrays of a collected thread, keeping their size
+        PooledThread* pt = &g->threadpool[g->threadpoolsize - 1];
+        luaM_movememcat_(L, pooledthreadsize(pt->stacksize, pt->size_ci), 0, L1->memcat);
+        g->threadpoolsize--;
+
+        L1->base_ci = pt->base_ci;
+        L1->size_ci = pt->size_ci;
+        L1->stack = pt->stack;
+        L1->stacksize = pt->stacksize;
+    }
+    else
+    {
+        L1->base_ci = luaM_newarray(L, BASIC_CI_SIZE, CallInfo, L1->memcat);
+        L1->size_ci = BASIC_CI_SIZE;
+        L1->stack = luaM_newarray(L, BASIC_STACK_SIZE + EXTRA_STACK, TValue, L1->memcat);
+        L1->stacksize = BASIC_STACK_SIZE + EXTRA_STACK;
+    }
     // initialize CallInfo array
-    L1->base_ci = luaM_newarray(L, BASIC_CI_SIZE, CallInfo, L1->memcat);
     L1->ci = L1->base_ci;
-    L1->size_ci = BASIC_CI_SIZE;
     L1->end_ci = L1->base_ci + L1->size_ci - 1;
     // initialize stack array
-    L1->stack = luaM_newarray(L, BASIC_STACK_SIZE + EXTRA_STACK, TValue, L1->memcat);
-    L1->stacksize = BASIC_STACK_SIZE + EXTRA_STACK;
     TValue* stack = L1->stack;
-    for (int i = 0; i < BASIC_STACK_SIZE + EXTRA_STACK; i++)
+    for (int i = 0; i < L1->stacksize; i++)
         setnilvalue(stack + i); // erase new stack
     L1->top = stack;
     L1->stack_last = stack + (L1->stacksize - EXTRA_STACK);
@@ -43,8 +64,58 @@ static void stack_init(lua_State* L1, lua_State* L)
 
 static void freestack(lua_State* L, lua_State* L1)
 {
+    global_State* g = L->global;
+    size_t bytes = pooledthreadsize(L1->stacksize, L1->size_ci);
+
+    // moving the arrays to category 0 can't take it over the soft limit, since this runs during a sweep which mustn't fail
+    if (g->threadpoolsize < g->threadpoolcap && L1->stacksize < (1 << STACKPOOL_MINLOG) && L1->size_ci <= THREADPOOL_MAXCI &&
+        g->memcatbytes[0] + bytes <= g->memcatsoftlimit[0])
+    {
+        luaM_movememcat_(L, bytes, L1->memcat, 0);
+
+        PooledThread* pt = &g->threadpool[g->threadpoolsize++];
+        pt->stack = L1->stack;
+        pt->base_ci = L1->base_ci;
+        pt->stacksize = L1->stacksize;
+        pt->size_ci = L1->size_ci;
+        return;
+    }
+
     luaM_freearray(L, L1->base_ci, L1->size_ci, CallInfo, L1->memcat);
-    luaM_freearray(L, L1->stack, L1->stacksize, TValue, L1->memcat);
+    luaD_releasestack(L, L1->stack, L1->stacksize, L1->memcat);
+}
+
+static void trimthreadpool(lua_State* L, int size)
+{
+    global_State* g = L->global;
+
+    while (g->threadpoolsize > size)
+    {
+        PooledThread* pt = &g->threadpool[--g->threadpoolsize];
+        luaM_freearray(L, pt->base_ci, pt->size_ci, CallInfo, 0);
+        luaM_freearray(L, pt->stack, pt->stacksize, TValue, 0);
+    }
+}
+
+void luaE_flushthreadpool(lua_State* L)
+{
+    trimthreadpool(L, 0);
+}
+
+int luaE_setthreadpool(lua_State* L, int cap)
+{
+    global_State* g = L->global;
+    int prev = g->threadpoolcap;
+
+    trimthreadpool(L, cap);
+
+    if (cap != g->threadpoolcap)
+    {
+        luaM_reallocarray(L, g->threadpool, g->threadpoolcap, cap, PooledThread, 0);
+        g->threadpoolcap = cap;
+    }
+
+    return prev;
 }
 
 /*
@@ -58,6 +129,7 @@ static void f_luaopen(lua_State* L, void* ud)
     sethvalue(L, registry(L), luaH_new(L, 0, 2)); // registry
     luaS_resize(L, LUA_MINSTRTABSIZE);            // initial size of string table
     luaT_init(L);
+    luaE_setthreadpool(L, LUAI_THREADPOOLSIZE);
     luaS_fix(luaS_newliteral(L, LUA_MEMERRMSG)); // pin to make sure we can always throw this error
     luaS_fix(luaS_newliteral(L, LUA_ERRERRMSG)); // pin to make sure we can always throw this error
     g->GCthreshold = 4 * g->totalbytes;
@@ -86,10 +158,17 @@ static void close_state(lua_State* L)
 {
     global_State* g = L->global;
     luaF_close(L, L->stack); // close all upvalues for this thread
+    if (g->ecb.closing)
+        g->ecb.closing(L);
+    luaE_setthreadpool(L, 0);
     luaC_freeall(L);         // collect all objects
+    luaC_setmarkworkers(L, 0);
+    luaM_setsweepthread(L, false);
     LUAU_ASSERT(g->strt.nuse == 0);
+    luaS_rehash(L, g->strt.oldsize);
     luaM_freearray(L, L->global->strt.hash, L->global->strt.size, TString*, 0);
     freestack(L, L);
+    luaD_flushstackpool(L);
     for (int i = 0; i < LUA_SIZECLASSES; i++)
     {
         LUAU_ASSERT(g->freepages[i] == NULL);
@@ -189,9 +268,15 @@ lua_State* lua_newstate(lua_Alloc f, void* ud)
     g->strt.size = 0;
     g->strt.nuse = 0;
     g->strt.hash = NULL;
+    g->strt.oldhash = NULL;
+    g->strt.oldsize = 0;
+    g->strt.rehashpos = 0;
     setnilvalue(&g->pseudotemp);
     setnilvalue(registry(L));
     g->gcstate = GCSpause;
+    g->gcgen = 0;
+    g->gcsticky = 0;
+    g->gcgenminor = 0;
     g->gray = NULL;
     g->grayagain = NULL;
     g->weak = NULL;
@@ -199,6 +284,14 @@ lua_State* lua_newstate(lua_Alloc f, void* ud)
     g->gcgoal = LUAI_GCGOAL;
     g->gcstepmul = LUAI_GCSTEPMUL;
     g->gcstepsize = LUAI_GCSTEPSIZE << 10;
+    g->gcgenminormul = LUAI_GCGENMINORMUL;
+    g->gcgenmajormul = LUAI_GCGENMAJORMUL;
+    g->gcgenmajorbase = 0;
+    g->gcsteptime = 0;
+    g->gcmarkrate = 0;
+    g->gcsweeprate = 0;
+    g->markpool = NULL;
+    g->sweepthread = NULL;
     for (i = 0; i < LUA_SIZECLASSES; i++)
     {
         g->freepages[i] = NULL;
@@ -207,6 +300,12 @@ lua_State* lua_newstate(lua_Alloc f, void* ud)
     g->allpages = NULL;
     g->allgcopages = NULL;
     g->sweepgcopage = NULL;
+    for (i = 0; i < STACKPOOL_CLASSES; i++)
+        g->stackpool[i] = NULL;
+    g->stackpoolbytes = 0;
+    g->threadpool = NULL;
+    g->threadpoolsize = 0;
+    g->threadpoolcap = 0;
     for (i = 0; i < LUA_T_COUNT; i++)
         g->mt[i] = NULL;
     for (i = 0; i < LUA_UTAG_LIMIT; i++)
@@ -214,13 +313,22 @@ lua_State* lua_newstate(lua_Alloc f, void* ud)
     for (i = 0; i < LUA_LUTAG_LIMIT; i++)
         g->lightuserdataname[i] = NULL;
     for (i = 0; i < LUA_MEMORY_CATEGORIES; i++)
+    {
         g->memcatbytes[i] = 0;
+        g->memcatsoftlimit[i] = SIZE_MAX;
+        g->memcathardlimit[i] = SIZE_MAX;
+        g->memcatendbytes[i] = 0;
+        g->memcatatomicbytes[i] = 0;
+    }
+    g->memcatexempt = false;
 
     g->memcatbytes[0] = sizeof(LG);
 
     g->cb = lua_Callbacks();
 
     g->ecb = lua_ExecutionCallbacks();
+    g->tierupthreshold = 0;
+    g->typefeedback = false;
 
     g->gcstats = GCStats();
 
@@ -228,6 +336,11 @@ lua_State* lua_newstate(lua_Alloc f, void* ud)
     g->gcmetrics = GCMetrics();
 #endif
 
+#if LUAI_EXECCOUNTERS
+    for (i = 0; i < 256; i++)
+        g->execops[i] = 0;
+#endif
+
     if (luaD_rawrunprotected(L, f_luaopen, NULL) != 0)
     {
         // memory allocation error: free partial state
@@ -15,6 +15,13 @@
 
 #define BASIC_STACK_SIZE (2 * LUA_MINSTACK)
 
+// stacks with at least 1<<STACKPOOL_MINLOG slots grow in powers of two, so that released buffers can be reused by other threads
+#define STACKPOOL_MINLOG 8
+#define STACKPOOL_CLASSES 24
+
+// threads with at most this many call infos can be kept in the thread pool
+#define THREADPOOL_MAXCI 64
+
 // clang-format off
 typedef struct stringtable
 {
@@ -22,6 +29,10 @@ typedef struct stringtable
     TString** hash;
     uint32_t nuse; // number of elements
     int size;
+
+    TString** oldhash; // previous bucket array while a resize is in progress, NULL otherwise
+    int oldsize;
+    int rehashpos; // buckets of oldhash before this position have been moved to hash
 } stringtable;
 // clang-format on
 
@@ -76,6 +87,15 @@ typedef struct CallInfo
 #define f_isLua(ci) (!ci_func(ci)->isC)
 #define isLua(ci) (ttisfunction((ci)->func) && f_isLua(ci))
 
+// stack and call info arrays of a collected thread, kept for reuse by a new thread
+struct PooledThread
+{
+    TValue* stack;
+    CallInfo* base_ci;
+    int stacksize;
+    int size_ci;
+};
+
 struct GCStats
 {
     // data for proportional-integral controller of heap trigger value
@@ -131,6 +151,10 @@ struct GCCycleMetrics
     size_t propagatework = 0;
     size_t propagateagainwork = 0;
 
+    // parallel marking; index 0 is the thread running the collector, the rest are helper threads
+    double markworkertime[LUAI_GCMAXMARKWORKERS + 1] = {};
+    size_t markworkerwork[LUAI_GCMAXMARKWORKERS + 1] = {};
+
     size_t endtotalsizebytes = 0;
 };
 
@@ -152,10 +176,12 @@ struct lua_ExecutionCallbacks
 {
     void* context;
     void (*close)(lua_State* L);                 // called when global VM state is closed
+    void (*closing)(lua_State* L);               // called when global VM state is about to be closed, before any objects are freed
     void (*destroy)(lua_State* L, Proto* proto); // called when function is destroyed
     int (*enter)(lua_State* L, Proto* proto);    // called when function is about to start/resume (when execdata is present), return 0 to exit VM
     void (*disable)(lua_State* L, Proto* proto); // called when function has to be switched from native to bytecode in the debugger
     size_t (*getmemorysize)(lua_State* L, Proto* proto); // called to request the size of memory associated with native part of the Proto
+    void (*tierup)(lua_State* L, Proto* proto); // called when function has run enough calls and loop iterations in the interpreter (see tierupthreshold)
 };
 
 /*
@@ -173,6 +199,9 @@ typedef struct global_State
 
     uint8_t currentwhite;
     uint8_t gcstate; // state of garbage collector
+    uint8_t gcgen;      // collector runs in generational mode, see LUA_GCGEN
+    uint8_t gcsticky;   // objects that survived the last cycle keep their marks and are treated as old
+    uint8_t gcgenminor; // current cycle is a minor collection that only traverses young objects and the remembered set
 
 
     GCObject* gray;      // list of gray objects
@@ -185,6 +214,15 @@ typedef struct global_State
     int gcgoal;                               // see LUAI_GCGOAL
     int gcstepmul;                            // see LUAI_GCSTEPMUL
     int gcstepsize;                          // see LUAI_GCSTEPSIZE
+    int gcgenminormul;                       // see LUAI_GCGENMINORMUL
+    int gcgenmajormul;                       // see LUAI_GCGENMAJORMUL
+    size_t gcgenmajorbase;                   // heap size at the end of the last major collection in generational mode
+    int gcsteptime;                          // time budget of a GC step in microseconds, 0 to size steps by gcstepsize
+    double gcmarkrate;                       // measured mark throughput in work units per second, 0 until measured
+    double gcsweeprate;                      // measured sweep throughput in work units per second, 0 until measured
+
+    struct GCMarkPool* markpool;      // helper threads for parallel marking, see LUA_GCSETMARKWORKERS
+    struct GCSweepThread* sweepthread; // background thread that releases memory freed by the sweep, see LUA_GCSETSWEEPTHREAD
 
     struct lua_Page* freepages[LUA_SIZECLASSES]; // free page linked list for each size class for non-collectable objects
     struct lua_Page* freegcopages[LUA_SIZECLASSES]; // free page linked list for each size class for collectable objects
@@ -192,6 +230,13 @@ typedef struct global_State
     struct lua_Page* allgcopages; // page linked list with all pages for all collectable object classes
     struct lua_Page* sweepgcopage; // position of the sweep in `allgcopages'
 
+    TValue* stackpool[STACKPOOL_CLASSES]; // stack buffers released by threads, linked through the first slot; see luaD_releasestack
+    size_t stackpoolbytes; // total size of the buffers in `stackpool', accounted to memory category 0
+
+    PooledThread* threadpool; // arrays of collected threads, accounted to memory category 0; see LUA_GCSETTHREADPOOL
+    int threadpoolsize;       // number of entries in `threadpool'
+    int threadpoolcap;        // capacity of `threadpool'
+
     size_t memcatbytes[LUA_MEMORY_CATEGORIES]; // total amount of memory used by each memory category
 
 
@@ -214,16 +259,29 @@ typedef struct global_State
     lua_Callbacks cb;
 
     lua_ExecutionCallbacks ecb;
+    int tierupthreshold; // number of calls and loop back edges in the interpreter after which new functions are passed to ecb.tierup; 0 disables tiering
+    bool typefeedback; // functions loaded while set record the operand tags observed by the interpreter, see Proto::typefeedback
 
     void (*udatagc[LUA_UTAG_LIMIT])(lua_State*, void*); // for each userdata tag, a gc callback to be called immediately before freeing memory
 
     TString* lightuserdataname[LUA_LUTAG_LIMIT]; // names for tagged lightuserdata
 
+    // kept after the fields accessed by native code, which has a limited range of load offsets
+    size_t memcatsoftlimit[LUA_MEMORY_CATEGORIES]; // allocations above this size take the limit check slow path; never above the hard limit
+    size_t memcathardlimit[LUA_MEMORY_CATEGORIES]; // allocations above this size fail with a memory error
+    size_t memcatendbytes[LUA_MEMORY_CATEGORIES]; // memory used by each category at the end of the last collection cycle
+    size_t memcatatomicbytes[LUA_MEMORY_CATEGORIES]; // memory used by each category at the start of the atomic stage
+    bool memcatexempt; // set while the collector runs a step; its own allocations are not subject to the limits, so a step never fails
+
     GCStats gcstats;
 
 #ifdef LUAI_GCMETRICS
     GCMetrics gcmetrics;
 #endif
+
+#if LUAI_EXECCOUNTERS
+    uint64_t execops[256]; // number of times each opcode handler was entered by the interpreter
+#endif
 } global_State;
 // clang-format on
 
@@ -305,3 +363,5 @@ union GCObject
 
 LUAI_FUNC lua_State* luaE_newthread(lua_State* L);
 LUAI_FUNC void luaE_freethread(lua_State* L, lua_State* L1, struct lua_Page* page);
+LUAI_FUNC int luaE_setthreadpool(lua_State* L, int cap);
+LUAI_FUNC void luaE_flushthreadpool(lua_State* L);
@@ -42,30 +42,96 @@ unsigned int luaS_hash(const char* str, size_t len)
     return h;
 }
 
+// number of buckets moved to the new bucket array by each string insertion while a resize is in progress
+#define STRT_REHASHSTEP 2
+
+// string table is resized incrementally: strings are moved from the old bucket array a few buckets at a time by insertions and GC steps,
+// and lookups check both arrays until the move is complete. this keeps the cost of a resize out of any single allocation
 void luaS_resize(lua_State* L, int newsize)
 {
-    TString** newhash = luaM_newarray(L, newsize, TString*, 0);
     stringtable* tb = &L->global->strt;
+
+    // finish the previous resize, which is rare as insertions move buckets faster than the table grows
+    if (tb->oldhash)
+        luaS_rehash(L, tb->oldsize);
+
+    TString** newhash = luaM_newarray(L, newsize, TString*, 0);
     for (int i = 0; i < newsize; i++)
         newhash[i] = NULL;
-    // rehash
-    for (int i = 0; i < tb->size; i++)
+
+    if (tb->size == 0)
+        LUAU_ASSERT(tb->hash == NULL);
+    else
+        tb->oldhash = tb->hash;
+
+    tb->oldsize = tb->size;
+    tb->rehashpos = 0;
+    tb->size = newsize;
+    tb->hash = newhash;
+}
+
+int luaS_rehash(lua_State* L, int buckets)
+{
+    stringtable* tb = &L->global->strt;
+
+    if (!tb->oldhash)
+        return 0;
+
+    int start = tb->rehashpos;
+    int end = buckets < tb->oldsize - start ? start + buckets : tb->oldsize;
+
+    for (int i = start; i < end; i++)
     {
-        TString* p = tb->hash[i];
+        TString* p = tb->oldhash[i];
         while (p)
         {                            // for each node in the list
             TString* next = p->next; // save next
             unsigned int h = p->hash;
-            int h1 = lmod(h, newsize); // new position
-            LUAU_ASSERT(cast_int(h % newsize) == lmod(h, newsize));
-            p->next = newhash[h1]; // chain it
-            newhash[h1] = p;
+            int h1 = lmod(h, tb->size); // new position
+            LUAU_ASSERT(cast_int(h % tb->size) == lmod(h, tb->size));
+            p->next = tb->hash[h1]; // chain it
+            tb->hash[h1] = p;
             p = next;
         }
+
+        tb->oldhash[i] = NULL;
     }
-    luaM_freearray(L, tb->hash, tb->size, TString*, 0);
-    tb->size = newsize;
-    tb->hash = newhash;
+
+    tb->rehashpos = end;
+
+    if (end == tb->oldsize)
+    {
+        luaM_freearray(L, tb->oldhash, tb->oldsize, TString*, 0);
+        tb->oldhash = NULL;
+        tb->oldsize = 0;
+        tb->rehashpos = 0;
+    }
+
+    return end - start;
+}
+
+static TString* findstr(global_State* g, const char* str, size_t l, unsigned int h)
+{
+    stringtable* tb = &g->strt;
+
+    for (TString* el = tb->hash[lmod(h, tb->size)]; el != NULL; el = el->next)
+    {
+        // full hash rejects most strings that share the bucket without touching their contents
+        if (el->hash == h && el->len == l && (memcmp(str, getstr(el), l) == 0))
+            return el;
+    }
+
+    // buckets that were already moved are empty
+    if (LUAU_UNLIKELY(tb->oldhash != NULL))
+    {
+        for (TString* el = tb->oldhash[lmod(h, tb->oldsize)]; el != NULL; el = el->next)
+        {
+            if (el->hash == h && el->len == l && (memcmp(str, getstr(el), l) == 0))
+                return el;
+        }
+    }
+
+    return NULL;
 }
 
 static TString* newlstr(lua_State* L, const char* str, size_t l, unsigned int h)
@@ -90,6 +156,8 @@ static TString* newlstr(lua_State* L, const char* str, size_t l, unsigned int h)
     tb->nuse++;
     if (tb->nuse > cast_to(uint32_t, tb->size) && tb->size <= INT_MAX / 2)
         luaS_resize(L, tb->size * 2); // too crowded
+    else if (tb->oldhash)
+        luaS_rehash(L, STRT_REHASHSTEP);
 
     return ts;
 }
@@ -114,21 +182,19 @@ TString* luaS_buffinish(lua_State* L, TString* ts)
 {
     unsigned int h = luaS_hash(ts->data, ts->len);
     stringtable* tb = &L->global->strt;
-    int bucket = lmod(h, tb->size);
 
     // search if we already have this string in the hash table
-    for (TString* el = tb->hash[bucket]; el != NULL; el = el->next)
+    if (TString* el = findstr(L->global, ts->data, ts->len, h))
     {
-        if (el->len == ts->len && memcmp(el->data, ts->data, ts->len) == 0)
-        {
-            // string may be dead
-            if (isdead(L->global, obj2gco(el)))
-                changewhite(obj2gco(el));
+        // string may be dead
+        if (isdead(L->global, obj2gco(el)))
+            changewhite(obj2gco(el));
 
-            return el;
-        }
+        return el;
     }
 
+    int bucket = lmod(h, tb->size);
+
     LUAU_ASSERT(ts->next == NULL);
 
     ts->hash = h;
@@ -140,6 +206,8 @@ TString* luaS_buffinish(lua_State* L, TString* ts)
     tb->nuse++;
     if (tb->nuse > cast_to(uint32_t, tb->size) && tb->size <= INT_MAX / 2)
         luaS_resize(L, tb->size * 2); // too crowded
+    else if (tb->oldhash)
+        luaS_rehash(L, STRT_REHASHSTEP);
 
     return ts;
 }
@@ -147,15 +215,12 @@ TString* luaS_buffinish(lua_State* L, TString* ts)
 TString* luaS_newlstr(lua_State* L, const char* str, size_t l)
 {
     unsigned int h = luaS_hash(str, l);
-    for (TString* el = L->global->strt.hash[lmod(h, L->global->strt.size)]; el != NULL; el = el->next)
+    if (TString* el = findstr(L->global, str, l, h))
     {
-        if (el->len == l && (memcmp(str, getstr(el), l) == 0))
-        {
-            // string may be dead
-            if (isdead(L->global, obj2gco(el)))
-                changewhite(obj2gco(el));
-            return el;
-        }
+        // string may be dead
+        if (isdead(L->global, obj2gco(el)))
+            changewhite(obj2gco(el));
+        return el;
     }
     return newlstr(L, str, l, h); // not found
 }
@@ -179,6 +244,24 @@ static bool unlinkstr(lua_State* L, TString* ts)
         }
     }
 
+    if (g->strt.oldhash)
+    {
+        p = &g->strt.oldhash[lmod(ts->hash, g->strt.oldsize)];
+
+        while (TString* curr = *p)
+        {
+            if (curr == ts)
+            {
+                *p = curr->next;
+                return true;
+            }
+            else
+            {
+                p = &curr->next;
+            }
+        }
+    }
+
     return false;
 }
 
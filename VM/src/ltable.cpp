@@ -13,6 +13,10 @@
  * position that its hash gives to it), then the colliding element is in its own main position.
  * Hence even when the load factor reaches 100%, performance remains good.
  *
+ * The node layout is shared with the interpreter and native code: instructions cache the node index of a constant key, and
+ * metatable __index lookups treat a node without a chain link as proof that the key is absent. An alternative layout (such as
+ * open addressing with separate control bytes) would have to replace all of these fast paths at once.
+ *
  * Table keys can be arbitrary values unless they contain NaN. Keys are hashed and compared using raw equality,
  * so even if the key is a userdata with an overridden __eq, it's not used during hash lookups.
  *
@@ -375,6 +379,7 @@ static TValue* arrayornewkey(lua_State* L, Table* t, const TValue* key)
 
 static void resize(lua_State* L, Table* t, int nasize, int nhsize)
 {
+    LUAU_ASSERT(!luaH_isshared(t));
     if (nasize > MAXSIZE || nhsize > MAXSIZE)
         luaG_runerror(L, "table overflow");
     int oldasize = t->sizearray;
@@ -491,6 +496,72 @@ static void rehash(lua_State* L, Table* t, const TValue* ek)
 ** }=============================================================
 */
 
+/*
+** Shared storage
+**
+** A copy-on-write clone shares the array and node vectors of its source until either table is written to. Shared vectors
+** are allocated with one extra element past the end that holds the reference count and the memory category the vector
+** is accounted in. Sharing is recorded in Table::readonly bits so that the existing readonly checks route all writes
+** through luaH_makewritable, which gives the writer its own copy.
+*/
+struct SharedStorage
+{
+    int refs;
+    uint8_t memcat;
+};
+
+static_assert(sizeof(SharedStorage) <= sizeof(TValue), "shared storage header must fit in an array element");
+static_assert(sizeof(SharedStorage) <= sizeof(LuaNode), "shared storage header must fit in a node");
+
+#define sharedarray(t) cast_to(SharedStorage*, &(t)->array[(t)->sizearray])
+#define sharednode(t) cast_to(SharedStorage*, &(t)->node[sizenode(t)])
+
+static void sharearray(lua_State* L, Table* t)
+{
+    if (!(t->readonly & LUAH_SHAREDARRAY))
+    {
+        luaM_reallocarray(L, t->array, t->sizearray, t->sizearray + 1, TValue, t->memcat);
+        SharedStorage* ss = sharedarray(t);
+        ss->refs = 1;
+        ss->memcat = t->memcat;
+        t->readonly |= LUAH_SHAREDARRAY;
+    }
+
+    sharedarray(t)->refs++;
+}
+
+static void sharenode(lua_State* L, Table* t)
+{
+    if (!(t->readonly & LUAH_SHAREDNODE))
+    {
+        luaM_reallocarray(L, t->node, sizenode(t), sizenode(t) + 1, LuaNode, t->memcat);
+        SharedStorage* ss = sharednode(t);
+        ss->refs = 1;
+        ss->memcat = t->memcat;
+        t->readonly |= LUAH_SHAREDNODE;
+    }
+
+    sharednode(t)->refs++;
+}
+
+static void releasesharedarray(lua_State* L, Table* t)
+{
+    SharedStorage* ss = sharedarray(t);
+    uint8_t memcat = ss->memcat;
+
+    if (--ss->refs == 0)
+        luaM_freearray(L, t->array, t->sizearray + 1, TValue, memcat);
+}
+
+static void releasesharednode(lua_State* L, Table* t)
+{
+    SharedStorage* ss = sharednode(t);
+    uint8_t memcat = ss->memcat;
+
+    if (--ss->refs == 0)
+        luaM_freearray(L, t->node, sizenode(t) + 1, LuaNode, memcat);
+}
+
 Table* luaH_new(lua_State* L, int narray, int nhash)
 {
     Table* t = luaM_newgco(L, Table, sizeof(Table), L->activememcat);
@@ -515,9 +586,19 @@ Table* luaH_new(lua_State* L, int narray, int nhash)
 void luaH_free(lua_State* L, Table* t, lua_Page* page)
 {
     if (t->node != dummynode)
-        luaM_freearray(L, t->node, sizenode(t), LuaNode, t->memcat);
+    {
+        if (t->readonly & LUAH_SHAREDNODE)
+            releasesharednode(L, t);
+        else
+            luaM_freearray(L, t->node, sizenode(t), LuaNode, t->memcat);
+    }
     if (t->array)
-        luaM_freearray(L, t->array, t->sizearray, TValue, t->memcat);
+    {
+        if (t->readonly & LUAH_SHAREDARRAY)
+            releasesharedarray(L, t);
+        else
+            luaM_freearray(L, t->array, t->sizearray, TValue, t->memcat);
+    }
     luaM_freegco(L, t, sizeof(Table), t->memcat, page);
 }
 
@@ -689,6 +770,7 @@ TValue* luaH_set(lua_State* L, Table* t, const TValue* key)
 
 TValue* luaH_newkey(lua_State* L, Table* t, const TValue* key)
 {
+    LUAU_ASSERT(!luaH_isshared(t));
     if (ttisnil(key))
         luaG_runerror(L, "table index is nil");
     else if (ttisnumber(key) && luai_numisnan(nvalue(key)))
@@ -830,8 +912,99 @@ Table* luaH_clone(lua_State* L, Table* tt)
     return t;
 }
 
+Table* luaH_cloneshared(lua_State* L, Table* tt)
+{
+    // weak tables are cleared in place by the collector, so their storage can't be shared
+    if (gfasttm(L->global, tt->metatable, TM_MODE))
+        return luaH_clone(L, tt);
+
+    Table* t = luaM_newgco(L, Table, sizeof(Table), L->activememcat);
+    luaC_init(L, t, LUA_TTABLE);
+    t->metatable = tt->metatable;
+    t->tmcache = tt->tmcache;
+    t->array = NULL;
+    t->sizearray = 0;
+    t->lsizenode = 0;
+    t->nodemask8 = 0;
+    t->readonly = 0;
+    t->safeenv = 0;
+    t->node = cast_to(LuaNode*, dummynode);
+    t->lastfree = 0;
+
+    // the new table stays valid after each step, in case sharing the next part fails to allocate
+    if (tt->sizearray)
+    {
+        sharearray(L, tt);
+
+        t->array = tt->array;
+        maybesetaboundary(t, getaboundary(tt));
+        t->sizearray = tt->sizearray;
+        t->readonly |= LUAH_SHAREDARRAY;
+    }
+
+    if (tt->node != dummynode)
+    {
+        sharenode(L, tt);
+
+        t->node = tt->node;
+        t->lsizenode = tt->lsizenode;
+        t->nodemask8 = tt->nodemask8;
+        t->lastfree = tt->lastfree;
+        t->readonly |= LUAH_SHAREDNODE;
+    }
+
+    return t;
+}
+
+void luaH_makewritable(lua_State* L, Table* t)
+{
+    if (t->readonly & LUAH_READONLY)
+        luaG_readonlyerror(L);
+
+    // contents of the private copy are the same as the shared ones, so there are no new references to report to the GC
+    if (t->readonly & LUAH_SHAREDARRAY)
+    {
+        SharedStorage* ss = sharedarray(t);
+
+        if (ss->refs == 1 && ss->memcat == t->memcat)
+        {
+            luaM_reallocarray(L, t->array, t->sizearray + 1, t->sizearray, TValue, t->memcat);
+        }
+        else
+        {
+            TValue* array = luaM_newarray(L, t->sizearray, TValue, t->memcat);
+            memcpy(array, t->array, t->sizearray * sizeof(TValue));
+            releasesharedarray(L, t);
+            t->array = array;
+        }
+
+        t->readonly &= ~LUAH_SHAREDARRAY;
+    }
+
+    if (t->readonly & LUAH_SHAREDNODE)
+    {
+        SharedStorage* ss = sharednode(t);
+
+        if (ss->refs == 1 && ss->memcat == t->memcat)
+        {
+            luaM_reallocarray(L, t->node, sizenode(t) + 1, sizenode(t), LuaNode, t->memcat);
+        }
+        else
+        {
+            LuaNode* node = luaM_newarray(L, sizenode(t), LuaNode, t->memcat);
+            memcpy(node, t->node, sizenode(t) * sizeof(LuaNode));
+            releasesharednode(L, t);
+            t->node = node;
+        }
+
+        t->readonly &= ~LUAH_SHAREDNODE;
+    }
+}
+
 void luaH_clear(Table* tt)
 {
+    LUAU_ASSERT(!luaH_isshared(tt));
+
     // clear array part
     for (int i = 0; i < tt->sizearray; ++i)
     {
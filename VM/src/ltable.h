@@ -14,6 +14,13 @@
 // reset cache of absent metamethods, cache is updated in luaT_gettm
 #define invalidateTMcache(t) t->tmcache = 0
 
+// bits of Table::readonly; any set bit forces writes to take the slow path
+#define LUAH_READONLY 1     // table is frozen by the user
+#define LUAH_SHAREDARRAY 2  // array part is shared with other tables until the first write
+#define LUAH_SHAREDNODE 4   // node part is shared with other tables until the first write
+
+#define luaH_isshared(t) (((t)->readonly & (LUAH_SHAREDARRAY | LUAH_SHAREDNODE)) != 0)
+
 LUAI_FUNC const TValue* luaH_getnum(Table* t, int key);
 LUAI_FUNC TValue* luaH_setnum(lua_State* L, Table* t, int key);
 LUAI_FUNC const TValue* luaH_getstr(Table* t, TString* key);
@@ -28,6 +35,8 @@ LUAI_FUNC void luaH_free(lua_State* L, Table* t, struct lua_Page* page);
 LUAI_FUNC int luaH_next(lua_State* L, Table* t, StkId key);
 LUAI_FUNC int luaH_getn(Table* t);
 LUAI_FUNC Table* luaH_clone(lua_State* L, Table* tt);
+LUAI_FUNC Table* luaH_cloneshared(lua_State* L, Table* tt);
+LUAI_FUNC void luaH_makewritable(lua_State* L, Table* t);
 LUAI_FUNC void luaH_clear(Table* tt);
 
 #define luaH_setslot(L, t, slot, key) (invalidateTMcache(t), (slot == luaO_nilobject ? luaH_newkey(L, t, key) : cast_to(TValue*, slot)))
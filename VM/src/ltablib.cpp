@@ -112,7 +112,7 @@ static void moveelements(lua_State* L, int srct, int dstt, int f, int e, int t)
     Table* dst = hvalue(L->base + (dstt - 1));
 
     if (dst->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, dst);
 
     int n = e - f + 1; // number of elements to move
 
@@ -299,7 +299,7 @@ static int tmove(lua_State* L)
         Table* dst = hvalue(L->base + (tt - 1));
 
         if (dst->readonly) // also checked in moveelements, but this blocks resizes of r/o tables
-            luaG_readonlyerror(L);
+            luaH_makewritable(L, dst);
 
         if (t > 0 && (t - 1) <= dst->sizearray && (t - 1 + n) > dst->sizearray)
         { // grow the destination table array
@@ -439,8 +439,8 @@ inline int sort_less(lua_State* L, Table* t, int i, int j, SortPredicate pred)
 
     int res = pred(L, &arr[i], &arr[j]);
 
-    // predicate call may resize the table, which is invalid
-    if (t->sizearray != n)
+    // predicate call may resize the table or share its array with a clone, which is invalid
+    if (t->sizearray != n || (t->readonly & LUAH_SHAREDARRAY))
         luaL_error(L, "table modified during sorting");
 
     return res;
@@ -563,7 +563,7 @@ static int tsort(lua_State* L)
     Table* t = hvalue(L->base);
     int n = luaH_getn(t);
     if (t->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, t);
 
     SortPredicate pred = luaV_lessthan;
     if (!lua_isnoneornil(L, 2)) // is there a 2nd argument?
@@ -639,7 +639,7 @@ static int tclear(lua_State* L)
 
     Table* tt = hvalue(L->base);
     if (tt->readonly)
-        luaG_readonlyerror(L);
+        luaH_makewritable(L, tt);
 
     luaH_clear(tt);
     return 0;
@@ -63,7 +63,9 @@
 #define VM_KV(i) (LUAU_ASSERT(unsigned(i) < unsigned(cl->l.p->sizek)), &k[i])
 #define VM_UV(i) (LUAU_ASSERT(unsigned(i) < unsigned(cl->nupvalues)), &cl->l.uprefs[i])
 
-#define VM_PATCH_C(pc, slot) *const_cast<Instruction*>(pc) = ((uint8_t(slot) << 24) | (0x00ffffffu & *(pc)))
+// instructions of functions loaded from a bytecode image are shared with other states and possibly other threads, so slot hints are not updated
+#define VM_PATCH_C(pc, slot) \
+    (cl->l.p->image ? void() : void(*const_cast<Instruction*>(pc) = ((uint8_t(slot) << 24) | (0x00ffffffu & *(pc)))))
 #define VM_PATCH_E(pc, slot) *const_cast<Instruction*>(pc) = ((uint32_t(slot) << 8) | (0x000000ffu & *(pc)))
 
 #define VM_INTERRUPT() \
@@ -102,7 +104,8 @@
         VM_DISPATCH_OP(LOP_CAPTURE), VM_DISPATCH_OP(LOP_SUBRK), VM_DISPATCH_OP(LOP_DIVRK), VM_DISPATCH_OP(LOP_FASTCALL1), \
         VM_DISPATCH_OP(LOP_FASTCALL2), VM_DISPATCH_OP(LOP_FASTCALL2K), VM_DISPATCH_OP(LOP_FORGPREP), VM_DISPATCH_OP(LOP_JUMPXEQKNIL), \
         VM_DISPATCH_OP(LOP_JUMPXEQKB), VM_DISPATCH_OP(LOP_JUMPXEQKN), VM_DISPATCH_OP(LOP_JUMPXEQKS), VM_DISPATCH_OP(LOP_IDIV), \
-        VM_DISPATCH_OP(LOP_IDIVK),
+        VM_DISPATCH_OP(LOP_IDIVK), VM_DISPATCH_OP(LOP_GETTABLE_GETTABLE), VM_DISPATCH_OP(LOP_GETTABLE_ADD), \
+        VM_DISPATCH_OP(LOP_GETTABLEKS_GETTABLEKS),
 
 #if defined(__GNUC__) || defined(__clang__)
 #define VM_USE_CGOTO 1
@@ -110,6 +113,48 @@
 #define VM_USE_CGOTO 0
 #endif
 
+// Execution counters are only collected when LUAI_EXECCOUNTERS is enabled; opcode handlers that continue into another handler (BREAK, superinstructions)
+// count both opcodes
+#if LUAI_EXECCOUNTERS
+#define VM_COUNTOP(op) L->global->execops[op]++
+#define VM_COUNTCALL(p) (p)->execcalls++
+#define VM_COUNTLOOP() cl->l.p->execloops++
+#else
+#define VM_COUNTOP(op) ((void)0)
+#define VM_COUNTCALL(p) ((void)0)
+#define VM_COUNTLOOP() ((void)0)
+#endif
+
+// Functions that reach the tier-up threshold in the interpreter are passed to the execution callbacks once; compiled code is used from the next call
+#define VM_TIERUP(p) \
+    { \
+        if (LUAU_UNLIKELY((p)->tierupcount > 0) && --(p)->tierupcount == 0 && L->global->ecb.tierup) \
+            L->global->ecb.tierup(L, p); \
+    }
+
+// Loop back edges tier up in the middle of a frame; the callback may allocate, throw or read debug info, so it needs to see the current pc
+#define VM_TIERUP_LOOP() \
+    { \
+        Proto* tp = cl->l.p; \
+        if (LUAU_UNLIKELY(tp->tierupcount > 0) && --tp->tierupcount == 0 && L->global->ecb.tierup) \
+        { \
+            VM_PROTECT_PC(); \
+            L->global->ecb.tierup(L, tp); \
+        } \
+    }
+
+// Functions loaded with type feedback enabled record the operand tags that instructions observe, for tier-up compilation to specialize on;
+// the check is only compiled in with LUAI_TYPEFEEDBACK since it's on the path of every table access and arithmetic instruction
+#if LUAI_TYPEFEEDBACK
+#define VM_TYPEFEEDBACK(insnpc, slot, o) \
+    { \
+        if (LUAU_UNLIKELY(cl->l.p->typefeedback != NULL)) \
+            recordtypefeedback(cl->l.p->typefeedback[2 * ((insnpc) - cl->l.p->code) + (slot)], ttype(o)); \
+    }
+#else
+#define VM_TYPEFEEDBACK(insnpc, slot, o) ((void)0)
+#endif
+
 /**
  * These macros help dispatching Luau opcodes using either case
  * statements or computed goto.
@@ -119,11 +164,11 @@
  * switch statement to skip a LOP_BREAK instruction.
  */
 #if VM_USE_CGOTO
-#define VM_CASE(op) CASE_##op:
+#define VM_CASE(op) CASE_##op: VM_COUNTOP(op);
 #define VM_NEXT() goto*(SingleStep ? &&dispatch : kDispatchTable[LUAU_INSN_OP(*pc)])
 #define VM_CONTINUE(op) goto* kDispatchTable[uint8_t(op)]
 #else
-#define VM_CASE(op) case op:
+#define VM_CASE(op) case op: VM_COUNTOP(op);
 #define VM_NEXT() goto dispatch
 #define VM_CONTINUE(op) \
     dispatchOp = uint8_t(op); \
@@ -133,6 +178,14 @@
 // Does VM support native execution via ExecutionCallbacks? We mostly assume it does but keep the define to make it easy to quantify the cost.
 #define VM_HAS_NATIVE 1
 
+#if LUAI_TYPEFEEDBACK
+LUAU_FORCEINLINE static void recordtypefeedback(uint8_t& feedback, int tt)
+{
+    if (feedback != tt + 1)
+        feedback = feedback == 0 ? uint8_t(tt + 1) : TYPEFEEDBACK_MIXED;
+}
+#endif
+
 LUAU_NOINLINE void luau_callhook(lua_State* L, lua_Hook hook, void* userdata)
 {
     ptrdiff_t base = savestack(L, L->base);
@@ -186,6 +239,152 @@ LUAU_NOINLINE void luau_callhook(lua_State* L, lua_Hook hook, void* userdata)
     }
 }
 
+/*
+** Polymorphic inline caches
+**
+** GETTABLEKS and NAMECALL keep a slot hint in the instruction, which keeps missing when a call site sees objects of several classes.
+** On a miss, the instruction falls back to a per-proto cache that maps the metatables seen by the instruction to the node slot of the
+** key, either in the indexed table itself or in the __index table of the metatable. Slots are hints that are validated against the node
+** key, so entries never have to be invalidated, and metatables are compared by identity without being dereferenced.
+*/
+static LUAU_FORCEINLINE const TValue* luau_inlinecacheget(lua_State* L, Proto* p, const Instruction* pc, Table* h, Table* mt, TString* key)
+{
+    if (!p->inlinecache)
+        return NULL;
+
+    int pcoff = int(pc - p->code);
+    InlineCache* ic = &p->inlinecache[pcoff & (p->sizeinlinecache - 1)];
+
+    if (ic->pcoff != pcoff)
+        return NULL;
+
+    for (int i = 0; i < INLINECACHE_WAYS; i++)
+    {
+        if (ic->metatables[i] != mt)
+            continue;
+
+        Table* t = h;
+
+        if (ic->inherited & (1 << i))
+        {
+            // the key must be absent from the table itself; the main position of the key has no chain when that's the case
+            if (h)
+            {
+                LuaNode* n = &h->node[key->hash & (sizenode(h) - 1)];
+
+                if (ttisstring(gkey(n)) && tsvalue(gkey(n)) == key && !ttisnil(gval(n)))
+                    return gval(n);
+
+                if (gnext(n) != 0)
+                    return NULL;
+            }
+
+            const TValue* tm = fasttm(L, mt, TM_INDEX);
+
+            if (!tm || !ttistable(tm))
+                return NULL;
+
+            t = hvalue(tm);
+        }
+        else if (!h)
+        {
+            // the entry was recorded for a table that has the key itself, which doesn't apply to userdata with the same metatable
+            return NULL;
+        }
+
+        LuaNode* n = &t->node[ic->slots[i] & (sizenode(t) - 1)];
+
+        if (ttisstring(gkey(n)) && tsvalue(gkey(n)) == key && !ttisnil(gval(n)))
+            return gval(n);
+
+        return NULL;
+    }
+
+    return NULL;
+}
+
+// looks the key up in the table (if any) and in the __index table of the metatable without invoking metamethods, recording the slot in the cache
+// when the key is in neither, 'next' is set to the __index table so that the slow path doesn't repeat the lookup in the table
+static LUAU_NOINLINE const TValue* luau_inlinecachemiss(
+    lua_State* L, Proto* p, const Instruction* pc, Table* h, Table* mt, TString* key, const TValue** next
+)
+{
+    const TValue* tm = fasttm(L, mt, TM_INDEX);
+
+    // __index functions are handled by the slow path
+    if (tm && !ttistable(tm))
+        return NULL;
+
+    const TValue* res = h ? luaH_getstr(h, key) : luaO_nilobject;
+    bool inherited = false;
+    int slot = 0;
+
+    if (!ttisnil(res))
+    {
+        slot = gval2slot(h, res);
+    }
+    else if (tm && !ttisnil(res = luaH_getstr(hvalue(tm), key)))
+    {
+        slot = gval2slot(hvalue(tm), res);
+        inherited = true;
+    }
+    else
+    {
+        if (tm)
+            *next = tm;
+
+        return NULL;
+    }
+
+    if (!p->inlinecache)
+    {
+        // each key lookup takes two instruction words, so this is about one entry per lookup for small functions
+        int size = 8;
+        while (size < p->sizecode / 4 && size < 1024)
+            size *= 2;
+
+        p->inlinecache = luaM_newarray(L, size, InlineCache, p->memcat);
+        p->sizeinlinecache = size;
+
+        for (int i = 0; i < size; i++)
+            p->inlinecache[i].pcoff = -1;
+    }
+
+    int pcoff = int(pc - p->code);
+    InlineCache* ic = &p->inlinecache[pcoff & (p->sizeinlinecache - 1)];
+
+    if (ic->pcoff != pcoff)
+    {
+        ic->pcoff = pcoff;
+        ic->inherited = 0;
+        ic->next = 0;
+
+        for (int i = 0; i < INLINECACHE_WAYS; i++)
+            ic->metatables[i] = NULL;
+    }
+
+    int way = 0;
+    while (way < INLINECACHE_WAYS && ic->metatables[way] != mt)
+        way++;
+
+    if (way == INLINECACHE_WAYS)
+    {
+        way = ic->next;
+        ic->next = uint8_t((ic->next + 1) % INLINECACHE_WAYS);
+    }
+
+    ic->metatables[way] = mt;
+    ic->slots[way] = slot;
+    ic->inherited = uint8_t(inherited ? ic->inherited | (1 << way) : ic->inherited & ~(1 << way));
+
+    // the instruction keeps the last slot as well, so a call site that turns monomorphic stays on the fastest path
+    Closure* cl = clvalue(L->ci->func);
+    LUAU_ASSERT(cl->l.p == p);
+    VM_PATCH_C(pc, slot);
+
+    return res;
+}
+
 inline bool luau_skipstep(uint8_t op)
 {
     return op == LOP_PREPVARARGS || op == LOP_BREAK;
@@ -445,6 +644,7 @@ reentry:
                 uint32_t aux = *pc++;
                 TValue* kv = VM_KV(aux);
                 LUAU_ASSERT(ttisstring(kv));
+                VM_TYPEFEEDBACK(pc - 2, 0, rb);
 
                 // fast-path: built-in table
                 if (LUAU_LIKELY(ttistable(rb)))
@@ -477,9 +677,25 @@ reentry:
                     }
                     else
                     {
+                        // fast-path: polymorphic inline cache has the slot for this metatable
+                        if (const TValue* res = luau_inlinecacheget(L, cl->l.p, pc - 2, h, h->metatable, tsvalue(kv)))
+                        {
+                            setobj2s(L, ra, res);
+                            VM_NEXT();
+                        }
+
+                        // fast-path: value is in the table or in the __index table of the metatable
+                        const TValue* next = rb;
+                        VM_PROTECT_PC(); // inline cache allocation may fail due to OOM
+                        if (const TValue* res = luau_inlinecachemiss(L, cl->l.p, pc - 2, h, h->metatable, tsvalue(kv), &next))
+                        {
+                            setobj2s(L, ra, res);
+                            VM_NEXT();
+                        }
+
                         // slow-path, may invoke Lua calls via __index metamethod
                         L->cachedslot = slot;
-                        VM_PROTECT(luaV_gettable(L, rb, kv, ra));
+                        VM_PROTECT(luaV_gettable(L, next, kv, ra));
                         // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
                         VM_PATCH_C(pc - 2, L->cachedslot);
                         VM_NEXT();
@@ -554,6 +770,43 @@ reentry:
                 VM_NEXT();
             }
 
+            VM_CASE(LOP_GETTABLEKS_GETTABLEKS)
+            {
+                Instruction insn = *pc;
+                StkId ra = VM_REG(LUAU_INSN_A(insn));
+                StkId rb = VM_REG(LUAU_INSN_B(insn));
+                uint32_t aux = pc[1];
+                TValue* kv = VM_KV(aux);
+                LUAU_ASSERT(ttisstring(kv));
+                VM_TYPEFEEDBACK(pc, 0, rb);
+
+                // fast-path: value is in expected slot of a table
+                if (LUAU_LIKELY(ttistable(rb)))
+                {
+                    Table* h = hvalue(rb);
+
+                    int slot = LUAU_INSN_C(insn) & h->nodemask8;
+                    LuaNode* n = &h->node[slot];
+
+                    if (LUAU_LIKELY(ttisstring(gkey(n)) && tsvalue(gkey(n)) == tsvalue(kv) && !ttisnil(gval(n))))
+                    {
+                        setobj2s(L, ra, gval(n));
+                        pc += 2;
+
+                        // second GETTABLEKS skips dispatch unless it's a breakpoint or we are stepping through the code
+                        if (LUAU_LIKELY(!SingleStep && LUAU_INSN_OP(*pc) == LOP_GETTABLEKS))
+                        {
+                            VM_CONTINUE(LOP_GETTABLEKS);
+                        }
+
+                        VM_NEXT();
+                    }
+                }
+
+                // slow-path: regular GETTABLEKS handles the first instruction and dispatches to the second one
+                VM_CONTINUE(LOP_GETTABLEKS);
+            }
+
             VM_CASE(LOP_SETTABLEKS)
             {
                 Instruction insn = *pc++;
@@ -562,6 +815,7 @@ reentry:
                 uint32_t aux = *pc++;
                 TValue* kv = VM_KV(aux);
                 LUAU_ASSERT(ttisstring(kv));
+                VM_TYPEFEEDBACK(pc - 2, 0, rb);
 
                 // fast-path: built-in table
                 if (LUAU_LIKELY(ttistable(rb)))
@@ -636,6 +890,8 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 StkId rc = VM_REG(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
+                VM_TYPEFEEDBACK(pc - 1, 1, rc);
 
                 // fast-path: array lookup
                 if (ttistable(rb) && ttisnumber(rc))
@@ -660,12 +916,88 @@ reentry:
                 VM_NEXT();
             }
 
+            VM_CASE(LOP_GETTABLE_GETTABLE)
+            {
+                Instruction insn = *pc;
+                StkId ra = VM_REG(LUAU_INSN_A(insn));
+                StkId rb = VM_REG(LUAU_INSN_B(insn));
+                StkId rc = VM_REG(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc, 0, rb);
+                VM_TYPEFEEDBACK(pc, 1, rc);
+
+                // fast-path: array lookup
+                if (LUAU_LIKELY(ttistable(rb) && ttisnumber(rc)))
+                {
+                    Table* h = hvalue(rb);
+
+                    double indexd = nvalue(rc);
+                    int index = int(indexd);
+
+                    // index has to be an exact integer and in-bounds for the array portion
+                    if (LUAU_LIKELY(unsigned(index - 1) < unsigned(h->sizearray) && !h->metatable && double(index) == indexd))
+                    {
+                        setobj2s(L, ra, &h->array[unsigned(index - 1)]);
+                        pc++;
+
+                        // second GETTABLE skips dispatch unless it's a breakpoint or we are stepping through the code
+                        if (LUAU_LIKELY(!SingleStep && LUAU_INSN_OP(*pc) == LOP_GETTABLE))
+                        {
+                            VM_CONTINUE(LOP_GETTABLE);
+                        }
+
+                        VM_NEXT();
+                    }
+                }
+
+                // slow-path: regular GETTABLE handles the first instruction and dispatches to the second one
+                VM_CONTINUE(LOP_GETTABLE);
+            }
+
+            VM_CASE(LOP_GETTABLE_ADD)
+            {
+                Instruction insn = *pc;
+                StkId ra = VM_REG(LUAU_INSN_A(insn));
+                StkId rb = VM_REG(LUAU_INSN_B(insn));
+                StkId rc = VM_REG(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc, 0, rb);
+                VM_TYPEFEEDBACK(pc, 1, rc);
+
+                // fast-path: array lookup
+                if (LUAU_LIKELY(ttistable(rb) && ttisnumber(rc)))
+                {
+                    Table* h = hvalue(rb);
+
+                    double indexd = nvalue(rc);
+                    int index = int(indexd);
+
+                    // index has to be an exact integer and in-bounds for the array portion
+                    if (LUAU_LIKELY(unsigned(index - 1) < unsigned(h->sizearray) && !h->metatable && double(index) == indexd))
+                    {
+                        setobj2s(L, ra, &h->array[unsigned(index - 1)]);
+                        pc++;
+
+                        // ADD skips dispatch unless it's a breakpoint or we are stepping through the code
+                        if (LUAU_LIKELY(!SingleStep && LUAU_INSN_OP(*pc) == LOP_ADD))
+                        {
+                            VM_CONTINUE(LOP_ADD);
+                        }
+
+                        VM_NEXT();
+                    }
+                }
+
+                // slow-path: regular GETTABLE handles the first instruction and dispatches to the second one
+                VM_CONTINUE(LOP_GETTABLE);
+            }
+
             VM_CASE(LOP_SETTABLE)
             {
                 Instruction insn = *pc++;
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 StkId rc = VM_REG(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
+                VM_TYPEFEEDBACK(pc - 1, 1, rc);
 
                 // fast-path: array assign
                 if (ttistable(rb) && ttisnumber(rc))
@@ -697,6 +1029,7 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 int c = LUAU_INSN_C(insn);
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
 
                 // fast-path: array lookup
                 if (ttistable(rb))
@@ -725,6 +1058,7 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 int c = LUAU_INSN_C(insn);
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
 
                 // fast-path: array assign
                 if (ttistable(rb))
@@ -799,6 +1133,7 @@ reentry:
                 uint32_t aux = *pc++;
                 TValue* kv = VM_KV(aux);
                 LUAU_ASSERT(ttisstring(kv));
+                VM_TYPEFEEDBACK(pc - 2, 0, rb);
 
                 if (LUAU_LIKELY(ttistable(rb)))
                 {
@@ -828,16 +1163,41 @@ reentry:
                     }
                     else
                     {
-                        // slow-path: handles full table lookup
-                        setobj2s(L, ra + 1, rb);
-                        L->cachedslot = LUAU_INSN_C(insn);
-                        VM_PROTECT(luaV_gettable(L, rb, kv, ra));
-                        // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
-                        VM_PATCH_C(pc - 2, L->cachedslot);
-                        // recompute ra since stack might have been reallocated
-                        ra = VM_REG(LUAU_INSN_A(insn));
-                        if (ttisnil(ra))
-                            luaG_methoderror(L, ra + 1, tsvalue(kv));
+                        const TValue* res = NULL;
+                        const TValue* next = rb;
+
+                        if (h->metatable)
+                        {
+                            // fast-path: polymorphic inline cache has the slot for this metatable
+                            res = luau_inlinecacheget(L, cl->l.p, pc - 2, h, h->metatable, tsvalue(kv));
+
+                            // fast-path: method is in the table or in the __index table of the metatable
+                            if (!res)
+                            {
+                                VM_PROTECT_PC(); // inline cache allocation may fail due to OOM
+                                res = luau_inlinecachemiss(L, cl->l.p, pc - 2, h, h->metatable, tsvalue(kv), &next);
+                            }
+                        }
+
+                        if (res)
+                        {
+                            // note: order of copies allows rb to alias ra+1 or ra
+                            setobj2s(L, ra + 1, rb);
+                            setobj2s(L, ra, res);
+                        }
+                        else
+                        {
+                            // slow-path: handles full table lookup
+                            setobj2s(L, ra + 1, rb);
+                            L->cachedslot = LUAU_INSN_C(insn);
+                            VM_PROTECT(luaV_gettable(L, next, kv, ra));
+                            // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
+                            VM_PATCH_C(pc - 2, L->cachedslot);
+                            // recompute ra since stack might have been reallocated
+                            ra = VM_REG(LUAU_INSN_A(insn));
+                            if (ttisnil(ra))
+                                luaG_methoderror(L, ra + 1, tsvalue(kv));
+                        }
                     }
                 }
                 else
@@ -869,16 +1229,36 @@ reentry:
                         }
                         else
                         {
-                            // slow-path: handles slot mismatch
-                            setobj2s(L, ra + 1, rb);
-                            L->cachedslot = slot;
-                            VM_PROTECT(luaV_gettable(L, rb, kv, ra));
-                            // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
-                            VM_PATCH_C(pc - 2, L->cachedslot);
-                            // recompute ra since stack might have been reallocated
-                            ra = VM_REG(LUAU_INSN_A(insn));
-                            if (ttisnil(ra))
-                                luaG_methoderror(L, ra + 1, tsvalue(kv));
+                            // fast-path: polymorphic inline cache has the slot for this metatable
+                            const TValue* res = luau_inlinecacheget(L, cl->l.p, pc - 2, NULL, mt, tsvalue(kv));
+                            const TValue* next = rb;
+
+                            // fast-path: method is in the __index table in another slot
+                            if (!res)
+                            {
+                                VM_PROTECT_PC(); // inline cache allocation may fail due to OOM
+                                res = luau_inlinecachemiss(L, cl->l.p, pc - 2, NULL, mt, tsvalue(kv), &next);
+                            }
+
+                            if (res)
+                            {
+                                // note: order of copies allows rb to alias ra+1 or ra
+                                setobj2s(L, ra + 1, rb);
+                                setobj2s(L, ra, res);
+                            }
+                            else
+                            {
+                                // slow-path: handles slot mismatch
+                                setobj2s(L, ra + 1, rb);
+                                L->cachedslot = slot;
+                                VM_PROTECT(luaV_gettable(L, next, kv, ra));
+                                // save cachedslot to accelerate future lookups; patches currently executing instruction since pc-2 rolls back two pc++
+                                VM_PATCH_C(pc - 2, L->cachedslot);
+                                // recompute ra since stack might have been reallocated
+                                ra = VM_REG(LUAU_INSN_A(insn));
+                                if (ttisnil(ra))
+                                    luaG_methoderror(L, ra + 1, tsvalue(kv));
+                            }
                         }
                     }
                     else
@@ -942,6 +1322,8 @@ reentry:
                 if (!ccl->isC)
                 {
                     Proto* p = ccl->l.p;
+                    VM_COUNTCALL(p);
+                    VM_TIERUP(p);
 
                     // fill unused parameters with nil
                     StkId argi = L->top;
@@ -1453,6 +1835,8 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 StkId rc = VM_REG(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
+                VM_TYPEFEEDBACK(pc - 1, 1, rc);
 
                 // fast-path
                 if (LUAU_LIKELY(ttisnumber(rb) && ttisnumber(rc)))
@@ -1499,6 +1883,8 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 StkId rc = VM_REG(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
+                VM_TYPEFEEDBACK(pc - 1, 1, rc);
 
                 // fast-path
                 if (LUAU_LIKELY(ttisnumber(rb) && ttisnumber(rc)))
@@ -1545,6 +1931,8 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 StkId rc = VM_REG(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
+                VM_TYPEFEEDBACK(pc - 1, 1, rc);
 
                 // fast-path
                 if (LUAU_LIKELY(ttisnumber(rb) && ttisnumber(rc)))
@@ -1606,6 +1994,8 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 StkId rc = VM_REG(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
+                VM_TYPEFEEDBACK(pc - 1, 1, rc);
 
                 // fast-path
                 if (LUAU_LIKELY(ttisnumber(rb) && ttisnumber(rc)))
@@ -1667,6 +2057,8 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 StkId rc = VM_REG(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
+                VM_TYPEFEEDBACK(pc - 1, 1, rc);
 
                 // fast-path
                 if (LUAU_LIKELY(ttisnumber(rb) && ttisnumber(rc)))
@@ -1715,6 +2107,8 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 StkId rc = VM_REG(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
+                VM_TYPEFEEDBACK(pc - 1, 1, rc);
 
                 // fast-path
                 if (ttisnumber(rb) && ttisnumber(rc))
@@ -1738,6 +2132,8 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 StkId rc = VM_REG(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
+                VM_TYPEFEEDBACK(pc - 1, 1, rc);
 
                 // fast-path
                 if (ttisnumber(rb) && ttisnumber(rc))
@@ -1759,6 +2155,7 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 TValue* kv = VM_KV(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
 
                 // fast-path
                 if (ttisnumber(rb))
@@ -1780,6 +2177,7 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 TValue* kv = VM_KV(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
 
                 // fast-path
                 if (ttisnumber(rb))
@@ -1801,6 +2199,7 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 TValue* kv = VM_KV(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
 
                 // fast-path
                 if (LUAU_LIKELY(ttisnumber(rb)))
@@ -1847,6 +2246,7 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 TValue* kv = VM_KV(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
 
                 // fast-path
                 if (LUAU_LIKELY(ttisnumber(rb)))
@@ -1893,6 +2293,7 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 TValue* kv = VM_KV(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
 
                 // fast-path
                 if (LUAU_LIKELY(ttisnumber(rb)))
@@ -1940,6 +2341,7 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 TValue* kv = VM_KV(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
 
                 // fast-path
                 if (ttisnumber(rb))
@@ -1963,6 +2365,7 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
                 TValue* kv = VM_KV(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
 
                 // fast-path
                 if (ttisnumber(rb))
@@ -2060,6 +2463,7 @@ reentry:
                 Instruction insn = *pc++;
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 StkId rb = VM_REG(LUAU_INSN_B(insn));
+                VM_TYPEFEEDBACK(pc - 1, 0, rb);
 
                 // fast-path
                 if (LUAU_LIKELY(ttisnumber(rb)))
@@ -2240,6 +2644,8 @@ reentry:
                 // Note: make sure the loop condition is exactly the same between this and LOP_FORNPREP so that we handle NaN/etc. consistently
                 if (step > 0 ? idx <= limit : limit <= idx)
                 {
+                    VM_COUNTLOOP();
+                    VM_TIERUP_LOOP();
                     pc += LUAU_INSN_D(insn);
                     LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
                     VM_NEXT();
@@ -2350,6 +2756,8 @@ reentry:
                             setnvalue(ra + 3, double(index + 1));
                             setobj2s(L, ra + 4, e);
 
+                            VM_COUNTLOOP();
+                            VM_TIERUP_LOOP();
                             pc += LUAU_INSN_D(insn);
                             LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
                             VM_NEXT();
@@ -2371,6 +2779,8 @@ reentry:
                             getnodekey(L, ra + 3, n);
                             setobj2s(L, ra + 4, gval(n));
 
+                            VM_COUNTLOOP();
+                            VM_TIERUP_LOOP();
                             pc += LUAU_INSN_D(insn);
                             LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
                             VM_NEXT();
@@ -2402,6 +2812,12 @@ reentry:
                     // copy first variable back into the iteration index
                     setobj2s(L, ra + 2, ra + 3);
 
+                    if (!ttisnil(ra + 3))
+                    {
+                        VM_COUNTLOOP();
+                        VM_TIERUP_LOOP();
+                    }
+
                     // note that we need to increment pc by 1 to exit the loop since we need to skip over aux
                     pc += ttisnil(ra + 3) ? 1 : LUAU_INSN_D(insn);
                     LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
@@ -2601,6 +3017,8 @@ reentry:
             {
                 VM_INTERRUPT();
                 Instruction insn = *pc++;
+                VM_COUNTLOOP();
+                VM_TIERUP_LOOP();
 
                 pc += LUAU_INSN_D(insn);
                 LUAU_ASSERT(unsigned(pc - cl->l.p->code) < unsigned(cl->l.p->sizecode));
@@ -2682,7 +3100,8 @@ reentry:
                 Instruction insn = *pc++;
                 int hits = LUAU_INSN_E(insn);
 
-                // update hits with saturated add and patch the instruction in place
+                // update hits with saturated add and patch the instruction in place; functions with coverage never share instructions with an image
+                LUAU_ASSERT(!cl->l.p->image);
                 hits = (hits < (1 << 23) - 1) ? hits + 1 : hits;
                 VM_PATCH_E(pc - 1, hits);
 
@@ -2701,6 +3120,7 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 TValue* kv = VM_KV(LUAU_INSN_B(insn));
                 StkId rc = VM_REG(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 1, rc);
 
                 // fast-path
                 if (ttisnumber(rc))
@@ -2722,6 +3142,7 @@ reentry:
                 StkId ra = VM_REG(LUAU_INSN_A(insn));
                 TValue* kv = VM_KV(LUAU_INSN_B(insn));
                 StkId rc = VM_REG(LUAU_INSN_C(insn));
+                VM_TYPEFEEDBACK(pc - 1, 1, rc);
 
                 // fast-path
                 if (LUAU_LIKELY(ttisnumber(rc)))
@@ -3016,6 +3437,8 @@ int luau_precall(lua_State* L, StkId func, int nresults)
     if (!ccl->isC)
     {
         Proto* p = ccl->l.p;
+        VM_COUNTCALL(p);
+        VM_TIERUP(p);
 
         // fill unused parameters with nil
         StkId argi = L->top;
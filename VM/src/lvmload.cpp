@@ -11,6 +11,8 @@
 #include "lbytecode.h"
 #include "lapi.h"
 
+#include <atomic>
+
 #include <string.h>
 
 LUAU_FASTFLAG(LuauLoadTypeInfo)
@@ -187,7 +189,228 @@ static void resolveImportSafe(lua_State* L, Table* env, TValue* k, uint32_t id)
     }
 }
 
-int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size, int env)
+struct ImageProto
+{
+    Instruction* code;
+    int sizecode;
+
+    uint8_t* lineinfo;
+    int sizelineinfo;
+    int linegaplog2;
+
+    // coverage counters are updated in place, so functions compiled with coverage get a private copy of the instructions in each state
+    bool coverage;
+};
+
+struct lua_BytecodeImage
+{
+    std::atomic<int> refs;
+
+    char* data;
+    size_t size;
+
+    // empty when the bytecode can't be loaded; luau_loadimage reports the error in that case
+    ImageProto* protos;
+    unsigned int protocount;
+};
+
+static void skipString(const char* data, size_t size, size_t& offset)
+{
+    offset += readVarInt(data, size, offset);
+}
+
+// decodes instructions and line info of every function once; the layout of the decoded arrays has to match what loadbytecode produces
+static void buildImage(lua_BytecodeImage* image)
+{
+    const char* data = image->data;
+    size_t size = image->size;
+    size_t offset = 0;
+
+    uint8_t version = read<uint8_t>(data, size, offset);
+
+    if (version < LBC_VERSION_MIN || version > LBC_VERSION_MAX)
+        return;
+
+    uint8_t typesversion = 0;
+
+    if (version >= 4)
+        typesversion = read<uint8_t>(data, size, offset);
+
+    unsigned int stringCount = readVarInt(data, size, offset);
+
+    for (unsigned int i = 0; i < stringCount; ++i)
+        skipString(data, size, offset);
+
+    unsigned int protoCount = readVarInt(data, size, offset);
+
+    image->protos = new ImageProto[protoCount];
+    image->protocount = protoCount;
+
+    for (unsigned int i = 0; i < protoCount; ++i)
+    {
+        ImageProto& ip = image->protos[i];
+
+        offset += 4; // maxstacksize, numparams, nups, is_vararg
+
+        if (version >= 4)
+        {
+            offset += 1; // flags
+
+            // typeinfo
+            if (!FFlag::LuauLoadTypeInfo || typesversion == 1 || typesversion == 2)
+                skipString(data, size, offset);
+        }
+
+        ip.sizecode = readVarInt(data, size, offset);
+        ip.code = new Instruction[ip.sizecode];
+
+        ip.coverage = false;
+
+        for (int j = 0; j < ip.sizecode; ++j)
+        {
+            ip.code[j] = read<uint32_t>(data, size, offset);
+
+            // aux words can look like coverage instructions, which only costs the sharing of the function
+            if (LUAU_INSN_OP(ip.code[j]) == LOP_COVERAGE)
+                ip.coverage = true;
+        }
+
+        const int sizek = readVarInt(data, size, offset);
+
+        for (int j = 0; j < sizek; ++j)
+        {
+            switch (read<uint8_t>(data, size, offset))
+            {
+            case LBC_CONSTANT_NIL:
+                break;
+
+            case LBC_CONSTANT_BOOLEAN:
+                offset += 1;
+                break;
+
+            case LBC_CONSTANT_NUMBER:
+                offset += sizeof(double);
+                break;
+
+            case LBC_CONSTANT_VECTOR:
+                offset += 4 * sizeof(float);
+                break;
+
+            case LBC_CONSTANT_STRING:
+            case LBC_CONSTANT_CLOSURE:
+                readVarInt(data, size, offset);
+                break;
+
+            case LBC_CONSTANT_IMPORT:
+                offset += sizeof(uint32_t);
+                break;
+
+            case LBC_CONSTANT_TABLE:
+            {
+                int keys = readVarInt(data, size, offset);
+                for (int k = 0; k < keys; ++k)
+                    readVarInt(data, size, offset);
+                break;
+            }
+
+            default:
+                LUAU_ASSERT(!"Unexpected constant kind");
+            }
+        }
+
+        const int sizep = readVarInt(data, size, offset);
+
+        for (int j = 0; j < sizep; ++j)
+            readVarInt(data, size, offset);
+
+        readVarInt(data, size, offset); // linedefined
+        readVarInt(data, size, offset); // debugname
+
+        ip.lineinfo = NULL;
+        ip.sizelineinfo = 0;
+        ip.linegaplog2 = 0;
+
+        if (read<uint8_t>(data, size, offset))
+        {
+            ip.linegaplog2 = read<uint8_t>(data, size, offset);
+
+            int intervals = ((ip.sizecode - 1) >> ip.linegaplog2) + 1;
+            int absoffset = (ip.sizecode + 3) & ~3;
+
+            ip.sizelineinfo = absoffset + intervals * sizeof(int);
+            ip.lineinfo = new uint8_t[ip.sizelineinfo];
+
+            int* abslineinfo = (int*)(ip.lineinfo + absoffset);
+
+            uint8_t lastoffset = 0;
+            for (int j = 0; j < ip.sizecode; ++j)
+            {
+                lastoffset += read<uint8_t>(data, size, offset);
+                ip.lineinfo[j] = lastoffset;
+            }
+
+            int lastline = 0;
+            for (int j = 0; j < intervals; ++j)
+            {
+                lastline += read<int32_t>(data, size, offset);
+                abslineinfo[j] = lastline;
+            }
+        }
+
+        if (read<uint8_t>(data, size, offset))
+        {
+            const int sizelocvars = readVarInt(data, size, offset);
+
+            for (int j = 0; j < sizelocvars; ++j)
+            {
+                readVarInt(data, size, offset); // varname
+                readVarInt(data, size, offset); // startpc
+                readVarInt(data, size, offset); // endpc
+                offset += 1;                    // reg
+            }
+
+            const int sizeupvalues = readVarInt(data, size, offset);
+
+            for (int j = 0; j < sizeupvalues; ++j)
+                readVarInt(data, size, offset);
+        }
+    }
+}
+
+lua_BytecodeImage* luau_newimage(const char* data, size_t size)
+{
+    lua_BytecodeImage* image = new lua_BytecodeImage;
+    image->refs = 1;
+    image->data = new char[size];
+    image->size = size;
+    image->protos = NULL;
+    image->protocount = 0;
+
+    memcpy(image->data, data, size);
+
+    if (size > 0)
+        buildImage(image);
+
+    return image;
+}
+
+void luau_releaseimage(lua_BytecodeImage* image)
+{
+    if (image->refs.fetch_sub(1) != 1)
+        return;
+
+    for (unsigned int i = 0; i < image->protocount; ++i)
+    {
+        delete[] image->protos[i].code;
+        delete[] image->protos[i].lineinfo;
+    }
+
+    delete[] image->protos;
+    delete[] image->data;
+    delete image;
+}
+
+static int loadbytecode(lua_State* L, const char* chunkname, const char* data, size_t size, int env, lua_BytecodeImage* image)
 {
     size_t offset = 0;
 
@@ -334,15 +557,40 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
             }
         }
 
+        // instructions and line info are shared with the image when there is one
+        ImageProto* ip = i < (image ? image->protocount : 0) && !image->protos[i].coverage ? &image->protos[i] : NULL;
+
         const int sizecode = readVarInt(data, size, offset);
-        p->code = luaM_newarray(L, sizecode, Instruction, p->memcat);
-        p->sizecode = sizecode;
 
-        for (int j = 0; j < p->sizecode; ++j)
-            p->code[j] = read<uint32_t>(data, size, offset);
+        if (ip)
+        {
+            LUAU_ASSERT(ip->sizecode == sizecode);
+
+            p->image = image;
+            image->refs.fetch_add(1);
+
+            p->code = ip->code;
+            p->sizecode = sizecode;
+
+            offset += sizecode * sizeof(uint32_t);
+        }
+        else
+        {
+            p->code = luaM_newarray(L, sizecode, Instruction, p->memcat);
+            p->sizecode = sizecode;
+
+            for (int j = 0; j < p->sizecode; ++j)
+                p->code[j] = read<uint32_t>(data, size, offset);
+        }
 
         p->codeentry = p->code;
 
+        if (LUAI_TYPEFEEDBACK && L->global->typefeedback)
+        {
+            p->typefeedback = luaM_newarray(L, sizecode * 2, uint8_t, p->memcat);
+            memset(p->typefeedback, 0, sizecode * 2);
+        }
+
         const int sizek = readVarInt(data, size, offset);
         p->k = luaM_newarray(L, sizek, TValue, p->memcat);
         p->sizek = sizek;
@@ -447,7 +695,22 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
 
         uint8_t lineinfo = read<uint8_t>(data, size, offset);
 
-        if (lineinfo)
+        if (lineinfo && ip)
+        {
+            p->linegaplog2 = read<uint8_t>(data, size, offset);
+            LUAU_ASSERT(ip->linegaplog2 == p->linegaplog2);
+
+            int intervals = ((p->sizecode - 1) >> p->linegaplog2) + 1;
+            int absoffset = (p->sizecode + 3) & ~3;
+
+            p->lineinfo = ip->lineinfo;
+            p->sizelineinfo = ip->sizelineinfo;
+
+            p->abslineinfo = (int*)(p->lineinfo + absoffset);
+
+            offset += p->sizecode + intervals * sizeof(int32_t);
+        }
+        else if (lineinfo)
         {
             p->linegaplog2 = read<uint8_t>(data, size, offset);
 
@@ -518,3 +781,13 @@ int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size
 
     return 0;
 }
+
+int luau_load(lua_State* L, const char* chunkname, const char* data, size_t size, int env)
+{
+    return loadbytecode(L, chunkname, data, size, env, NULL);
+}
+
+int luau_loadimage(lua_State* L, const char* chunkname, lua_BytecodeImage* image, int env)
+{
+    return loadbytecode(L, chunkname, image->data, image->size, env, image);
+}
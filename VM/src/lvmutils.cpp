@@ -145,7 +145,10 @@ void luaV_settable(lua_State* L, const TValue* t, TValue* key, StkId val)
             if (!ttisnil(oldval) || (tm = fasttm(L, h->metatable, TM_NEWINDEX)) == NULL)
             {
                 if (h->readonly)
-                    luaG_readonlyerror(L);
+                {
+                    luaH_makewritable(L, h);
+                    oldval = luaH_get(h, key); // storage may have moved
+                }
 
                 // luaH_set would work but would repeat the lookup so we use luaH_setslot that can reuse oldval if it's safe
                 TValue* newval = luaH_setslot(L, h, oldval, key);
@@ -0,0 +1,60 @@
+local function prequire(name) local success, result = pcall(require, name); return if success then result else nil end
+local bench = script and require(script.Parent.bench_support) or prequire("bench_support") or require("../bench_support")
+
+-- long-lived heap: configuration-like tables with cached closures, ~390 bytes per entry for a heap over 1 GB
+local oldcount = 3000000
+
+-- short-lived tables allocated per run; scaled with the old heap so that collection cycles start during the runs
+local churncount = oldcount
+
+local function buildOldHeap()
+    local heap = table.create(oldcount)
+
+    for i = 1, oldcount do
+        local entry = { id = i, name = "entry" .. i, tags = { i, i * 2, i * 3 } }
+        entry.get = function() return entry.id end
+        heap[i] = entry
+    end
+
+    return heap
+end
+
+local function churn()
+    local ts0 = os.clock()
+
+    -- flood of short-lived tables, only a few survive
+    local keep = nil
+
+    for i = 1, churncount do
+        local t = { i, i + 1, i + 2, key = i }
+
+        if i % 1000 == 0 then
+            keep = t
+        end
+    end
+
+    local ts1 = os.clock()
+
+    return ts1 - ts0, keep
+end
+
+local function run(mode, description)
+    if collectgarbage then
+        pcall(collectgarbage, mode)
+
+        -- release the heap of the previous run before building a new one
+        pcall(collectgarbage, "collect")
+    end
+
+    local heap = buildOldHeap()
+
+    bench.runCode(function()
+        return (churn())
+    end, description)
+
+    -- keep the old heap alive for the duration of the benchmark
+    return heap[1].get()
+end
+
+run("incremental", "GC: long-lived heap with short-lived churn (incremental)")
+run("generational", "GC: long-lived heap with short-lived churn (generational)")
@@ -0,0 +1,43 @@
+local function prequire(name) local success, result = pcall(require, name); return if success then result else nil end
+local bench = script and require(script.Parent.bench_support) or prequire("bench_support") or require("../bench_support")
+
+local function recurse(n)
+    if n == 0 then
+        return coroutine.yield(0)
+    end
+
+    return 1 + recurse(n - 1)
+end
+
+bench.runCode(function()
+    for i=1,10000 do
+        local co = coroutine.create(recurse)
+        coroutine.resume(co, 200)
+        coroutine.resume(co)
+    end
+end, "coroutine: deep, short-lived")
+
+bench.runCode(function()
+    local cos = table.create(10000)
+    for i=1,10000 do
+        cos[i] = coroutine.create(function()
+            while true do
+                recurse(100)
+            end
+        end)
+    end
+
+    for j=1,10 do
+        for i=1,#cos do
+            coroutine.resume(cos[i])
+        end
+    end
+end, "coroutine: deep, long-lived")
+
+bench.runCode(function()
+    for i=1,100000 do
+        local co = coroutine.wrap(function(a) return coroutine.yield(a) end)
+        co(i)
+        co()
+    end
+end, "coroutine: shallow")
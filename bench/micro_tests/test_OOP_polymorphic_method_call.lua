@@ -0,0 +1,48 @@
+local function prequire(name) local success, result = pcall(require, name); return if success then result else nil end
+local bench = script and require(script.Parent.bench_support) or prequire("bench_support") or require("../bench_support")
+
+function test()
+
+    local function class(...)
+        local Class = {}
+        Class.__index = Class
+
+        -- extra methods give each class a different slot for Get
+        for _, name in {...} do
+            Class[name] = function() end
+        end
+
+        function Class.new(v)
+            local self = {
+                value = v
+            }
+            setmetatable(self, Class)
+            return self
+        end
+
+        function Class:Get()
+            return self.value
+        end
+
+        return Class
+    end
+
+    local shapes = {
+        class().new(1),
+        class("Area").new(2),
+        class("Area", "Perimeter", "Scale").new(3),
+        class("Area", "Perimeter", "Scale", "Rotate", "Translate", "Draw").new(4),
+    }
+
+    local ts0 = os.clock()
+    for i=1,250000 do
+        for j=1,4 do
+            local nv = shapes[j]:Get()
+        end
+    end
+    local ts1 = os.clock()
+
+    return ts1-ts0
+end
+
+bench.runCode(test, "OOP: polymorphic method call")
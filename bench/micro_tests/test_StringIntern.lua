@@ -0,0 +1,40 @@
+local function prequire(name) local success, result = pcall(require, name); return if success then result else nil end
+local bench = script and require(script.Parent.bench_support) or prequire("bench_support") or require("../bench_support")
+
+local prefix = string.rep("abcdefghijklmnopqrstuvwxyz", 3)
+
+bench.runCode(function()
+    local keys = table.create(1e6)
+    for i=1,1e6 do
+        keys[i] = "key" .. i
+    end
+end, "intern: short unique")
+
+bench.runCode(function()
+    local keys = table.create(1e6)
+    for i=1,1e6 do
+        keys[i] = prefix .. i
+    end
+end, "intern: long unique")
+
+bench.runCode(function()
+    local keys = table.create(1000)
+    for i=1,1000 do
+        keys[i] = "key" .. i
+    end
+
+    for j=1,1000 do
+        for i=1,1000 do
+            local _ = "key" .. i
+        end
+    end
+end, "intern: short existing")
+
+bench.runCode(function()
+    local source = string.rep("key,value;", 1e5)
+    for j=1,10 do
+        for i=1,#source-7,10 do
+            local _ = string.sub(source, i, i + 7)
+        end
+    end
+end, "intern: string.sub")
@@ -439,6 +439,9 @@ TEST_CASE_FIXTURE(AssemblyBuilderA64Fixture, "FPInsertExtract")
     SINGLE_COMPARE(ins_4s(q31, 0, q29, 0), 0x6E0407BF);
     SINGLE_COMPARE(dup_4s(s29, q31, 2), 0x5E1407FD);
     SINGLE_COMPARE(dup_4s(q29, q30, 0), 0x4E0407DD);
+    SINGLE_COMPARE(ins_2d(q0, 1, q1, 0), 0x6E180420);
+    SINGLE_COMPARE(dup_2d(d0, q1, 1), 0x5E180420);
+    SINGLE_COMPARE(dup_2d(q0, q1, 1), 0x4E180420);
 }
 
 TEST_CASE_FIXTURE(AssemblyBuilderA64Fixture, "FPCompare")
@@ -516,6 +519,21 @@ TEST_CASE_FIXTURE(AssemblyBuilderA64Fixture, "SIMDMath")
     SINGLE_COMPARE(fmul(q0, q1, q2), 0x6E22DC20);
     SINGLE_COMPARE(fdiv(q0, q1, q2), 0x6E22FC20);
     SINGLE_COMPARE(fneg(q0, q1), 0x6EA0F820);
+
+    SINGLE_COMPARE(fadd_2d(q0, q1, q2), 0x4E62D420);
+    SINGLE_COMPARE(fsub_2d(q0, q1, q2), 0x4EE2D420);
+    SINGLE_COMPARE(fmul_2d(q0, q1, q2), 0x6E62DC20);
+    SINGLE_COMPARE(fdiv_2d(q0, q1, q2), 0x6E62FC20);
+    SINGLE_COMPARE(fneg_2d(q0, q1), 0x6EE0F820);
+    SINGLE_COMPARE(fabs_2d(q0, q1), 0x4EE0F820);
+    SINGLE_COMPARE(fsqrt_2d(q0, q1), 0x6EE1F820);
+    SINGLE_COMPARE(fcmgt_2d(q0, q1, q2), 0x6EE2E420);
+    SINGLE_COMPARE(bsl_16b(q0, q1, q2), 0x6E621C20);
+
+    SINGLE_COMPARE(fcvtl_2d(q0, q1), 0x0E617820);
+    SINGLE_COMPARE(fcvtn_2s(q0, q1), 0x0E616820);
+    SINGLE_COMPARE(sxtl_2d(q0, q1), 0x0F20A420);
+    SINGLE_COMPARE(scvtf_2d(q0, q1), 0x4E61D820);
 }
 
 TEST_CASE("LogTest")
@@ -474,6 +474,10 @@ TEST_CASE_FIXTURE(AssemblyBuilderX64Fixture, "AVXBinaryInstructionForms")
     SINGLE_COMPARE(vmulps(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x28, 0x59, 0xc6);
     SINGLE_COMPARE(vdivps(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x28, 0x5e, 0xc6);
 
+    SINGLE_COMPARE(vsubpd(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x29, 0x5c, 0xc6);
+    SINGLE_COMPARE(vmulpd(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x29, 0x59, 0xc6);
+    SINGLE_COMPARE(vdivpd(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x29, 0x5e, 0xc6);
+
     SINGLE_COMPARE(vorpd(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x29, 0x56, 0xc6);
     SINGLE_COMPARE(vxorpd(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x29, 0x57, 0xc6);
     SINGLE_COMPARE(vorps(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x28, 0x56, 0xc6);
@@ -483,6 +487,11 @@ TEST_CASE_FIXTURE(AssemblyBuilderX64Fixture, "AVXBinaryInstructionForms")
 
     SINGLE_COMPARE(vmaxsd(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x2b, 0x5f, 0xc6);
     SINGLE_COMPARE(vminsd(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x2b, 0x5d, 0xc6);
+    SINGLE_COMPARE(vmaxpd(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x29, 0x5f, 0xc6);
+    SINGLE_COMPARE(vminpd(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x29, 0x5d, 0xc6);
+
+    SINGLE_COMPARE(vunpcklpd(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x29, 0x14, 0xc6);
+    SINGLE_COMPARE(vunpckhpd(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x29, 0x15, 0xc6);
 
     SINGLE_COMPARE(vcmpltsd(xmm8, xmm10, xmm14), 0xc4, 0x41, 0x2b, 0xc2, 0xc6, 0x01);
 }
@@ -528,6 +537,10 @@ TEST_CASE_FIXTURE(AssemblyBuilderX64Fixture, "AVXMoveInstructionForms")
     SINGLE_COMPARE(vmovq(rbx, xmm1), 0xc4, 0xe1, 0xf9, 0x7e, 0xcb);
     SINGLE_COMPARE(vmovq(xmm1, qword[r9]), 0xc4, 0xc1, 0xf9, 0x6e, 0x09);
     SINGLE_COMPARE(vmovq(qword[r9], xmm1), 0xc4, 0xc1, 0xf9, 0x7e, 0x09);
+    SINGLE_COMPARE(vmovhpd(qword[r9], xmm10), 0xc4, 0x41, 0x79, 0x17, 0x11);
+    SINGLE_COMPARE(vmovhpd(xmm8, xmm10, qword[r9]), 0xc4, 0x41, 0x29, 0x16, 0x01);
+    SINGLE_COMPARE(vmovddup(xmm8, xmm10), 0xc4, 0x41, 0x7b, 0x12, 0xc2);
+    SINGLE_COMPARE(vmovddup(xmm8, qword[r9]), 0xc4, 0x41, 0x7b, 0x12, 0x01);
 }
 
 TEST_CASE_FIXTURE(AssemblyBuilderX64Fixture, "AVXConversionInstructionForms")
@@ -544,6 +557,9 @@ TEST_CASE_FIXTURE(AssemblyBuilderX64Fixture, "AVXConversionInstructionForms")
     SINGLE_COMPARE(vcvtsd2ss(xmm6, xmm11, qword[rcx + rdx]), 0xc4, 0xe1, 0xa3, 0x5a, 0x34, 0x11);
     SINGLE_COMPARE(vcvtss2sd(xmm3, xmm8, xmm12), 0xc4, 0xc1, 0x3a, 0x5a, 0xdc);
     SINGLE_COMPARE(vcvtss2sd(xmm4, xmm9, dword[rcx + rsi]), 0xc4, 0xe1, 0x32, 0x5a, 0x24, 0x31);
+    SINGLE_COMPARE(vcvtps2pd(xmm8, xmm10), 0xc4, 0x41, 0x78, 0x5a, 0xc2);
+    SINGLE_COMPARE(vcvtpd2ps(xmm8, xmm10), 0xc4, 0x41, 0x79, 0x5a, 0xc2);
+    SINGLE_COMPARE(vcvtdq2pd(xmm8, xmm10), 0xc4, 0x41, 0x7a, 0xe6, 0xc2);
 }
 
 TEST_CASE_FIXTURE(AssemblyBuilderX64Fixture, "AVXTernaryInstructionForms")
@@ -556,6 +572,8 @@ TEST_CASE_FIXTURE(AssemblyBuilderX64Fixture, "AVXTernaryInstructionForms")
 
     SINGLE_COMPARE(vpshufps(xmm7, xmm12, xmmword[rcx + r10], 0b11010100), 0xc4, 0xa1, 0x18, 0xc6, 0x3c, 0x11, 0xd4);
     SINGLE_COMPARE(vpinsrd(xmm7, xmm12, xmmword[rcx + r10], 2), 0xc4, 0xa3, 0x19, 0x22, 0x3c, 0x11, 0x02);
+    SINGLE_COMPARE(vinsertps(xmm7, xmm12, dword[rcx + r10], 0x10), 0xc4, 0xa3, 0x19, 0x21, 0x3c, 0x11, 0x10);
+    SINGLE_COMPARE(vextractps(dword[rcx + r10], xmm7, 1), 0xc4, 0xa3, 0x79, 0x17, 0x3c, 0x11, 0x01);
 }
 
 TEST_CASE_FIXTURE(AssemblyBuilderX64Fixture, "MiscInstructions")
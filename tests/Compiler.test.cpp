@@ -24,6 +24,7 @@ LUAU_FASTINT(LuauRecursionLimit)
 
 LUAU_FASTFLAG(LuauCompileNoJumpLineRetarget)
 LUAU_FASTFLAG(LuauCompileRepeatUntilSkippedLocals)
+LUAU_FASTFLAG(LuauCompileSuperinstructions)
 
 using namespace Luau;
 
@@ -7989,4 +7990,44 @@ RETURN R1 7
 )");
 }
 
+TEST_CASE("Superinstructions")
+{
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, true};
+
+    const char* source = R"(
+local a, i, j, t = ...
+return a[i][j], t.x.y, a[i] + j, a[i][j][i]
+)";
+
+    // superinstructions are only used at O2
+    CHECK_EQ("\n" + compileFunction(source, 0, 1), R"(
+GETVARARGS R0 4
+GETTABLE R5 R0 R1
+GETTABLE R4 R5 R2
+GETTABLEKS R6 R3 K0 ['x']
+GETTABLEKS R5 R6 K1 ['y']
+GETTABLE R7 R0 R1
+ADD R6 R7 R2
+GETTABLE R9 R0 R1
+GETTABLE R8 R9 R2
+GETTABLE R7 R8 R1
+RETURN R4 4
+)");
+
+    // the second instruction of a pair keeps its opcode and can't start another pair
+    CHECK_EQ("\n" + compileFunction(source, 0, 2), R"(
+GETVARARGS R0 4
+GETTABLE_GETTABLE R5 R0 R1
+GETTABLE R4 R5 R2
+GETTABLEKS_GETTABLEKS R6 R3 K0 ['x']
+GETTABLEKS R5 R6 K1 ['y']
+GETTABLE_ADD R7 R0 R1
+ADD R6 R7 R2
+GETTABLE_GETTABLE R9 R0 R1
+GETTABLE R8 R9 R2
+GETTABLE R7 R8 R1
+RETURN R4 4
+)");
+}
+
 TEST_SUITE_END();
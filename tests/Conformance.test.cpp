@@ -30,10 +30,14 @@ extern int optimizationLevel;
 // internal functions, declared in lgc.h - not exposed via lua.h
 void luaC_fullgc(lua_State* L);
 void luaC_validate(lua_State* L);
+int luaC_steplimit(lua_State* L);
+void luaC_recordsteprate(lua_State* L, int state, size_t work, double duration);
 
 LUAU_FASTFLAG(DebugLuauAbortingChecks)
+LUAU_FASTFLAG(LuauCodegenLoopVectorization)
 LUAU_FASTINT(CodegenHeuristicsInstructionLimit)
 LUAU_FASTFLAG(LuauCompileRepeatUntilSkippedLocals)
+LUAU_FASTFLAG(LuauCompileSuperinstructions)
 LUAU_DYNAMIC_FASTFLAG(LuauFastCrossTableMove)
 
 static lua_CompileOptions defaultOptions()
@@ -58,9 +62,10 @@ static Luau::CodeGen::CompilationOptions defaultCodegenOptions()
 
 static int lua_collectgarbage(lua_State* L)
 {
-    static const char* const opts[] = {"stop", "restart", "collect", "count", "isrunning", "step", "setgoal", "setstepmul", "setstepsize", nullptr};
-    static const int optsnum[] = {
-        LUA_GCSTOP, LUA_GCRESTART, LUA_GCCOLLECT, LUA_GCCOUNT, LUA_GCISRUNNING, LUA_GCSTEP, LUA_GCSETGOAL, LUA_GCSETSTEPMUL, LUA_GCSETSTEPSIZE};
+    static const char* const opts[] = {
+        "stop", "restart", "collect", "count", "isrunning", "step", "setgoal", "setstepmul", "setstepsize", "generational", "incremental", nullptr};
+    static const int optsnum[] = {LUA_GCSTOP, LUA_GCRESTART, LUA_GCCOLLECT, LUA_GCCOUNT, LUA_GCISRUNNING, LUA_GCSTEP, LUA_GCSETGOAL,
+        LUA_GCSETSTEPMUL, LUA_GCSETSTEPSIZE, LUA_GCGEN, LUA_GCINC};
 
     int o = luaL_checkoption(L, 1, "collect", opts);
     int ex = luaL_optinteger(L, 2, 0);
@@ -488,6 +493,11 @@ TEST_CASE("Events")
     runConformance("events.lua");
 }
 
+TEST_CASE("InlineCache")
+{
+    runConformance("inlinecache.lua");
+}
+
 TEST_CASE("Constructs")
 {
     runConformance("constructs.lua");
@@ -513,6 +523,576 @@ TEST_CASE("GC")
     runConformance("gc.lua");
 }
 
+TEST_CASE("GCGenerational")
+{
+    auto setup = [](lua_State* L) {
+        lua_gc(L, LUA_GCGEN, 0);
+
+        // run minor collections as often as possible and validate the heap between steps to stress the remembered set
+        lua_gc(L, LUA_GCSETGENMINORMUL, 1);
+
+        lua_callbacks(L)->interrupt = [](lua_State* L, int gc) {
+            if (gc == 0)
+                luaC_validate(L);
+        };
+    };
+
+    runConformance("gc.lua", setup);
+    runConformance("closure.lua", setup);
+    runConformance("coroutine.lua", setup);
+    runConformance("calls.lua", setup);
+}
+
+TEST_CASE("GCParallelMark")
+{
+    auto setup = [](lua_State* L) {
+        CHECK(lua_gc(L, LUA_GCSETMARKWORKERS, 4) == 0);
+
+        lua_callbacks(L)->interrupt = [](lua_State* L, int gc) {
+            if (gc == 0)
+                luaC_validate(L);
+        };
+    };
+
+    runConformance("gc.lua", setup);
+    runConformance("closure.lua", setup);
+    runConformance("coroutine.lua", setup);
+    runConformance("calls.lua", setup);
+
+    runConformance("gc.lua", [](lua_State* L) {
+        lua_gc(L, LUA_GCSETMARKWORKERS, 4);
+        lua_gc(L, LUA_GCGEN, 0);
+        lua_gc(L, LUA_GCSETGENMINORMUL, 1);
+
+        lua_callbacks(L)->interrupt = [](lua_State* L, int gc) {
+            if (gc == 0)
+                luaC_validate(L);
+        };
+    });
+}
+
+TEST_CASE("GCParallelMarkWorkers")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    CHECK(lua_gc(L, LUA_GCSETMARKWORKERS, 2) == 0);
+    CHECK(lua_gc(L, LUA_GCSETMARKWORKERS, 1000) == 2);
+    CHECK(lua_gc(L, LUA_GCSETMARKWORKERS, 3) == LUAI_GCMAXMARKWORKERS);
+
+    // a deep graph of tables, weak tables and threads
+    lua_createtable(L, 2000, 0);
+    for (int i = 1; i <= 2000; ++i)
+    {
+        lua_createtable(L, 0, 2);
+        lua_pushinteger(L, i);
+        lua_setfield(L, -2, "value");
+
+        if (i % 100 == 0)
+        {
+            // the table is only reachable from the thread stack
+            lua_State* co = lua_newthread(L);
+            lua_createtable(co, 0, 0);
+            lua_setfield(L, -2, "thread");
+        }
+
+        if (i % 10 == 0)
+        {
+            lua_createtable(L, 0, 0);
+            lua_createtable(L, 0, 1);
+            lua_pushstring(L, "k");
+            lua_setfield(L, -2, "__mode");
+            lua_setmetatable(L, -2);
+            lua_setfield(L, -2, "weak");
+        }
+
+        lua_rawseti(L, -2, i);
+    }
+    lua_setglobal(L, "graph");
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    int size = lua_gc(L, LUA_GCCOUNT, 0);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+    CHECK(lua_gc(L, LUA_GCCOUNT, 0) == size);
+
+    lua_pushnil(L);
+    lua_setglobal(L, "graph");
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+    CHECK(lua_gc(L, LUA_GCCOUNT, 0) < size);
+
+    // many weak tables sharing a metatable that is traversed while their mode is resolved
+    lua_createtable(L, 0, 1);
+    lua_pushstring(L, "v");
+    lua_setfield(L, -2, "__mode");
+    lua_createtable(L, 1000, 0);
+    for (int i = 1; i <= 1000; ++i)
+    {
+        lua_createtable(L, 1, 0);
+        lua_createtable(L, 0, 0);
+        lua_rawseti(L, -2, 1);
+        lua_pushvalue(L, -3);
+        lua_setmetatable(L, -2);
+        lua_rawseti(L, -2, i);
+    }
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    int cleared = 0;
+    for (int i = 1; i <= 1000; ++i)
+    {
+        lua_rawgeti(L, -1, i);
+        lua_rawgeti(L, -1, 1);
+        cleared += lua_isnil(L, -1);
+        lua_pop(L, 2);
+    }
+    CHECK(cleared == 1000);
+    lua_pop(L, 2);
+
+    // copy-on-write clones share node storage, so dead keys must not be written while workers traverse them
+    lua_createtable(L, 0, 200);
+    for (int i = 1; i <= 200; ++i)
+    {
+        lua_pushfstring(L, "key%d", i);
+        lua_createtable(L, 0, 0);
+        lua_rawset(L, -3);
+    }
+
+    for (int i = 1; i <= 200; i += 2)
+    {
+        lua_pushfstring(L, "key%d", i);
+        lua_pushnil(L);
+        lua_rawset(L, -3);
+    }
+
+    lua_createtable(L, 100, 0);
+    for (int i = 1; i <= 100; ++i)
+    {
+        lua_clonetable(L, -2);
+        lua_rawseti(L, -2, i);
+    }
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    for (int i = 1; i <= 100; ++i)
+    {
+        lua_rawgeti(L, -1, i);
+
+        int count = 0;
+        lua_pushnil(L);
+        while (lua_next(L, -2))
+        {
+            count++;
+            lua_pop(L, 1);
+        }
+        CHECK(count == 100);
+
+        lua_pushnumber(L, i);
+        lua_rawsetfield(L, -2, "extra");
+        lua_pop(L, 1);
+    }
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+    lua_pop(L, 2);
+
+    CHECK(lua_gc(L, LUA_GCSETMARKWORKERS, 0) == 3);
+}
+
+TEST_CASE("GCSweepThread")
+{
+    auto setup = [](lua_State* L) {
+        CHECK(lua_gc(L, LUA_GCSETSWEEPTHREAD, 1) == 0);
+
+        lua_callbacks(L)->interrupt = [](lua_State* L, int gc) {
+            if (gc == 0)
+                luaC_validate(L);
+        };
+    };
+
+    runConformance("gc.lua", setup);
+    runConformance("closure.lua", setup);
+    runConformance("coroutine.lua", setup);
+    runConformance("calls.lua", setup);
+
+    runConformance("gc.lua", [](lua_State* L) {
+        lua_gc(L, LUA_GCSETSWEEPTHREAD, 1);
+        lua_gc(L, LUA_GCGEN, 0);
+        lua_gc(L, LUA_GCSETGENMINORMUL, 1);
+
+        lua_callbacks(L)->interrupt = [](lua_State* L, int gc) {
+            if (gc == 0)
+                luaC_validate(L);
+        };
+    });
+}
+
+TEST_CASE("GCSweepThreadRelease")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    CHECK(lua_gc(L, LUA_GCSETSWEEPTHREAD, 1) == 0);
+    CHECK(lua_gc(L, LUA_GCSETSWEEPTHREAD, 1) == 1);
+
+    static int destructorCalls = 0;
+    destructorCalls = 0;
+
+    lua_setuserdatadtor(L, 42, [](lua_State* L, void* data) {
+        destructorCalls++;
+    });
+
+    int basesize = lua_gc(L, LUA_GCCOUNT, 0);
+
+    // fill entire pages with objects of the same size that die together, along with large arrays
+    for (int iter = 0; iter < 10; ++iter)
+    {
+        lua_createtable(L, 1000, 0);
+        for (int i = 1; i <= 1000; ++i)
+        {
+            lua_createtable(L, 100, 0);
+            lua_pushinteger(L, i);
+            lua_rawseti(L, -2, 100);
+
+            lua_newuserdatatagged(L, 16, 42);
+            lua_rawseti(L, -2, 1);
+
+            lua_rawseti(L, -2, i);
+        }
+        lua_pop(L, 1);
+
+        lua_gc(L, LUA_GCCOLLECT, 0);
+        luaC_validate(L);
+    }
+
+    CHECK(destructorCalls == 10000);
+    CHECK(lua_gc(L, LUA_GCCOUNT, 0) <= basesize);
+
+    CHECK(lua_gc(L, LUA_GCSETSWEEPTHREAD, 0) == 1);
+}
+
+TEST_CASE("GCMemcatLimits")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    // every allocation made by the thread (including the compiled code) is attributed to category 1
+    lua_State* T = lua_newthread(L);
+    lua_setmemcat(T, 1);
+
+    lua_setmemcatlimit(L, 1, 0, 256 * 1024);
+
+    lua_pushstring(T, "local t = {} for i = 1, 100000 do t[i] = { i } end return #t");
+    lua_loadstring(T);
+    CHECK(lua_pcall(T, 0, 1, 0) == LUA_ERRMEM);
+    CHECK(strcmp(lua_tostring(T, -1), "not enough memory") == 0);
+    lua_settop(T, 0);
+
+    CHECK(lua_totalbytes(L, 1) <= 256 * 1024);
+
+    // other categories are not affected
+    lua_createtable(L, 100000, 0);
+    lua_pop(L, 1);
+
+    // once the garbage is collected, the category can allocate again
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    lua_pushstring(T, "local t = {} for i = 1, 1000 do t[i] = { i } end return #t");
+    lua_loadstring(T);
+    CHECK(lua_pcall(T, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tointeger(T, -1) == 1000);
+    lua_settop(T, 0);
+
+    // soft limit makes the collector keep up with the garbage produced by the category even if it's paced to run rarely
+    lua_setmemcatlimit(L, 1, 128 * 1024, 0);
+    lua_gc(L, LUA_GCSETGOAL, 10000);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    lua_pushstring(T, "local peak = 0 for i = 1, 100000 do local t = { i } peak = math.max(peak, gcinfo()) end return peak");
+    lua_loadstring(T);
+    CHECK(lua_pcall(T, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tointeger(T, -1) * 1024 < lua_gc(L, LUA_GCCOUNT, 0) * 1024 + 1024 * 1024);
+
+    CHECK(lua_totalbytes(L, 1) < 1024 * 1024);
+    lua_settop(T, 0);
+
+    // collector allocations are not limited, so a weak table of the category can be shrunk when the category is at its hard limit
+    lua_setmemcatlimit(L, 1, 0, 0);
+
+    lua_pushstring(T, R"(
+weak = setmetatable({}, { __mode = "ks" })
+live = {}
+for i = 1, 1000 do
+    local k = {}
+    weak[k] = i
+    if i % 10 == 0 then live[i] = k end
+end
+)");
+    lua_loadstring(T);
+    REQUIRE(lua_pcall(T, 0, 0, 0) == LUA_OK);
+    lua_settop(T, 0);
+
+    lua_setmemcatlimit(L, 1, 0, lua_totalbytes(L, 1) + 64);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    lua_setmemcatlimit(L, 1, 0, 0);
+    lua_pushstring(T, "local n = 0 for k in weak do n += 1 end return n");
+    lua_loadstring(T);
+    REQUIRE(lua_pcall(T, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tointeger(T, -1) == 100);
+    lua_settop(T, 0);
+
+    // allocation rate is the growth of the category since the end of the last cycle, which is finished by explicit steps
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    double start = lua_clock();
+
+    while (lua_gc(L, LUA_GCSTEP, 0) == 0)
+    {
+    }
+
+    lua_gc(L, LUA_GCSTOP, 0);
+
+    size_t base = lua_totalbytes(L, 1);
+    lua_newbuffer(T, 1024 * 1024);
+    size_t growth = lua_totalbytes(L, 1) - base;
+
+    while (lua_clock() - start < 0.01)
+    {
+    }
+
+    int rate = lua_gc(L, LUA_GCMEMCATRATE, 1);
+    double duration = lua_clock() - start;
+
+    // the interval starts after 'start' and is at least 1ms long
+    CHECK(rate >= int(growth / duration / 1024) - 1);
+    CHECK(rate <= int(growth / 0.001 / 1024));
+    CHECK(lua_gc(L, LUA_GCMEMCATRATE, 2) == 0);
+
+    lua_gc(L, LUA_GCRESTART, 0);
+    lua_settop(T, 0);
+}
+
+TEST_CASE("StackPool")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    const char* source = "local function f(n) if n == 0 then return 0 end return 1 + f(n - 1) end return f(5000)";
+
+    auto run = [&](lua_State* T)
+    {
+        lua_pushstring(T, source);
+        lua_loadstring(T);
+        REQUIRE(lua_pcall(T, 0, 1, 0) == LUA_OK);
+        CHECK(lua_tointeger(T, -1) == 5000);
+        lua_settop(T, 0);
+    };
+
+    // deep recursion grows the stack, which is attributed to the category of the thread
+    lua_setmemcat(L, 1);
+    lua_State* T1 = lua_newthread(L);
+    lua_setmemcat(L, 0);
+    run(T1);
+
+    size_t grown = lua_totalbytes(L, 1);
+    size_t pooled = lua_totalbytes(L, 0);
+
+    // resetting the thread moves the large stack buffer to the pool
+    lua_resetthread(T1);
+    CHECK(lua_totalbytes(L, 1) + 64 * 1024 < grown);
+    CHECK(lua_totalbytes(L, 0) > pooled + 64 * 1024);
+    pooled = lua_totalbytes(L, 0);
+
+    // another thread takes the buffer from the pool once it needs a stack of the same size
+    lua_setmemcat(L, 2);
+    lua_State* T2 = lua_newthread(L);
+    lua_setmemcat(L, 0);
+    run(T2);
+    CHECK(lua_totalbytes(L, 0) + 64 * 1024 < pooled);
+    CHECK(lua_totalbytes(L, 2) > 64 * 1024);
+
+    // idle threads are shrunk by the collector, and a full collection releases the pool
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    CHECK(lua_totalbytes(L, 2) < 64 * 1024);
+    CHECK(lua_totalbytes(L, 0) < pooled);
+
+    // the threads can still run after their stacks moved
+    run(T1);
+    run(T2);
+
+    lua_pop(L, 2);
+}
+
+TEST_CASE("ThreadPool")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    CHECK(lua_gc(L, LUA_GCSETTHREADPOOL, 4) == LUAI_THREADPOOLSIZE);
+    CHECK(lua_gc(L, LUA_GCTHREADPOOLCOUNT, 0) == 0);
+
+    // collected threads leave their arrays in the pool, up to the limit
+    for (int i = 0; i < 10; i++)
+    {
+        lua_State* T = lua_newthread(L);
+        lua_pushstring(T, "local function f(n) return if n == 0 then 0 else 1 + f(n - 1) end return f(20)");
+        lua_loadstring(T);
+        REQUIRE(lua_pcall(T, 0, 1, 0) == LUA_OK);
+        lua_pop(L, 1);
+    }
+
+    // run the collector incrementally, since a full collection empties the pool
+    for (int cycles = 0; cycles < 2;)
+        cycles += lua_gc(L, LUA_GCSTEP, 0);
+
+    CHECK(lua_gc(L, LUA_GCTHREADPOOLCOUNT, 0) == 4);
+
+    // new threads take the arrays, including the space grown by the recursion
+    lua_State* T = lua_newthread(L);
+    CHECK(lua_gc(L, LUA_GCTHREADPOOLCOUNT, 0) == 3);
+    CHECK(lua_checkstack(T, 60));
+
+    lua_pushstring(T, "return coroutine.wrap(function(a) return coroutine.yield(a) + 1 end)(41)");
+    lua_loadstring(T);
+    REQUIRE(lua_pcall(T, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tointeger(T, -1) == 41);
+    lua_pop(L, 1);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    CHECK(lua_gc(L, LUA_GCTHREADPOOLCOUNT, 0) == 0);
+
+    CHECK(lua_gc(L, LUA_GCSETTHREADPOOL, 0) == 4);
+}
+
+TEST_CASE("GCStepTime")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    int regular = luaC_steplimit(L);
+
+    CHECK(lua_gc(L, LUA_GCSETSTEPTIME, 100) == 0);
+    CHECK(lua_gc(L, LUA_GCSETSTEPTIME, 100) == 100);
+
+    // until the mark rate is measured, steps use the regular size
+    CHECK(luaC_steplimit(L) == regular);
+
+    // 2.5M units in 250ms is 1e7 units/s, 100us budget allows 1000 units
+    luaC_recordsteprate(L, 1 /* GCSpropagate */, 2500000, 0.25);
+    CHECK(luaC_steplimit(L) == 1000);
+
+    // faster sample moves the average by a quarter: 1e7 * 0.75 + 2e7 * 0.25
+    luaC_recordsteprate(L, 1 /* GCSpropagate */, 2500000, 0.125);
+    CHECK(luaC_steplimit(L) == 1250);
+
+    // atomic and sweep samples don't affect the mark rate
+    luaC_recordsteprate(L, 3 /* GCSatomic */, 10000, 1.0);
+    luaC_recordsteprate(L, 4 /* GCSsweep */, 10000, 1.0);
+    CHECK(luaC_steplimit(L) == 1250);
+
+    // tiny budgets still make progress
+    lua_gc(L, LUA_GCSETSTEPTIME, 1);
+    CHECK(luaC_steplimit(L) == 256);
+
+    lua_gc(L, LUA_GCSETSTEPTIME, 0);
+    CHECK(luaC_steplimit(L) == regular);
+}
+
+TEST_CASE("GCGenerationalAging")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    CHECK(lua_gc(L, LUA_GCGEN, 0) == 0);
+    lua_gc(L, LUA_GCSETGENMINORMUL, 5);
+
+    // build an old generation
+    lua_createtable(L, 1000, 0);
+    for (int i = 1; i <= 1000; ++i)
+    {
+        lua_createtable(L, 0, 1);
+        lua_pushinteger(L, i);
+        lua_setfield(L, -2, "value");
+        lua_rawseti(L, -2, i);
+    }
+    lua_setglobal(L, "old");
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    luaC_validate(L);
+
+    int oldsize = lua_gc(L, LUA_GCCOUNT, 0);
+
+    // store young objects into old ones, running minor collections in between
+    for (int iter = 0; iter < 100; ++iter)
+    {
+        lua_getglobal(L, "old");
+
+        for (int i = 1; i <= 1000; i += 10)
+        {
+            lua_rawgeti(L, -1, i);
+            lua_pushfstring(L, "young %d %d", iter, i);
+            lua_setfield(L, -2, "young");
+            lua_pop(L, 1);
+        }
+
+        lua_pop(L, 1);
+
+        // short-lived garbage
+        for (int i = 0; i < 100; ++i)
+        {
+            lua_createtable(L, 10, 0);
+            lua_pop(L, 1);
+        }
+
+        lua_gc(L, LUA_GCSTEP, 4);
+        luaC_validate(L);
+    }
+
+    // finish the cycle in progress and make sure young objects stored into old ones are alive
+    while (!lua_gc(L, LUA_GCSTEP, 1024))
+        ;
+
+    lua_getglobal(L, "old");
+    for (int i = 1; i <= 1000; i += 10)
+    {
+        lua_rawgeti(L, -1, i);
+        lua_getfield(L, -1, "young");
+        CHECK(strcmp(lua_tostring(L, -1), ("young 99 " + std::to_string(i)).c_str()) == 0);
+        lua_getfield(L, -2, "value");
+        CHECK(lua_tointeger(L, -1) == i);
+        lua_pop(L, 3);
+    }
+    lua_pop(L, 1);
+
+    // old objects are released by a full collection
+    lua_pushnil(L);
+    lua_setglobal(L, "old");
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    CHECK(lua_gc(L, LUA_GCCOUNT, 0) < oldsize);
+    luaC_validate(L);
+
+    CHECK(lua_gc(L, LUA_GCINC, 0) == 1);
+    luaC_validate(L);
+}
+
 TEST_CASE("Bitwise")
 {
     runConformance("bitwise.lua");
@@ -1054,24 +1634,147 @@ TEST_CASE("ApiTables")
     lua_pop(L, 1);
 }
 
-TEST_CASE("ApiIter")
+TEST_CASE("ApiCloneTable")
 {
     StateRef globalState(luaL_newstate(), lua_close);
     lua_State* L = globalState.get();
 
-    lua_newtable(L);
-    lua_pushnumber(L, 123.0);
-    lua_setfield(L, -2, "key");
-    lua_pushnumber(L, 456.0);
-    lua_rawsetfield(L, -2, "key2");
-    lua_pushstring(L, "test");
-    lua_rawseti(L, -2, 1);
+    luaL_openlibs(L);
 
-    // Lua-compatible iteration interface: lua_next
-    double sum1 = 0;
-    lua_pushnil(L);
-    while (lua_next(L, -2))
-    {
+    lua_pushcfunction(
+        L,
+        [](lua_State* L) -> int
+        {
+            luaL_checktype(L, 1, LUA_TTABLE);
+            lua_clonetable(L, 1);
+            return 1;
+        },
+        "cowclone"
+    );
+    lua_setglobal(L, "cowclone");
+
+    lua_pushcfunction(L, lua_collectgarbage, "collectgarbage");
+    lua_setglobal(L, "collectgarbage");
+
+    const char* source = R"(
+        local function make(n)
+            local t = {}
+            for i = 1, n do t[i] = i end
+            for i = 1, n do t["k" .. i] = {i} end
+            return t
+        end
+
+        -- writes through the interpreter, the API and the library detach only the table being written to
+        local src = make(100)
+        local a, b = cowclone(src), cowclone(src)
+        a[1] = -1
+        a.k1 = "a"
+        rawset(b, 2, -2)
+        table.insert(b, 101)
+        src.k3 = "src"
+        assert(src[1] == 1 and src[2] == 2 and #src == 100 and src.k1[1] == 1 and src.k3 == "src")
+        assert(a[1] == -1 and a[2] == 2 and #a == 100 and a.k1 == "a" and a.k3[1] == 3)
+        assert(b[1] == 1 and b[2] == -2 and #b == 101 and b.k1[1] == 1 and b.k3[1] == 3)
+
+        -- new keys, table functions and iteration
+        local c = cowclone(src)
+        c.extra = true
+        table.sort(c, function(x, y) return x > y end)
+        table.clear(src)
+        assert(next(src) == nil)
+        assert(c[1] == 100 and c[100] == 1 and c.extra and c.k50[1] == 50)
+        local count = 0
+        for _ in c do count += 1 end
+        assert(count == 201)
+
+        -- readonly is not inherited and still applies to shared tables
+        local frozen = table.freeze(make(10))
+        local d = cowclone(frozen)
+        assert(table.isfrozen(frozen) and not table.isfrozen(d))
+        assert(not pcall(function() frozen[1] = 0 end))
+        d[1] = 0
+        assert(d[1] == 0 and frozen[1] == 1)
+        table.freeze(d)
+        assert(not pcall(function() d.k1 = 0 end))
+        assert(not pcall(rawset, d, 1, 1))
+
+        -- metatables are shared like in table.clone, setting one detaches the storage
+        local mt = { __index = function() return "mt" end }
+        local e = cowclone(setmetatable(make(10), mt))
+        assert(getmetatable(e) == mt and e.missing == "mt")
+        setmetatable(e, { __mode = "v" })
+        assert(e[1] == 1 and e.k1[1] == 1)
+
+        -- weak tables are copied eagerly
+        local weak = setmetatable({ {} }, { __mode = "v" })
+        local f = cowclone(weak)
+        collectgarbage()
+        assert(weak[1] == nil and f[1] == nil)
+
+        -- shared storage is released once all owners are gone
+        local g = cowclone(make(1000))
+        collectgarbage()
+        assert(g[1000] == 1000 and g.k1000[1] == 1000)
+        g[1] = 0
+        g = nil
+        collectgarbage()
+
+        return "OK"
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=ApiCloneTable", bytecode, bytecodeSize, 0);
+    free(bytecode);
+    REQUIRE(result == 0);
+
+    int status = lua_pcall(L, 0, 1, 0);
+    INFO(std::string(lua_tostring(L, -1)));
+    REQUIRE(status == LUA_OK);
+    CHECK(std::string(lua_tostring(L, -1)) == "OK");
+    lua_pop(L, 1);
+
+    // API writes detach too
+    lua_newtable(L);
+    lua_pushnumber(L, 1.0);
+    lua_rawseti(L, -2, 1);
+    lua_pushnumber(L, 2.0);
+    lua_setfield(L, -2, "key");
+    lua_clonetable(L, -1);
+    lua_pushnumber(L, 3.0);
+    lua_rawsetfield(L, -2, "key");
+    lua_cleartable(L, -2);
+
+    CHECK(lua_rawgeti(L, -1, 1) == LUA_TNUMBER);
+    lua_pop(L, 1);
+    CHECK(lua_getfield(L, -1, "key") == LUA_TNUMBER);
+    CHECK(lua_tonumber(L, -1) == 3.0);
+    lua_pop(L, 1);
+
+    lua_pushnil(L);
+    CHECK(lua_next(L, -3) == 0);
+
+    lua_pop(L, 2);
+}
+
+TEST_CASE("ApiIter")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    lua_newtable(L);
+    lua_pushnumber(L, 123.0);
+    lua_setfield(L, -2, "key");
+    lua_pushnumber(L, 456.0);
+    lua_rawsetfield(L, -2, "key2");
+    lua_pushstring(L, "test");
+    lua_rawseti(L, -2, 1);
+
+    // Lua-compatible iteration interface: lua_next
+    double sum1 = 0;
+    lua_pushnil(L);
+    while (lua_next(L, -2))
+    {
         sum1 += lua_tonumber(L, -2); // key
         sum1 += lua_tonumber(L, -1); // value
         lua_pop(L, 1);               // pop value, key is used by lua_next
@@ -1547,6 +2250,95 @@ TEST_CASE("Coverage")
         nullptr, nullptr, &copts);
 }
 
+TEST_CASE("ExecutionCounters")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    const char* source = R"(
+        local function add(a, b)
+            return a + b
+        end
+
+        local sum = 0
+        for i = 1, 10 do
+            sum = add(sum, i)
+        end
+
+        local j = 0
+        while j < 5 do
+            j += 1
+        end
+
+        return sum
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=ExecutionCounters", bytecode, bytecodeSize, 0);
+    free(bytecode);
+    REQUIRE(result == 0);
+
+    lua_resetopcounters(L);
+
+    lua_pushvalue(L, -1);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tonumber(L, -1) == 55);
+    lua_pop(L, 1);
+
+    struct Entry
+    {
+        std::string name;
+        int depth;
+        uint64_t calls;
+        uint64_t loops;
+    };
+
+    std::vector<Entry> entries;
+    lua_getcounters(L, -1, &entries, [](void* context, const char* function, int linedefined, int depth, uint64_t calls, uint64_t loops) {
+        static_cast<std::vector<Entry>*>(context)->push_back({function ? function : "", depth, calls, loops});
+    });
+
+    REQUIRE(entries.size() == 2);
+    CHECK(entries[0].depth == 0);
+    CHECK(entries[1].name == "add");
+    CHECK(entries[1].depth == 1);
+
+    std::vector<uint64_t> ops(LOP__COUNT);
+    CHECK(lua_getopcounters(L, ops.data(), int(ops.size())) == LOP__COUNT);
+
+#if LUAI_EXECCOUNTERS
+    CHECK(entries[0].calls == 1);
+    CHECK(entries[0].loops == 9 + 5);
+    CHECK(entries[1].calls == 10);
+    CHECK(entries[1].loops == 0);
+
+    CHECK(ops[LOP_FORNLOOP] == 10);
+    CHECK(ops[LOP_JUMPBACK] == 5);
+    CHECK(ops[LOP_CALL] == 10);
+    CHECK(ops[LOP_RETURN] == 11);
+
+    lua_resetcounters(L, -1);
+    lua_resetopcounters(L);
+#endif
+
+    entries.clear();
+    lua_getcounters(L, -1, &entries, [](void* context, const char* function, int linedefined, int depth, uint64_t calls, uint64_t loops) {
+        static_cast<std::vector<Entry>*>(context)->push_back({function ? function : "", depth, calls, loops});
+    });
+
+    for (const Entry& e : entries)
+    {
+        CHECK(e.calls == 0);
+        CHECK(e.loops == 0);
+    }
+
+    lua_getopcounters(L, ops.data(), int(ops.size()));
+
+    for (uint64_t count : ops)
+        CHECK(count == 0);
+}
+
 TEST_CASE("StringConversion")
 {
     runConformance("strconv.lua");
@@ -1648,6 +2440,265 @@ TEST_CASE("GCDump")
     CHECK(!ctx.edges.empty());
 }
 
+TEST_CASE("HeapSnapshot")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    lua_pushstring(L, "local x = {} local function f() x[1] = math.abs(42) end data = { nested = { f = f } } return f");
+    lua_loadstring(L);
+    lua_call(L, 0, 1);
+
+    lua_newuserdata(L, 42);
+    lua_newbuffer(L, 100);
+
+    lua_State* CL = lua_newthread(L);
+
+    lua_pushstring(CL, "function foo() coroutine.yield() end foo()");
+    lua_loadstring(CL);
+    lua_resume(CL, nullptr, 0);
+
+    std::string snapshot;
+
+    lua_heapsnapshot(
+        L,
+        [](void* ud, const void* data, size_t size)
+        {
+            static_cast<std::string*>(ud)->append(static_cast<const char*>(data), size);
+        },
+        &snapshot
+    );
+
+    REQUIRE(snapshot.size() > 5);
+    CHECK(memcmp(snapshot.data(), "LHS\0", 4) == 0);
+
+    // snapshot is large enough to require multiple flushes of the write buffer
+    CHECK(snapshot.size() > 4096);
+
+    // paths of tables and functions reachable from globals are included
+    CHECK(snapshot.find("_G.data.nested.f") != std::string::npos);
+    CHECK(snapshot.find("_G.math.abs") != std::string::npos);
+    CHECK(snapshot.find("registry") != std::string::npos);
+}
+
+TEST_CASE("HeapSnapshotWriterError")
+{
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    luaL_openlibs(L);
+
+    // enough named tables for the paths to take several writes
+    lua_pushstring(L, "data = {} for i = 1, 2000 do data['table_with_a_long_name_' .. i] = {} end");
+    lua_loadstring(L);
+    lua_call(L, 0, 0);
+
+    struct Writer
+    {
+        lua_State* L;
+        int calls;
+        int failat;
+    };
+
+    static const auto writer = [](void* ud, const void* data, size_t size)
+    {
+        Writer* w = static_cast<Writer*>(ud);
+
+        if (++w->calls == w->failat)
+            luaL_error(w->L, "write failed");
+    };
+
+    static Writer state;
+
+    lua_CFunction snapshot = [](lua_State* L) -> int
+    {
+        lua_heapsnapshot(L, writer, &state);
+        return 0;
+    };
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    size_t before = lua_totalbytes(L, 0);
+
+    state = {L, 0, 0};
+    lua_pushcfunction(L, snapshot, "snapshot");
+    REQUIRE(lua_pcall(L, 0, 0, 0) == LUA_OK);
+    REQUIRE(state.calls > 2);
+
+    // the second to last write comes from the paths, which use temporary arrays
+    state = {L, 0, state.calls - 1};
+    lua_pushcfunction(L, snapshot, "snapshot");
+    CHECK(lua_pcall(L, 0, 0, 0) == LUA_ERRRUN);
+    CHECK(strstr(lua_tostring(L, -1), "write failed") != nullptr);
+    lua_pop(L, 1);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    CHECK(lua_totalbytes(L, 0) <= before);
+}
+
+TEST_CASE("StateImage")
+{
+    static const auto loadsource = [](lua_State* L, const char* source)
+    {
+        size_t bytecodeSize = 0;
+        char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+        int result = luau_load(L, "=image", bytecode, bytecodeSize, 0);
+        free(bytecode);
+        REQUIRE(result == 0);
+    };
+
+    static const auto runsource = [](lua_State* L, const char* source) -> double
+    {
+        loadsource(L, source);
+        REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+        double result = lua_tonumber(L, -1);
+        lua_pop(L, 1);
+        return result;
+    };
+
+    static const auto writer = [](void* ud, const void* data, size_t size)
+    {
+        static_cast<std::string*>(ud)->append(static_cast<const char*>(data), size);
+    };
+
+    lua_CFunction add = [](lua_State* L) -> int
+    {
+        lua_pushnumber(L, luaL_checknumber(L, 1) + luaL_checknumber(L, 2));
+        return 1;
+    };
+
+    lua_CBinding bindings[] = {{"test.add", add, nullptr}};
+
+    StateRef sourceState(luaL_newstate(), lua_close);
+    lua_State* L = sourceState.get();
+
+    lua_pushcfunction(L, add, "add");
+    lua_setglobal(L, "add");
+
+    loadsource(L, R"(
+local counter = 10
+local shared = {}
+
+function bump(n)
+    counter += n
+    return counter
+end
+
+function getshared()
+    return shared
+end
+
+config = { list = {1, 2, 3}, [true] = 1.5, answer = add(40, 2) }
+config.self = config
+)");
+    REQUIRE(lua_pcall(L, 0, 0, 0) == LUA_OK);
+
+    lua_getglobal(L, "config");
+    lua_setreadonly(L, -1, true);
+    lua_pop(L, 1);
+
+    *static_cast<int*>(lua_newuserdatatagged(L, sizeof(int), 7)) = 1234;
+    lua_newtable(L);
+    lua_setmetatable(L, -2);
+    lua_setglobal(L, "ud");
+
+    lua_pushnumber(L, 1);
+    lua_setglobal(L, "version");
+
+    lua_setsafeenv(L, LUA_GLOBALSINDEX, true);
+
+    lua_pushnumber(L, 7);
+    lua_setfield(L, LUA_REGISTRYINDEX, "marker");
+
+    std::string image;
+    REQUIRE(lua_savestate(L, bindings, 1, writer, &image) == 0);
+    CHECK(memcmp(image.data(), "LSI\0", 4) == 0);
+
+    StateRef restoredState(luaL_newstate(), lua_close);
+    lua_State* R = restoredState.get();
+
+    REQUIRE(lua_restorestate(R, image.data(), image.size(), bindings, 1) == 0);
+
+    // closures keep their upvalues, and the restored state is independent from the original one
+    CHECK(runsource(R, "return bump(5)") == 15);
+    CHECK(runsource(R, "return bump(1)") == 16);
+    CHECK(runsource(L, "return bump(1)") == 11);
+    CHECK(runsource(R, "return getshared() == getshared() and 1 or 0") == 1);
+
+    // tables keep their contents, identity and flags
+    CHECK(runsource(R, "return config.self == config and config.list[3] + config[true] or 0") == 4.5);
+    CHECK(runsource(R, "return config.answer") == 42);
+    CHECK(runsource(R, "return add(2, 3)") == 5);
+
+    lua_getglobal(R, "config");
+    CHECK(lua_getreadonly(R, -1));
+    lua_pop(R, 1);
+
+    // userdata keeps its tag, contents and metatable
+    lua_getglobal(R, "ud");
+    CHECK(lua_userdatatag(R, -1) == 7);
+    CHECK(*static_cast<int*>(lua_touserdatatagged(R, -1, 7)) == 1234);
+    CHECK(lua_getmetatable(R, -1));
+    lua_pop(R, 2);
+
+    // the previous roots of the restored state are garbage now, and restored objects must survive a collection
+    lua_gc(R, LUA_GCCOLLECT, 0);
+    CHECK(runsource(R, "return bump(1)") == 17);
+
+    // with safeenv, imports are resolved when the chunk is loaded, so later changes to globals are not visible to it
+    loadsource(R, "return version");
+    lua_pushnumber(R, 2);
+    lua_setglobal(R, "version");
+    REQUIRE(lua_pcall(R, 0, 1, 0) == LUA_OK);
+    CHECK(lua_tonumber(R, -1) == 1);
+    lua_pop(R, 1);
+
+    // restoring in the middle of a collection cycle keeps the new roots alive until the end of the cycle and after it
+    StateRef midcycleState(luaL_newstate(), lua_close);
+    lua_State* M = midcycleState.get();
+
+    lua_createtable(M, 10000, 0);
+    for (int i = 1; i <= 10000; ++i)
+    {
+        lua_newtable(M);
+        lua_rawseti(M, -2, i);
+    }
+    lua_setglobal(M, "filler");
+
+    REQUIRE(lua_gc(M, LUA_GCSTEP, 0) == 0);
+    REQUIRE(lua_restorestate(M, image.data(), image.size(), bindings, 1) == 0);
+
+    while (lua_gc(M, LUA_GCSTEP, 0) == 0)
+    {
+    }
+
+    lua_gc(M, LUA_GCCOLLECT, 0);
+
+    lua_getfield(M, LUA_REGISTRYINDEX, "marker");
+    CHECK(lua_tonumber(M, -1) == 7);
+    lua_pop(M, 1);
+    CHECK(runsource(M, "return bump(1)") == 11);
+
+    // C functions without a binding and invalid images are reported as errors
+    CHECK(lua_savestate(L, nullptr, 0, writer, &image) != 0);
+    CHECK(strcmp(lua_tostring(L, -1), "can't save C function 'add' without a binding") == 0);
+    lua_pop(L, 1);
+
+    StateRef failedState(luaL_newstate(), lua_close);
+    lua_State* F = failedState.get();
+
+    CHECK(lua_restorestate(F, image.data(), image.size() / 2, bindings, 1) != 0);
+    CHECK(strcmp(lua_tostring(F, -1), "malformed state image") == 0);
+    lua_pop(F, 1);
+
+    CHECK(lua_restorestate(F, image.data(), image.size(), nullptr, 0) != 0);
+    CHECK(strcmp(lua_tostring(F, -1), "no binding for C function 'test.add'") == 0);
+    lua_pop(F, 1);
+
+    lua_gc(F, LUA_GCCOLLECT, 0);
+}
+
 TEST_CASE("Interrupt")
 {
     lua_CompileOptions copts = defaultOptions();
@@ -2167,6 +3218,468 @@ TEST_CASE("NativeTypeAnnotations")
     });
 }
 
+TEST_CASE("NativeLoopVectorization")
+{
+    // This tests requires code to run natively, otherwise all 'is_native' checks will fail
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    ScopedFastFlag luauCodegenLoopVectorization{FFlag::LuauCodegenLoopVectorization, true};
+
+    runConformance("native_vectorize.lua", [](lua_State* L) {
+        setupNativeHelpers(L);
+    });
+}
+
+TEST_CASE("NativeTiering")
+{
+    // This tests requires code to run natively, otherwise all 'is_native' checks will fail
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::create(L);
+
+    Luau::CodeGen::TieringOptions tieringOptions;
+    tieringOptions.threshold = 10;
+    Luau::CodeGen::setTiering(L, tieringOptions);
+
+    luaL_openlibs(L);
+    setupNativeHelpers(L);
+    luaL_sandbox(L);
+    luaL_sandboxthread(L);
+
+    const char* source = R"(
+        local function cold()
+            return is_native()
+        end
+
+        local function hot()
+            return is_native()
+        end
+
+        local function loop(n)
+            local native = is_native()
+            for i = 1, n do
+            end
+            return native
+        end
+
+        -- functions switch to native code on the call that reaches the threshold
+        local calls = {}
+        for i = 1, 20 do
+            calls[i] = hot()
+        end
+
+        assert(calls[1] == false and calls[9] == false)
+        assert(calls[10] == true and calls[20] == true)
+        assert(cold() == false)
+
+        -- loop iterations count towards the threshold; the running call stays in the interpreter
+        assert(loop(100) == false)
+        assert(loop(1) == true)
+
+        return "OK"
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=NativeTiering", bytecode, bytecodeSize, 0);
+    free(bytecode);
+    REQUIRE(result == 0);
+
+    int status = lua_pcall(L, 0, 1, 0);
+    INFO(std::string(lua_tostring(L, -1)));
+    REQUIRE(status == LUA_OK);
+    CHECK(std::string(lua_tostring(L, -1)) == "OK");
+}
+
+#if LUAI_TYPEFEEDBACK
+TEST_CASE("NativeTypeFeedback")
+{
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::create(L);
+
+    // Threshold is high enough for the function to stay in the interpreter while it records operand types
+    Luau::CodeGen::TieringOptions tieringOptions;
+    tieringOptions.threshold = 1000;
+    Luau::CodeGen::setTiering(L, tieringOptions);
+
+    luaL_openlibs(L);
+    lua_pushcfunction(L, lua_vector, "vector");
+    lua_setglobal(L, "vector");
+
+    const char* source = R"(
+        local function add(a, b)
+            return a + b
+        end
+
+        for i = 1, 20 do
+            add(vector(i, 0, 0), vector(0, i, 0))
+        end
+
+        return add
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=NativeTypeFeedback", bytecode, bytecodeSize, 0);
+    free(bytecode);
+    REQUIRE(result == 0);
+
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    REQUIRE(lua_isfunction(L, -1));
+
+    Luau::CodeGen::AssemblyOptions options;
+    options.includeIr = true;
+
+    // Observed vector operands select the vector fast path without type annotations
+    std::string ir = Luau::CodeGen::getAssembly(L, -1, options, nullptr);
+    CHECK(ir.find("ADD_VEC") != std::string::npos);
+
+    REQUIRE(Luau::CodeGen::compile(L, -1, Luau::CodeGen::CodeGen_ColdFunctions).result == Luau::CodeGen::CodeGenCompilationResult::Success);
+
+    // Operands that don't match the feedback exit to the interpreter
+    lua_pushvalue(L, -1);
+    lua_pushnumber(L, 2);
+    lua_pushnumber(L, 3);
+    REQUIRE(lua_pcall(L, 2, 1, 0) == LUA_OK);
+    CHECK(lua_tonumber(L, -1) == 5);
+    lua_pop(L, 1);
+
+    lua_pushvalue(L, -1);
+    for (int i = 0; i < 2; i++)
+    {
+        lua_getglobal(L, "vector");
+        lua_pushnumber(L, 1 + i * 3);
+        lua_pushnumber(L, 2 + i * 3);
+        lua_pushnumber(L, 3 + i * 3);
+        REQUIRE(lua_pcall(L, 3, 1, 0) == LUA_OK);
+    }
+    REQUIRE(lua_pcall(L, 2, 1, 0) == LUA_OK);
+    const float* v = lua_tovector(L, -1);
+    REQUIRE(v);
+    CHECK(v[0] == 5);
+    CHECK(v[1] == 7);
+    CHECK(v[2] == 9);
+    lua_pop(L, 1);
+}
+
+TEST_CASE("NativeTypeFeedbackSuperinstructions")
+{
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, true};
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::create(L);
+
+    Luau::CodeGen::TieringOptions tieringOptions;
+    tieringOptions.threshold = 1000;
+    Luau::CodeGen::setTiering(L, tieringOptions);
+
+    luaL_openlibs(L);
+
+    // both instruction pairs are fused, so the feedback is recorded at the superinstruction
+    const char* source = R"(
+        local function get(t, i, j)
+            return t[i][j] + t[j]
+        end
+
+        -- the call goes through a table to prevent inlining
+        local m = {get = get}
+        local t = {{1, 2}, 3}
+        for i = 1, 20 do
+            m.get(t, 1, 2)
+        end
+
+        return get
+    )";
+
+    lua_CompileOptions copts = defaultOptions();
+    copts.optimizationLevel = 2;
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), &copts, &bytecodeSize);
+    int result = luau_load(L, "=NativeTypeFeedbackSuperinstructions", bytecode, bytecodeSize, 0);
+    free(bytecode);
+    REQUIRE(result == 0);
+
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    REQUIRE(lua_isfunction(L, -1));
+
+    Luau::CodeGen::AssemblyOptions options;
+    options.includeIr = true;
+
+    std::string ir = Luau::CodeGen::getAssembly(L, -1, options, nullptr);
+    INFO(ir);
+    CHECK(ir.find("CHECK_TAG R0, ttable, exit(0)") != std::string::npos);
+    CHECK(ir.find("CHECK_TAG R0, ttable, exit(2)") != std::string::npos);
+}
+#endif
+
+static int asyncHostInterrupts = 0;
+
+TEST_CASE("NativeCompileAsync")
+{
+    // This tests requires code to run natively, otherwise all 'is_native' checks will fail
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::create(L);
+
+    luaL_openlibs(L);
+    setupNativeHelpers(L);
+    luaL_sandbox(L);
+    luaL_sandboxthread(L);
+
+    asyncHostInterrupts = 0;
+
+    void (*hostInterrupt)(lua_State*, int) = [](lua_State* L, int gc) {
+        asyncHostInterrupts++;
+    };
+
+    lua_callbacks(L)->interrupt = hostInterrupt;
+
+    const char* source = R"(
+        local function probe()
+            return is_native()
+        end
+
+        -- native code is installed at a safepoint once the background compilation finishes
+        return function()
+            local iterations = 0
+            while not probe() do
+                iterations += 1
+                assert(iterations < 1e9)
+            end
+            return is_native()
+        end
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    int result = luau_load(L, "=NativeCompileAsync", bytecode, bytecodeSize, 0);
+    free(bytecode);
+    REQUIRE(result == 0);
+
+    CHECK(Luau::CodeGen::compileAsync(L, -1, {}) == Luau::CodeGen::CodeGenCompilationResult::Success);
+    CHECK(bool(lua_callbacks(L)->interrupt != hostInterrupt));
+
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+
+    lua_pushvalue(L, -1);
+    int status = lua_pcall(L, 0, 1, 0);
+    INFO(std::string(lua_tostring(L, -1)));
+    REQUIRE(status == LUA_OK);
+    lua_pop(L, 1);
+
+    // the host interrupt keeps running while the compilation is pending and is restored afterwards
+    CHECK(asyncHostInterrupts > 0);
+    CHECK(bool(lua_callbacks(L)->interrupt == hostInterrupt));
+    CHECK(Luau::CodeGen::installCompiledCode(L) == 0);
+
+    lua_pushvalue(L, -1);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    CHECK(lua_toboolean(L, -1) == 1);
+    lua_pop(L, 1);
+
+    // compilations can be installed explicitly; the main chunk is skipped as a cold function
+    bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    result = luau_load(L, "=NativeCompileAsync2", bytecode, bytecodeSize, 0);
+    free(bytecode);
+    REQUIRE(result == 0);
+
+    CHECK(Luau::CodeGen::compileAsync(L, -1, {}) == Luau::CodeGen::CodeGenCompilationResult::Success);
+    CHECK(Luau::CodeGen::installCompiledCode(L, /* wait= */ true) == 2);
+    CHECK(Luau::CodeGen::compileAsync(L, -1, {}) == Luau::CodeGen::CodeGenCompilationResult::NothingToCompile);
+
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    CHECK(lua_toboolean(L, -1) == 1);
+
+    // pending compilations are dropped when the state is closed
+    bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    result = luau_load(L, "=NativeCompileAsync3", bytecode, bytecodeSize, 0);
+    free(bytecode);
+    REQUIRE(result == 0);
+
+    CHECK(Luau::CodeGen::compileAsync(L, -1, {}) == Luau::CodeGen::CodeGenCompilationResult::Success);
+}
+
+TEST_CASE("NativeAot")
+{
+    // This tests requires code to run natively, otherwise all 'is_native' checks will fail
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    const char* source = R"(
+        local function sum(n)
+            local s = 0
+            for i = 1, n do
+                s += i * 0.5
+            end
+            return s, is_native()
+        end
+
+        return function()
+            local s, native = sum(100)
+            assert(s == 2525)
+            return native and is_native()
+        end
+    )";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+
+    std::string blob;
+
+    {
+        StateRef globalState(luaL_newstate(), lua_close);
+        lua_State* L = globalState.get();
+
+        REQUIRE(luau_load(L, "=NativeAot", bytecode, bytecodeSize, 0) == 0);
+        CHECK(Luau::CodeGen::compileAot(L, -1, {}, blob).result == Luau::CodeGen::CodeGenCompilationResult::Success);
+        CHECK(!blob.empty());
+    }
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::create(L);
+
+    luaL_openlibs(L);
+    setupNativeHelpers(L);
+    luaL_sandbox(L);
+    luaL_sandboxthread(L);
+
+    REQUIRE(luau_load(L, "=NativeAot", bytecode, bytecodeSize, 0) == 0);
+    free(bytecode);
+
+    // blobs are rejected when they were produced with different flags or when they are truncated
+    CHECK(Luau::CodeGen::loadAot(L, -1, {Luau::CodeGen::CodeGen_ColdFunctions}, blob.data(), blob.size()).result ==
+          Luau::CodeGen::CodeGenCompilationResult::AotBlobMismatch);
+    CHECK(Luau::CodeGen::loadAot(L, -1, {}, blob.data(), blob.size() - 1).result == Luau::CodeGen::CodeGenCompilationResult::AotBlobMismatch);
+
+    Luau::CodeGen::CompilationStats stats;
+    CHECK(Luau::CodeGen::loadAot(L, -1, {}, blob.data(), blob.size(), &stats).result == Luau::CodeGen::CodeGenCompilationResult::Success);
+    CHECK(stats.functionsBound == 2);
+    CHECK(Luau::CodeGen::loadAot(L, -1, {}, blob.data(), blob.size()).result == Luau::CodeGen::CodeGenCompilationResult::NothingToCompile);
+
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+
+    int status = lua_pcall(L, 0, 1, 0);
+    INFO(lua_tostring(L, -1));
+    REQUIRE(status == LUA_OK);
+    CHECK(lua_toboolean(L, -1) == 1);
+
+    // blobs are rejected for different bytecode
+    const char* otherSource = "return function() return 1 end";
+    bytecode = luau_compile(otherSource, strlen(otherSource), nullptr, &bytecodeSize);
+    REQUIRE(luau_load(L, "=NativeAotOther", bytecode, bytecodeSize, 0) == 0);
+    free(bytecode);
+
+    CHECK(Luau::CodeGen::loadAot(L, -1, {}, blob.data(), blob.size()).result == Luau::CodeGen::CodeGenCompilationResult::AotBlobMismatch);
+}
+
+static void checkAotPatchedBytecode(const char* name, const char* source, int optimizationLevel, double expected)
+{
+    lua_CompileOptions copts = defaultOptions();
+    copts.optimizationLevel = optimizationLevel;
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), &copts, &bytecodeSize);
+
+    std::string blob;
+
+    {
+        StateRef globalState(luaL_newstate(), lua_close);
+        lua_State* L = globalState.get();
+
+        luaL_openlibs(L);
+        setupNativeHelpers(L);
+
+        REQUIRE(luau_load(L, name, bytecode, bytecodeSize, 0) == 0);
+
+        // slot hints of the table accesses are updated by the interpreter before the blob is produced
+        lua_pushvalue(L, -1);
+        REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+        REQUIRE(lua_pcall(L, 0, 2, 0) == LUA_OK);
+        CHECK(lua_tonumber(L, -2) == expected);
+        lua_pop(L, 2);
+
+        CHECK(Luau::CodeGen::compileAot(L, -1, {}, blob).result == Luau::CodeGen::CodeGenCompilationResult::Success);
+    }
+
+    StateRef globalState(luaL_newstate(), lua_close);
+    lua_State* L = globalState.get();
+
+    Luau::CodeGen::create(L);
+
+    luaL_openlibs(L);
+    setupNativeHelpers(L);
+    luaL_sandbox(L);
+    luaL_sandboxthread(L);
+
+    REQUIRE(luau_load(L, name, bytecode, bytecodeSize, 0) == 0);
+    free(bytecode);
+
+    CHECK(Luau::CodeGen::loadAot(L, -1, {}, blob.data(), blob.size()).result == Luau::CodeGen::CodeGenCompilationResult::Success);
+
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+    REQUIRE(lua_pcall(L, 0, 2, 0) == LUA_OK);
+    CHECK(lua_tonumber(L, -2) == expected);
+    CHECK(lua_toboolean(L, -1) == 1);
+}
+
+TEST_CASE("NativeAotPatchedBytecode")
+{
+    // This tests requires code to run natively, otherwise all 'is_native' checks will fail
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    checkAotPatchedBytecode("=NativeAotPatchedBytecode", R"(
+        local t = {}
+        for i = 1, 16 do t["k" .. i] = i end
+
+        return function()
+            return t.k1 + t.k7 + t.k16, is_native()
+        end
+    )", 1, 24);
+}
+
+TEST_CASE("NativeAotPatchedSuperinstructions")
+{
+    // This tests requires code to run natively, otherwise all 'is_native' checks will fail
+    if (!codegen || !luau_codegen_supported())
+        return;
+
+    ScopedFastFlag luauCompileSuperinstructions{FFlag::LuauCompileSuperinstructions, true};
+
+    // chained field accesses are fused into GETTABLEKS_GETTABLEKS, which has its slot hint patched like GETTABLEKS
+    checkAotPatchedBytecode("=NativeAotPatchedSuperinstructions", R"(
+        local t = {}
+        for i = 1, 16 do t["k" .. i] = { v = i } end
+
+        return function()
+            return t.k1.v + t.k7.v + t.k16.v, is_native()
+        end
+    )", 2, 24);
+}
+
 [[nodiscard]] static std::string makeHugeFunctionSource()
 {
     std::string source;
@@ -2293,6 +3806,162 @@ TEST_CASE("HugeFunctionLoadFailure")
     REQUIRE_EQ(largeAllocationToFail, expectedTotalLargeAllocations);
 }
 
+TEST_CASE("SharedBytecodeImage")
+{
+    const char* source = R"(
+local function add(a, b)
+    return a + b
+end
+
+local function fail()
+    error("boom")
+end
+
+return function(x)
+    if x == 0 then
+        local ok, err = pcall(fail)
+        return err
+    end
+    return add(x, 1)
+end
+)";
+
+    size_t bytecodeSize = 0;
+    char* bytecode = luau_compile(source, strlen(source), nullptr, &bytecodeSize);
+    lua_BytecodeImage* image = luau_newimage(bytecode, bytecodeSize);
+    free(bytecode);
+
+    StateRef globalState1(luaL_newstate(), lua_close);
+    StateRef globalState2(luaL_newstate(), lua_close);
+    lua_State* states[] = {globalState1.get(), globalState2.get()};
+
+    for (lua_State* L : states)
+    {
+        luaL_openlibs(L);
+
+        REQUIRE(luau_loadimage(L, "=image", image, 0) == 0);
+        REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+        REQUIRE(lua_isfunction(L, -1));
+    }
+
+    // functions in both states now refer to the image, so it remains alive after the creator releases it
+    luau_releaseimage(image);
+
+    for (lua_State* L : states)
+    {
+        lua_pushvalue(L, -1);
+        lua_pushnumber(L, 41);
+        REQUIRE(lua_pcall(L, 1, 1, 0) == LUA_OK);
+        CHECK(lua_tonumber(L, -1) == 42);
+        lua_pop(L, 1);
+
+        // line information is shared as well
+        lua_pushvalue(L, -1);
+        lua_pushnumber(L, 0);
+        REQUIRE(lua_pcall(L, 1, 1, 0) == LUA_OK);
+        CHECK(strcmp(lua_tostring(L, -1), "image:7: boom") == 0);
+        lua_pop(L, 1);
+    }
+
+    // breakpoints give the function a private copy of its instructions, leaving the other state untouched
+    static int breakhits = 0;
+    lua_callbacks(states[0])->debugbreak = [](lua_State* L, lua_Debug* ar) {
+        breakhits++;
+    };
+
+    CHECK(lua_breakpoint(states[0], -1, 15, true) == 15);
+
+    for (lua_State* L : states)
+    {
+        lua_pushvalue(L, -1);
+        lua_pushnumber(L, 1);
+        REQUIRE(lua_pcall(L, 1, 1, 0) == LUA_OK);
+        CHECK(lua_tonumber(L, -1) == 2);
+        lua_pop(L, 1);
+    }
+
+    CHECK(breakhits == 1);
+
+    // running functions keep using the shared instructions, so they can't get a breakpoint, even on the main thread
+    const char* recursive = R"(
+local function f(setbreak)
+    if setbreak then
+        return setbreak(f)
+    end
+    return 1
+end
+
+return f
+)";
+
+    bytecode = luau_compile(recursive, strlen(recursive), nullptr, &bytecodeSize);
+    lua_BytecodeImage* recursiveImage = luau_newimage(bytecode, bytecodeSize);
+    free(bytecode);
+
+    lua_State* L = states[1];
+    REQUIRE(luau_loadimage(L, "=recursive", recursiveImage, 0) == 0);
+    luau_releaseimage(recursiveImage);
+    REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+
+    lua_pushvalue(L, -1);
+    lua_pushcfunction(
+        L,
+        [](lua_State* L) {
+            lua_pushinteger(L, lua_breakpoint(L, 1, 6, true));
+            return 1;
+        },
+        "setbreak"
+    );
+    REQUIRE(lua_pcall(L, 1, 1, 0) == LUA_OK);
+    CHECK(lua_tointeger(L, -1) == -1);
+    lua_pop(L, 1);
+
+    CHECK(lua_breakpoint(L, -1, 6, true) == 6);
+    lua_pop(L, 1);
+
+    // coverage counters are kept by each state
+    lua_CompileOptions copts = defaultOptions();
+    copts.coverageLevel = 1;
+
+    const char* counted = "return function() return 1 end";
+    bytecode = luau_compile(counted, strlen(counted), &copts, &bytecodeSize);
+    lua_BytecodeImage* countedImage = luau_newimage(bytecode, bytecodeSize);
+    free(bytecode);
+
+    int hits[2] = {};
+
+    for (int i = 0; i < 2; ++i)
+    {
+        lua_State* L = states[i];
+        REQUIRE(luau_loadimage(L, "=counted", countedImage, 0) == 0);
+        REQUIRE(lua_pcall(L, 0, 1, 0) == LUA_OK);
+
+        for (int j = 0; j <= i; ++j)
+        {
+            lua_pushvalue(L, -1);
+            REQUIRE(lua_pcall(L, 0, 0, 0) == LUA_OK);
+        }
+
+        lua_getcoverage(L, -1, &hits[i], [](void* context, const char* function, int linedefined, int depth, const int* hits, size_t size) {
+            if (depth == 0)
+                *static_cast<int*>(context) = hits[1];
+        });
+        lua_pop(L, 1);
+    }
+
+    luau_releaseimage(countedImage);
+
+    CHECK(hits[0] == 1);
+    CHECK(hits[1] == 2);
+
+    // load errors are reported the same way luau_load reports them
+    const char* error = "\0error";
+    lua_BytecodeImage* errorImage = luau_newimage(error, strlen(error + 1) + 1);
+    CHECK(luau_loadimage(states[0], "=image", errorImage, 0) != 0);
+    CHECK(strcmp(lua_tostring(states[0], -1), "imageerror") == 0);
+    luau_releaseimage(errorImage);
+}
+
 TEST_CASE("IrInstructionLimit")
 {
     if (!codegen || !luau_codegen_supported())
@@ -2387,26 +4056,26 @@ end
     CHECK_EQ(summaries[0].getLine(), 6);
     CHECK_EQ(summaries[0].getCounts(0),
         std::vector<unsigned>({0, 0, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0,
-            1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
+            1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
 
     CHECK_EQ(summaries[1].getName(), "first");
     CHECK_EQ(summaries[1].getLine(), 2);
     CHECK_EQ(summaries[1].getCounts(0),
         std::vector<unsigned>({0, 0, 1, 0, 2, 0, 3, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-            0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
+            0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
 
 
     CHECK_EQ(summaries[2].getName(), "second");
     CHECK_EQ(summaries[2].getLine(), 15);
     CHECK_EQ(summaries[2].getCounts(0),
         std::vector<unsigned>({0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
 
     CHECK_EQ(summaries[3].getName(), "");
     CHECK_EQ(summaries[3].getLine(), 1);
     CHECK_EQ(summaries[3].getCounts(0),
         std::vector<unsigned>({0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
 }
 
 TEST_SUITE_END();
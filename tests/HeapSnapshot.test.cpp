@@ -0,0 +1,127 @@
+// This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+#include "lua.h"
+#include "lualib.h"
+
+#include "HeapSnapshot.h"
+#include "Repl.h"
+
+#include "doctest.h"
+
+#include <memory>
+#include <string>
+
+static std::string takeSnapshot(lua_State* L)
+{
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    std::string result;
+
+    lua_heapsnapshot(
+        L,
+        [](void* ud, const void* data, size_t size)
+        {
+            static_cast<std::string*>(ud)->append(static_cast<const char*>(data), size);
+        },
+        &result
+    );
+
+    return result;
+}
+
+static HeapSnapshot parseSnapshot(const std::string& data)
+{
+    HeapSnapshot result;
+    std::string error;
+
+    bool ok = parseHeapSnapshot(data.data(), data.size(), result, error);
+    CHECK_MESSAGE(ok, error);
+
+    return result;
+}
+
+TEST_SUITE_BEGIN("HeapSnapshotTests");
+
+TEST_CASE("ParseSnapshot")
+{
+    std::unique_ptr<lua_State, void (*)(lua_State*)> state(luaL_newstate(), lua_close);
+    lua_State* L = state.get();
+
+    luaL_openlibs(L);
+
+    HeapSnapshot snapshot = parseSnapshot(takeSnapshot(L));
+
+    CHECK(!snapshot.objects.empty());
+    CHECK(snapshot.totalBytes == lua_totalbytes(L, -1));
+
+    uint64_t objectBytes = 0;
+
+    for (const HeapSnapshot::Object& object : snapshot.objects)
+        objectBytes += object.size;
+
+    CHECK(objectBytes <= snapshot.totalBytes);
+
+    // all references point to objects in the snapshot
+    for (uint64_t ref : snapshot.refs)
+        CHECK(snapshot.find(ref));
+
+    bool foundPath = false;
+
+    for (size_t i = 0; i < snapshot.objects.size(); ++i)
+    {
+        if (snapshot.objects[i].path >= 0 && snapshot.names[snapshot.objects[i].path] == "_G.string.format")
+        {
+            CHECK(snapshot.objects[i].type == LUA_TFUNCTION);
+            CHECK(describeHeapObject(snapshot, uint32_t(i)).find("[format]") != std::string::npos);
+            foundPath = true;
+        }
+    }
+
+    CHECK(foundPath);
+}
+
+TEST_CASE("ParseSnapshotErrors")
+{
+    HeapSnapshot snapshot;
+    std::string error;
+
+    CHECK(!parseHeapSnapshot("LHS", 3, snapshot, error));
+    CHECK(error == "not a heap snapshot");
+
+    std::unique_ptr<lua_State, void (*)(lua_State*)> state(luaL_newstate(), lua_close);
+    std::string data = takeSnapshot(state.get());
+
+    CHECK(!parseHeapSnapshot(data.data(), data.size() - 1, snapshot, error));
+    CHECK(error == "heap snapshot is truncated or corrupted");
+}
+
+TEST_CASE("DiffFindsRetainer")
+{
+    std::unique_ptr<lua_State, void (*)(lua_State*)> state(luaL_newstate(), lua_close);
+    lua_State* L = state.get();
+
+    luaL_openlibs(L);
+
+    runCode(L, "cache = { entries = {} } other = {}");
+
+    HeapSnapshot before = parseSnapshot(takeSnapshot(L));
+
+    runCode(L, "for i = 1, 100 do cache.entries[i] = { value = tostring(i) } end other.x = {}");
+
+    HeapSnapshot after = parseSnapshot(takeSnapshot(L));
+
+    HeapDiff diff = diffHeapSnapshots(before, after);
+
+    CHECK(diff.addedCount >= 200);
+    CHECK(diff.typeCount[LUA_TTABLE] >= 100);
+
+    REQUIRE(!diff.retainers.empty());
+
+    const HeapDiff::Group& top = diff.retainers[0];
+    REQUIRE(top.object != ~0u);
+
+    CHECK(after.objects[top.object].path >= 0);
+    CHECK(after.names[after.objects[top.object].path] == "_G.cache.entries");
+    CHECK(top.count >= 200);
+}
+
+TEST_SUITE_END();
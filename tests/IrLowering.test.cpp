@@ -25,6 +25,7 @@ LUAU_FASTFLAG(LuauCompileTempTypeInfo)
 LUAU_FASTFLAG(LuauCodegenFixVectorFields)
 LUAU_FASTFLAG(LuauCodegenVectorMispredictFix)
 LUAU_FASTFLAG(LuauCodegenAnalyzeHostVectorOps)
+LUAU_FASTFLAG(LuauCodegenLoopVectorization)
 
 static std::string getCodegenAssembly(const char* source, bool includeIrTypes = false, int debugLevel = 1)
 {
@@ -1629,4 +1630,128 @@ end
 )");
 }
 
+TEST_CASE("LoopVectorizationBufferScale")
+{
+    ScopedFastFlag sffs[]{{FFlag::LuauCodegenRemoveDeadStores5, true}, {FFlag::LuauCodegenLoopVectorization, true}};
+
+    CHECK_EQ("\n" + getCodegenAssembly(R"(
+local function scale(dst: buffer, src: buffer, n: number)
+    for i = 0, n - 1 do
+        buffer.writef32(dst, i * 4, buffer.readf32(src, i * 4) * 0.5)
+    end
+end
+)"),
+        R"(
+; function scale($arg0, $arg1, $arg2) line 2
+bb_0:
+  CHECK_TAG R0, tbuffer, exit(entry)
+  CHECK_TAG R1, tbuffer, exit(entry)
+  CHECK_TAG R2, tnumber, exit(entry)
+  JUMP bb_4
+bb_4:
+  JUMP bb_bytecode_1
+bb_bytecode_1:
+  STORE_DOUBLE R5, 0
+  STORE_TAG R5, tnumber
+  %12 = LOAD_DOUBLE R2
+  %13 = SUB_NUM %12, 1
+  STORE_DOUBLE R3, %13
+  STORE_TAG R3, tnumber
+  STORE_DOUBLE R4, 1
+  STORE_TAG R4, tnumber
+  JUMP_CMP_NUM 0, %13, not_le, bb_bytecode_3, bb_11
+bb_bytecode_2:
+  INTERRUPT 4u
+  %26 = LOAD_TVALUE R0
+  STORE_TVALUE R7, %26
+  CHECK_TAG R5, tnumber, bb_fallback_5
+  %30 = LOAD_DOUBLE R5
+  %31 = MUL_NUM %30, 4
+  STORE_DOUBLE R8, %31
+  STORE_TAG R8, tnumber
+  JUMP bb_6
+bb_6:
+  CHECK_TAG R5, tnumber, bb_fallback_7
+  %40 = LOAD_DOUBLE R5
+  %41 = MUL_NUM %40, 4
+  STORE_DOUBLE R12, %41
+  STORE_TAG R12, tnumber
+  JUMP bb_8
+bb_8:
+  CHECK_SAFE_ENV exit(9)
+  CHECK_TAG R1, tbuffer, exit(9)
+  CHECK_TAG R12, tnumber, exit(9)
+  %53 = LOAD_POINTER R1
+  %54 = LOAD_DOUBLE R12
+  %55 = NUM_TO_INT %54
+  CHECK_BUFFER_LEN %53, %55, 4i, exit(9)
+  %57 = BUFFER_READF32 %53, %55
+  STORE_DOUBLE R10, %57
+  STORE_TAG R10, tnumber
+  %63 = MUL_NUM %57, 0.5
+  STORE_DOUBLE R9, %63
+  STORE_TAG R9, tnumber
+  CHECK_TAG R7, tbuffer, exit(15)
+  CHECK_TAG R8, tnumber, exit(15)
+  %73 = LOAD_POINTER R7
+  %74 = LOAD_DOUBLE R8
+  %75 = NUM_TO_INT %74
+  CHECK_BUFFER_LEN %73, %75, 4i, exit(15)
+  BUFFER_WRITEF32 %73, %75, %63
+  %79 = LOAD_DOUBLE R3
+  %80 = LOAD_DOUBLE R5
+  %81 = ADD_NUM %80, 1
+  STORE_DOUBLE R5, %81
+  JUMP_CMP_NUM %81, %79, le, bb_bytecode_2, bb_bytecode_3
+bb_bytecode_3:
+  INTERRUPT 19u
+  RETURN R0, 0i
+bb_11:
+  %86 = LOAD_DOUBLE R5
+  %87 = NUM_TO_INT %86
+  %88 = INT_TO_NUM %87
+  JUMP_CMP_NUM %88, %86, not_eq, bb_bytecode_2, bb_12
+bb_12:
+  %90 = LOAD_DOUBLE R5
+  %91 = ADD_NUM %90, 1
+  %92 = LOAD_DOUBLE R3
+  JUMP_CMP_NUM %91, %92, le, bb_13, bb_bytecode_2
+bb_13:
+  INTERRUPT 4u
+  CHECK_SAFE_ENV bb_bytecode_2
+  CHECK_TAG R5, tnumber, bb_bytecode_2
+  CHECK_TAG R1, tbuffer, bb_bytecode_2
+  CHECK_TAG R0, tbuffer, bb_bytecode_2
+  %102 = LOAD_POINTER R0
+  %103 = LOAD_POINTER R1
+  CHECK_BUFFER_NO_ALIAS %103, %102, bb_bytecode_2
+  %105 = LOAD_DOUBLE R5
+  %106 = MUL_NUM %105, 4
+  %107 = NUM_TO_INT %106
+  CHECK_BUFFER_LEN %103, %107, 4i, bb_bytecode_2
+  %109 = ADD_NUM %105, 1
+  %110 = MUL_NUM %109, 4
+  %111 = NUM_TO_INT %110
+  CHECK_BUFFER_LEN %103, %111, 4i, bb_bytecode_2
+  %113 = MUL_NUM %105, 4
+  %114 = NUM_TO_INT %113
+  CHECK_BUFFER_LEN %102, %114, 4i, bb_bytecode_2
+  %116 = MUL_NUM %109, 4
+  %117 = NUM_TO_INT %116
+  CHECK_BUFFER_LEN %102, %117, 4i, bb_bytecode_2
+  %119 = BUFFER_READ_X2 %103, %107, %111, 151u
+  %120 = DUP_NUM_X2 0.5
+  %121 = MUL_NUM_X2 %119, %120
+  BUFFER_WRITE_X2 %102, %114, %117, %121, 152u
+  %123 = ADD_NUM %105, 2
+  STORE_DOUBLE R5, %123
+  %125 = ADD_NUM %123, 1
+  %126 = LOAD_DOUBLE R3
+  JUMP_CMP_NUM %125, %126, le, bb_13, bb_14
+bb_14:
+  %129 = LOAD_DOUBLE R3
+  JUMP_CMP_NUM R5, %129, le, bb_bytecode_2, bb_bytecode_3
+)");
+}
+
 TEST_SUITE_END();
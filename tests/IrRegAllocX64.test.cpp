@@ -55,4 +55,75 @@ TEST_CASE_FIXTURE(IrRegAllocX64Fixture, "RelocateFix")
 )");
 }
 
+TEST_CASE_FIXTURE(IrRegAllocX64Fixture, "WeightedSpillsReuseStackCopy")
+{
+    regs.weightedSpills = true;
+
+    IrInst irInst0{IrCmd::LOAD_DOUBLE};
+    irInst0.lastUse = 1;
+    function.instructions.push_back(irInst0);
+
+    function.instructions[0].regX64 = regs.takeReg(xmm0, 0);
+    regs.preserve(function.instructions[0]);
+    regs.restore(function.instructions[0], false);
+
+    // Value is still in the stack slot, so it doesn't have to be stored again
+    regs.preserve(function.instructions[0]);
+    regs.restore(function.instructions[0], false);
+
+    CHECK(function.instructions[0].regX64 == xmm0);
+    CHECK(regs.usedSpillSlots.any());
+
+    regs.freeLastUseReg(function.instructions[0], 1);
+
+    CHECK(regs.usedSpillSlots.none());
+
+    checkMatch(R"(
+ vmovsd      qword ptr [rsp+048h],xmm0
+ vmovsd      xmm0,xmmword ptr [rsp+048h]
+ vmovsd      xmm0,xmmword ptr [rsp+048h]
+)");
+}
+
+TEST_CASE_FIXTURE(IrRegAllocX64Fixture, "WeightedSpillsPreferCheaperSpill")
+{
+    regs.weightedSpills = true;
+    regs.usableXmmRegCount = 2;
+
+    IrInst irInst0{IrCmd::LOAD_DOUBLE};
+    irInst0.lastUse = 5;
+    function.instructions.push_back(irInst0);
+
+    IrInst irInst1{IrCmd::LOAD_DOUBLE};
+    irInst1.lastUse = 4;
+    function.instructions.push_back(irInst1);
+
+    IrInst irInst2{IrCmd::LOAD_DOUBLE};
+    irInst2.lastUse = 3;
+    function.instructions.push_back(irInst2);
+
+    function.instructions.push_back(IrInst{IrCmd::ADD_NUM, {IrOpKind::Inst, 2}, {IrOpKind::Inst, 2}});
+    function.instructions.push_back(IrInst{IrCmd::ADD_NUM, {IrOpKind::Inst, 1}, {IrOpKind::Inst, 1}});
+    function.instructions.push_back(IrInst{IrCmd::ADD_NUM, {IrOpKind::Inst, 0}, {IrOpKind::Inst, 0}});
+
+    function.instructions[0].regX64 = regs.takeReg(xmm0, 0);
+    function.instructions[1].regX64 = regs.takeReg(xmm1, 1);
+
+    regs.preserve(function.instructions[1]);
+    regs.restore(function.instructions[1], true);
+
+    // Second value is used earlier, but spilling it again only costs a reload
+    regs.currInstIdx = 2;
+    function.instructions[2].regX64 = regs.allocReg(SizeX64::xmmword, 2);
+
+    CHECK(function.instructions[2].regX64 == xmm1);
+    CHECK(function.instructions[1].spilled);
+    CHECK(!function.instructions[0].spilled);
+
+    checkMatch(R"(
+ vmovsd      qword ptr [rsp+048h],xmm1
+ vmovsd      xmm1,xmmword ptr [rsp+048h]
+)");
+}
+
 TEST_SUITE_END();
@@ -0,0 +1,182 @@
+-- This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+print('testing polymorphic inline caches')
+
+-- classes with different method and field layouts, so that a single call site sees a different slot for each class
+local function makeclass(name, ...)
+  local class = {}
+  class.__index = class
+
+  -- filler keys move the interesting keys into different node slots
+  for i, k in {...} do
+    class[k] = i
+  end
+
+  function class.new(v)
+    local self = setmetatable({}, class)
+    self.value = v
+    return self
+  end
+
+  function class:get()
+    return name .. self.value
+  end
+
+  class.kind = name
+
+  return class
+end
+
+local A = makeclass("a")
+local B = makeclass("b", "x")
+local C = makeclass("c", "x", "y", "z")
+local D = makeclass("d", "p", "q", "r", "s", "t", "u")
+local E = makeclass("e", "m", "n")
+
+local objects = { A.new(1), B.new(2), C.new(3), D.new(4), E.new(5) }
+
+local function callget(o) return o:get() end
+local function readkind(o) return o.kind end
+local function readvalue(o) return o.value end
+
+for iter = 1, 10 do
+  for i, o in objects do
+    assert(callget(o) == o.kind .. i)
+    assert(readkind(o) == string.sub(o:get(), 1, 1))
+    assert(readvalue(o) == i)
+  end
+end
+
+-- own fields shadow the class
+do
+  local o = A.new(10)
+  o.get = function() return "own" end
+  o.kind = "own"
+
+  for iter = 1, 3 do
+    assert(callget(objects[1]) == "a1")
+    assert(callget(o) == "own")
+    assert(readkind(o) == "own")
+  end
+
+  -- and stop shadowing once removed
+  o.get = nil
+  o.kind = nil
+  assert(callget(o) == "a10")
+  assert(readkind(o) == "a")
+end
+
+-- methods removed from or added to the class
+do
+  local get = B.get
+  B.get = nil
+  assert(not pcall(callget, objects[2]))
+  assert(callget(objects[3]) == "c3")
+
+  B.get = get
+  assert(callget(objects[2]) == "b2")
+
+  -- rehash moves every key of the class to a new slot
+  for i = 1, 100 do
+    C["filler" .. i] = i
+  end
+
+  assert(callget(objects[3]) == "c3")
+  assert(readkind(objects[3]) == "c")
+end
+
+-- __index changes
+do
+  local o = objects[4]
+  local mt = getmetatable(o)
+
+  mt.__index = E
+  assert(callget(o) == "e4")
+  assert(readkind(o) == "e")
+
+  mt.__index = function(t, k) return if k == "kind" then "fn" else function() return "fn" end end
+  assert(callget(o) == "fn")
+  assert(readkind(o) == "fn")
+
+  mt.__index = D
+  assert(callget(o) == "d4")
+  assert(readkind(o) == "d")
+
+  setmetatable(o, nil)
+  assert(readkind(o) == nil)
+  assert(not pcall(callget, o))
+
+  setmetatable(o, D)
+  assert(callget(o) == "d4")
+end
+
+-- __index chains are followed by the slow path
+do
+  local Base = { base = function() return "base" end }
+  Base.__index = Base
+  local Derived = setmetatable({}, Base)
+  Derived.__index = Derived
+
+  local function callbase(o) return o:base() end
+
+  local o = setmetatable({}, Derived)
+  for iter = 1, 3 do
+    assert(callbase(o) == "base")
+    assert(callbase(Derived) == "base")
+    assert(o.missing == nil)
+  end
+
+  setmetatable(Base, { __index = function(t, k) return if t == Base then k else nil end })
+  for iter = 1, 3 do
+    assert(o.missing == "missing")
+    assert(not pcall(function() return o:missing() end))
+  end
+end
+
+-- userdata and tables that share a metatable, where the table has the method itself
+do
+  local u = newproxy(true)
+  local mt = getmetatable(u)
+  mt.__index = { foo = function() return "class" end, a = 1, b = 2, c = 3, d = 4, e = 5, f = 6, g = 7 }
+
+  -- with enough filler keys, the method of some of the tables is away from its main position and the call site records it in the cache
+  local tables = {}
+  for i = 1, 32 do
+    local t = {}
+    for j = 1, i do
+      t["f" .. j] = j
+    end
+    t.foo = function() return "own" end
+    tables[i] = setmetatable(t, mt)
+  end
+
+  local function callfoo(o) return o:foo() end
+
+  for iter = 1, 10 do
+    for _, t in tables do
+      assert(callfoo(t) == "own")
+      assert(callfoo(u) == "class")
+    end
+  end
+end
+
+-- more classes than cache ways at one call site
+do
+  local classes = {}
+  for i = 1, 12 do
+    local keys = {}
+    for j = 1, i do
+      table.insert(keys, "k" .. j)
+    end
+    classes[i] = makeclass("n" .. i, table.unpack(keys))
+  end
+
+  for iter = 1, 5 do
+    for i, class in classes do
+      local o = class.new(i)
+      assert(callget(o) == "n" .. i .. i)
+      assert(readkind(o) == "n" .. i)
+    end
+  end
+end
+
+return 'OK'
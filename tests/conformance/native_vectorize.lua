@@ -0,0 +1,227 @@
+-- This file is part of the Luau programming language and is licensed under MIT License; see LICENSE.txt for details
+print("testing native code generation of vectorized buffer loops")
+
+local function scale(dst: buffer, src: buffer, k: number, n: number)
+  assert(is_native())
+  for i = 0, n - 1 do
+    buffer.writef64(dst, i * 8, buffer.readf64(src, i * 8) * k)
+  end
+end
+
+local function scalef32(dst: buffer, src: buffer, k: number, first: number, last: number)
+  for i = first, last do
+    buffer.writef32(dst, i * 4, buffer.readf32(src, i * 4) * k + 0.5)
+  end
+end
+
+local function clamp(b: buffer, n: number)
+  for i = 0, n - 1 do
+    local v = buffer.readf64(b, i * 8)
+    local lo = math.min(1, v)
+    local hi = math.max(-1, lo)
+    buffer.writef64(b, i * 8, hi)
+  end
+end
+
+local function magnitude(dst: buffer, src: buffer, n: number)
+  for i = 0, n - 1 do
+    local x = buffer.readf64(src, i * 16)
+    local y = buffer.readf64(src, i * 16 + 8)
+    buffer.writef64(dst, i * 8, math.sqrt(x * x + y * y) - math.abs(-x))
+  end
+end
+
+local function sum(b: buffer, n: number)
+  local s = 0
+  for i = 0, n - 1 do
+    s += buffer.readf64(b, i * 8)
+  end
+  return s
+end
+
+local function range(b: buffer, n: number)
+  local lo, hi = math.huge, -math.huge
+  for i = 0, n - 1 do
+    local v = buffer.readi32(b, i * 4)
+    lo = math.min(lo, v)
+    hi = math.max(hi, v)
+  end
+  return lo, hi
+end
+
+local function last(b: buffer, n: number)
+  local v, w = nil, 0
+  for i = 0, n - 1 do
+    v = buffer.readf32(b, i * 4) * 2
+    w = v + i
+  end
+  return v, w
+end
+
+local function index(b: buffer, first: number, last: number, step: number)
+  for i = first, last, step do
+    buffer.writef64(b, i * 8, i * 2)
+  end
+end
+
+local function shift(b: buffer, n: number)
+  for i = 0, n - 1 do
+    buffer.writei16(b, i * 2, buffer.readi16(b, i * 2 + 2) + 1)
+  end
+end
+
+local function smear(b: buffer, n: number)
+  for i = 0, n - 1 do
+    buffer.writeu8(b, i + 1, buffer.readu8(b, i) + 1)
+  end
+end
+
+local pcm = buffer.create(64)
+
+local function mix(dst: buffer, src: buffer, n: number)
+  for i = 0, n - 1 do
+    local a = buffer.readi16(pcm, i * 4)
+    local b = buffer.readi16(src, i * 4 + 2)
+    buffer.writei16(dst, i * 4, a + b - a * b / 32768)
+    buffer.writei16(dst, i * 4 + 2, b - a)
+  end
+end
+
+local function f64s(...)
+  local b = buffer.create(select("#", ...) * 8)
+  for i = 1, select("#", ...) do
+    buffer.writef64(b, (i - 1) * 8, (select(i, ...)))
+  end
+  return b
+end
+
+local function wrap16(v: number)
+  local b = buffer.create(2)
+  buffer.writei16(b, 0, v)
+  return buffer.readi16(b, 0)
+end
+
+local function check(b: buffer, ...)
+  for i = 1, select("#", ...) do
+    local expected = select(i, ...)
+    local actual = buffer.readf64(b, (i - 1) * 8)
+    assert(actual == expected or (actual ~= actual and expected ~= expected))
+  end
+end
+
+for _ = 1, 3 do
+  local src = f64s(1, 2, 3, 4, 5, 6, 7)
+  local dst = buffer.create(56)
+
+  scale(dst, src, 2, 7)
+  check(dst, 2, 4, 6, 8, 10, 12, 14)
+
+  scale(dst, src, 3, 6)
+  check(dst, 3, 6, 9, 12, 15, 18, 14)
+
+  scale(dst, src, 1, 1)
+  scale(dst, src, 1, 0)
+  check(dst, 1, 6, 9, 12, 15, 18, 14)
+
+  -- in-place update uses the same buffer for both accesses
+  scale(src, src, -1, 7)
+  check(src, -1, -2, -3, -4, -5, -6, -7)
+
+  -- out of bounds access is reported by the original loop after the elements in range are updated
+  assert(not pcall(scale, dst, src, 10, 8))
+  check(dst, -10, -20, -30, -40, -50, -60, -70)
+
+  assert(not pcall(scale, buffer.create(16), src, 10, 3))
+  assert(not pcall(scale, dst, "x", 10, 3))
+
+  local f32 = buffer.create(40)
+  for i = 0, 9 do buffer.writef32(f32, i * 4, i / 3) end
+
+  local out = buffer.create(40)
+  scalef32(out, f32, 3, 1, 8)
+  for i = 0, 9 do
+    local expected = if i >= 1 and i <= 8 then buffer.readf32(f32, i * 4) * 3 + 0.5 else 0
+    buffer.writef32(f32, 36, expected)
+    assert(buffer.readf32(out, i * 4) == buffer.readf32(f32, 36))
+  end
+
+  -- fractional start and limit are handled by the original loop
+  out = buffer.create(40)
+  scalef32(out, f32, 1, 0.5, 8)
+  assert(buffer.readf32(out, 0) == 0)
+  scalef32(out, f32, 1, 1, 2.5)
+
+  local c = f64s(-3, 0.5, 2, 0 / 0, -0.25, 1, -1)
+  clamp(c, 7)
+  check(c, -1, 0.5, 1, 1, -0.25, 1, -1)
+
+  local points = f64s(3, 4, -6, 8, 5, 12, 0, 0, -1, 0)
+  local lengths = buffer.create(40)
+  magnitude(lengths, points, 5)
+  check(lengths, 2, 4, 8, 0, 0)
+
+  assert(sum(f64s(0.1, 0.2, 0.3, 0.4, 0.5), 5) == 0.1 + 0.2 + 0.3 + 0.4 + 0.5)
+  assert(sum(f64s(1e100, 1, -1e100, 1), 4) == 1)
+  assert(sum(f64s(), 0) == 0)
+
+  local ints = buffer.create(28)
+  for i, v in {5, -2, 7, 0, 9, -8, 3} do buffer.writei32(ints, (i - 1) * 4, v) end
+  local lo, hi = range(ints, 7)
+  assert(lo == -8 and hi == 9)
+  lo, hi = range(ints, 6)
+  assert(lo == -8 and hi == 9)
+  lo, hi = range(ints, 1)
+  assert(lo == 5 and hi == 5)
+
+  local v, w = last(f32, 10)
+  assert(v == buffer.readf32(f32, 36) * 2 and w == v + 9)
+  v, w = last(f32, 9)
+  assert(v == buffer.readf32(f32, 32) * 2 and w == v + 8)
+  v, w = last(f32, 0)
+  assert(v == nil and w == 0)
+
+  local seq = buffer.create(80)
+  index(seq, 0, 9, 1)
+  check(seq, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18)
+  index(seq, 1, 9, 2)
+  check(seq, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18)
+  index(seq, 0, 9, 3)
+  check(seq, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18)
+
+  -- each iteration reads the element written by the next one
+  local s = buffer.create(12)
+  for i = 0, 5 do buffer.writei16(s, i * 2, i * 10) end
+  shift(s, 5)
+  for i = 0, 5 do assert(buffer.readi16(s, i * 2) == (if i < 5 then i * 10 + 11 else 50)) end
+
+  -- each iteration reads the element written by the previous one
+  local u = buffer.create(8)
+  smear(u, 7)
+  for i = 0, 7 do assert(buffer.readu8(u, i) == i) end
+
+  for i = 0, 15 do
+    buffer.writei16(pcm, i * 4, i * 1000 - 8000)
+    buffer.writei16(pcm, i * 4 + 2, 16000 - i * 1500)
+  end
+
+  local m = buffer.create(64)
+  mix(m, pcm, 16)
+  for i = 0, 15 do
+    local a, b = i * 1000 - 8000, 16000 - i * 1500
+    assert(buffer.readi16(m, i * 4) == wrap16(a + b - a * b / 32768))
+    assert(buffer.readi16(m, i * 4 + 2) == b - a)
+  end
+
+  -- destination might be the same buffer as one of the sources
+  local p = buffer.create(64)
+  buffer.copy(p, 0, pcm)
+  mix(pcm, pcm, 16)
+  for i = 0, 15 do
+    local a, b = buffer.readi16(p, i * 4), buffer.readi16(p, i * 4 + 2)
+    assert(buffer.readi16(pcm, i * 4) == buffer.readi16(m, i * 4))
+    assert(buffer.readi16(pcm, i * 4 + 2) == wrap16(b - a))
+  end
+  buffer.copy(pcm, 0, p)
+end
+
+return('OK')
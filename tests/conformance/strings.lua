@@ -261,6 +261,27 @@ assert(os.setlocale() == 'C')
 assert(os.setlocale(nil, "numeric") == 'C')
 ]]--
 
+-- string interning stays consistent while the string table is resized incrementally
+do
+  local t = {}
+  for i = 1, 100000 do
+    t["key" .. i] = i
+    -- look up keys created before and during the resize, which can still be in the old bucket array
+    local j = (i * 7919) % 100000 + 1
+    if j <= i then assert(t["key" .. j] == j) end
+  end
+  for i = 1, 100000, 7 do assert(t["key" .. i] == i) end
+
+  -- shrink the table while strings are being created and freed
+  t = nil
+  for k = 1, 3 do
+    collectgarbage("collect")
+    local u = {}
+    for i = 1, 1000 do u["key" .. i] = i end
+    for i = 1, 1000 do assert(u[string.format("key%d", i)] == i) end
+  end
+end
+
 return('OK')
 
 